@@ -0,0 +1,184 @@
+/******************************************************************************
+ * aleatorio.hpp
+ * Descripción:
+ *  - Generación paralela y reproducible de A y B con Philox4x32-10
+ *    (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", 2011):
+ *      (1) Generador basado en contador: el valor del índice i es
+ *          philox(contador = i, clave = semilla), sin estado compartido.
+ *      (2) Cada hilo calcula los índices que le tocan en cualquier orden,
+ *          así que A y B son idénticos bit a bit con 1 o con 128 hilos.
+ *  - De las 4 palabras de 32 bits por índice: la 0 va a A, la 1 a B y las
+ *    2 y 3 son reservas para el rechazo del mapeo a [1, rango] (rango = 1000,
+ *    o 63 para int8; ver tipos.hpp). Los valores son enteros también para
+ *    float/double, así que la suma es exacta en todos los tipos.
+ *  - Con la misma --semilla dos ejecuciones generan los mismos arreglos.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+#include <array>
+#include <cstdint>
+#include <cstring>      // memcpy
+#include <random>       // random_device (semilla por defecto)
+
+#include "tipos.hpp"    // rangoInicial
+#include "traza.hpp"    // SUMA_TRAZA_TRAMO
+
+// ===============================
+// Philox4x32-10
+// ===============================
+inline std::array<std::uint32_t, 4> philox4x32(std::uint64_t contador, std::uint64_t semilla) {
+    constexpr std::uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+    constexpr std::uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+
+    std::uint32_t c0 = static_cast<std::uint32_t>(contador);
+    std::uint32_t c1 = static_cast<std::uint32_t>(contador >> 32);
+    std::uint32_t c2 = 0, c3 = 0;
+    std::uint32_t k0 = static_cast<std::uint32_t>(semilla);
+    std::uint32_t k1 = static_cast<std::uint32_t>(semilla >> 32);
+
+    for (int ronda = 0; ronda < 10; ronda++) {
+        std::uint64_t p0 = static_cast<std::uint64_t>(M0) * c0;
+        std::uint64_t p1 = static_cast<std::uint64_t>(M1) * c2;
+        std::uint32_t n0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        std::uint32_t n1 = static_cast<std::uint32_t>(p1);
+        std::uint32_t n2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        std::uint32_t n3 = static_cast<std::uint32_t>(p0);
+        c0 = n0; c1 = n1; c2 = n2; c3 = n3;
+        k0 += W0;
+        k1 += W1;
+    }
+    return {c0, c1, c2, c3};
+}
+
+// ===============================
+// Mapeo sin sesgo de una palabra de 32 bits a [1, rango] (Lemire).
+// Devuelve false si la palabra cae en la zona de rechazo.
+// ===============================
+inline bool enRango(std::uint32_t x, std::uint32_t rango, int &valor) {
+    std::uint64_t m = static_cast<std::uint64_t>(x) * rango;
+    std::uint32_t bajo = static_cast<std::uint32_t>(m);
+    if (bajo < rango) {
+        const std::uint32_t umbral = (0u - rango) % rango;
+        if (bajo < umbral) return false;
+    }
+    valor = 1 + static_cast<int>(m >> 32);
+    return true;
+}
+
+// Valores de A[i] y B[i] en [1, rangoInicial<T>()] para la semilla dada
+template <typename T>
+void valoresEn(long long i, std::uint64_t semilla, T &a, T &b) {
+    constexpr std::uint32_t RANGO = rangoInicial<T>();
+    std::array<std::uint32_t, 4> w = philox4x32(static_cast<std::uint64_t>(i), semilla);
+    // Rechazo (probabilidad < 2^-22): se usa la palabra de reserva.
+    // Si también se rechaza, se acepta el sesgo despreciable de la reserva.
+    int va, vb;
+    if (!enRango(w[0], RANGO, va)) {
+        va = 1 + static_cast<int>((static_cast<std::uint64_t>(w[2]) * RANGO) >> 32);
+    }
+    if (!enRango(w[1], RANGO, vb)) {
+        vb = 1 + static_cast<int>((static_cast<std::uint64_t>(w[3]) * RANGO) >> 32);
+    }
+    a = static_cast<T>(va);
+    b = static_cast<T>(vb);
+}
+
+// Semilla no determinista para cuando el usuario no fija --semilla
+inline std::uint64_t semillaAleatoria() {
+    std::random_device rd;
+    return (static_cast<std::uint64_t>(rd()) << 32) | rd();
+}
+
+// ===============================
+// Inicialización en serie (un hilo): todas las páginas en el nodo del
+// hilo que llama. Mismo resultado que la versión paralela.
+// ===============================
+template <typename T>
+void inicializaArreglos(T *A, T *B, long long n, std::uint64_t semilla) {
+    for (long long i = 0; i < n; i++) {
+        valoresEn(i, semilla, A[i], B[i]);
+    }
+}
+
+// ===============================
+// Inicialización paralela con schedule(static, chunk): además de repartir
+// el costo del generador, cada página la toca primero el hilo que la usará
+// en la suma (primer toque NUMA).
+// ===============================
+template <typename T>
+void inicializaArreglosParalelo(T *A, T *B, long long n, long long chunk, std::uint64_t semilla) {
+#pragma omp parallel
+    {
+        SUMA_TRAZA_TRAMO("inicializacion", -1);
+#ifdef SUMA_TRAZA
+        // Por bloques para el tramo de cada uno (ver traza.hpp)
+        const long long bloques = (n + chunk - 1) / chunk;
+#pragma omp for schedule(static, 1) nowait
+        for (long long b = 0; b < bloques; b++) {
+            SUMA_TRAZA_TRAMO("inicializacion", b);
+            const long long fin = std::min(n, (b + 1) * chunk);
+            for (long long i = b * chunk; i < fin; i++) {
+                valoresEn(i, semilla, A[i], B[i]);
+            }
+        }
+#else
+#pragma omp for schedule(static, chunk) nowait
+        for (long long i = 0; i < n; i++) {
+            valoresEn(i, semilla, A[i], B[i]);
+        }
+#endif
+    }
+}
+
+// ===============================
+// Tramo [base, base + n) de los arreglos globales en A[0..n), B[0..n):
+// cada proceso MPI genera solo su parte y obtiene los mismos valores que
+// una ejecución en un solo proceso (el contador de Philox es el índice).
+// ===============================
+template <typename T>
+void inicializaTramoParalelo(T *A, T *B, long long base, long long n, long long chunk,
+                             std::uint64_t semilla) {
+#pragma omp parallel for schedule(static, chunk)
+    for (long long i = 0; i < n; i++) {
+        valoresEn(base + i, semilla, A[i], B[i]);
+    }
+}
+
+// ===============================
+// Un solo arreglo adicional (p. ej. un tercer operando), con su propia
+// corriente: la clave se deriva de la semilla para no repetir A ni B.
+// ===============================
+template <typename T>
+void inicializaArregloParalelo(T *X, long long n, long long chunk, std::uint64_t semilla) {
+    const std::uint64_t clave = semilla ^ 0xA0761D6478BD642Full;
+#pragma omp parallel for schedule(static, chunk)
+    for (long long i = 0; i < n; i++) {
+        T descartado;
+        valoresEn(i, clave, X[i], descartado);
+    }
+}
+
+// ===============================
+// Huella de A y B independiente del orden de suma (y por tanto del número
+// de hilos): sirve para comprobar que dos ejecuciones generaron lo mismo.
+// ===============================
+template <typename T>
+std::uint64_t huellaArreglos(const T *A, const T *B, long long n) {
+    std::uint64_t h = 0;
+#pragma omp parallel for reduction(+ : h) schedule(static)
+    for (long long i = 0; i < n; i++) {
+        // Bits crudos de A[i] y B[i] (sirve igual para enteros y flotantes)
+        std::uint64_t a = 0, b = 0;
+        std::memcpy(&a, &A[i], sizeof(T));
+        std::memcpy(&b, &B[i], sizeof(T));
+        std::uint64_t x = a * 0xD6E8FEB86659FD93ull + b;
+        // Mezcla splitmix64 de (i, A[i], B[i]) para que la posición cuente
+        x ^= static_cast<std::uint64_t>(i) * 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        h += x ^ (x >> 31);
+    }
+    return h;
+}
@@ -0,0 +1,150 @@
+/******************************************************************************
+ * archivos.hpp
+ * Descripción:
+ *  - Arreglos respaldados por archivos binarios con mmap, sin copias:
+ *      (1) Entrada (A, B): PROT_READ + MAP_SHARED; opcionalmente
+ *          madvise(MADV_SEQUENTIAL) (lectura anticipada agresiva y descarte
+ *          de páginas ya leídas) y MAP_POPULATE (prefalla todo al mapear).
+ *      (2) Salida (C): el archivo se crea o trunca a n * sizeof(T) y se
+ *          mapea PROT_WRITE + MAP_SHARED; msync al final lo lleva al disco.
+ *  - El formato es crudo: n valores de tipo T en el orden de bytes del host
+ *    (little-endian en x86-64/AArch64), sin cabecera.
+ *  - El sistema pagina los arreglos desde y hacia el archivo, así que N
+ *    puede superar la RAM.
+ *  - Contadores de fallos de página (menores y mayores) con getrusage.
+ *  - Los errores de E/S lanzan std::runtime_error con la ruta y errno.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <cerrno>
+#include <cstddef>      // size_t
+#include <cstring>      // strerror
+#include <stdexcept>    // runtime_error
+#include <string>
+#include <utility>      // swap
+
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, madvise, msync
+#include <sys/resource.h>  // getrusage
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close, ftruncate
+
+inline std::runtime_error errorArchivo(const std::string &que, const std::string &ruta) {
+    return std::runtime_error(que + " '" + ruta + "': " + std::strerror(errno));
+}
+
+// Fallos de página acumulados del proceso
+struct FallosPagina {
+    long menores = 0;   // Resueltos sin E/S (página en caché o nueva)
+    long mayores = 0;   // Requirieron leer del disco
+};
+
+inline FallosPagina fallosPagina() {
+    rusage uso{};
+    getrusage(RUSAGE_SELF, &uso);
+    return {uso.ru_minflt, uso.ru_majflt};
+}
+
+inline FallosPagina operator-(const FallosPagina &a, const FallosPagina &b) {
+    return {a.menores - b.menores, a.mayores - b.mayores};
+}
+
+inline bool existeArchivo(const std::string &ruta) {
+    struct stat st {};
+    return stat(ruta.c_str(), &st) == 0;
+}
+
+// ===============================
+// Archivo mapeado en memoria como arreglo de T (RAII, solo se mueve)
+// ===============================
+template <typename T>
+class ArchivoMapeado {
+public:
+    ArchivoMapeado() = default;
+
+    // Entrada de solo lectura; n = tamaño del archivo / sizeof(T)
+    static ArchivoMapeado abreLectura(const std::string &ruta, bool secuencial, bool poblar) {
+        ArchivoMapeado m;
+        m.fd_ = open(ruta.c_str(), O_RDONLY);
+        if (m.fd_ < 0) throw errorArchivo("no se pudo abrir", ruta);
+        struct stat st {};
+        if (fstat(m.fd_, &st) != 0) throw errorArchivo("no se pudo leer el tamano de", ruta);
+        m.n_ = static_cast<std::size_t>(st.st_size) / sizeof(T);
+        m.mapea(ruta, PROT_READ, poblar);
+        if (secuencial && m.datos_) madvise(m.datos_, m.bytes(), MADV_SEQUENTIAL);
+        return m;
+    }
+
+    // Salida de n elementos: crea o trunca el archivo
+    static ArchivoMapeado abreEscritura(const std::string &ruta, std::size_t n, bool secuencial,
+                                        bool poblar) {
+        ArchivoMapeado m;
+        m.fd_ = open(ruta.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (m.fd_ < 0) throw errorArchivo("no se pudo crear", ruta);
+        m.n_ = n;
+        if (ftruncate(m.fd_, static_cast<off_t>(m.bytes())) != 0) {
+            throw errorArchivo("no se pudo dimensionar", ruta);
+        }
+        m.mapea(ruta, PROT_READ | PROT_WRITE, poblar);
+        if (secuencial && m.datos_) madvise(m.datos_, m.bytes(), MADV_SEQUENTIAL);
+        return m;
+    }
+
+    ~ArchivoMapeado() { libera(); }
+
+    ArchivoMapeado(ArchivoMapeado &&otro) noexcept { intercambia(otro); }
+    ArchivoMapeado &operator=(ArchivoMapeado &&otro) noexcept {
+        if (this != &otro) {
+            libera();
+            intercambia(otro);
+        }
+        return *this;
+    }
+    ArchivoMapeado(const ArchivoMapeado &) = delete;
+    ArchivoMapeado &operator=(const ArchivoMapeado &) = delete;
+
+    T *data() { return static_cast<T *>(datos_); }
+    const T *data() const { return static_cast<const T *>(datos_); }
+    std::size_t size() const { return n_; }
+    std::size_t bytes() const { return n_ * sizeof(T); }
+
+    // Escribe las páginas sucias al archivo y espera (MS_SYNC)
+    void sincroniza() {
+        if (datos_ && msync(datos_, bytes(), MS_SYNC) != 0) {
+            throw std::runtime_error(std::string("msync fallo: ") + std::strerror(errno));
+        }
+    }
+
+private:
+    void mapea(const std::string &ruta, int proteccion, bool poblar) {
+        if (n_ == 0) return;   // mmap de 0 bytes no está permitido
+        int banderas = MAP_SHARED;
+#ifdef MAP_POPULATE
+        if (poblar) banderas |= MAP_POPULATE;
+#else
+        (void)poblar;
+#endif
+        void *p = mmap(nullptr, bytes(), proteccion, banderas, fd_, 0);
+        if (p == MAP_FAILED) throw errorArchivo("no se pudo mapear", ruta);
+        datos_ = p;
+    }
+
+    void libera() {
+        if (datos_) munmap(datos_, bytes());
+        if (fd_ >= 0) close(fd_);
+        datos_ = nullptr;
+        fd_ = -1;
+        n_ = 0;
+    }
+
+    void intercambia(ArchivoMapeado &otro) noexcept {
+        std::swap(datos_, otro.datos_);
+        std::swap(fd_, otro.fd_);
+        std::swap(n_, otro.n_);
+    }
+
+    void *datos_ = nullptr;
+    int fd_ = -1;
+    std::size_t n_ = 0;
+};
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * arena.hpp
+ * Descripción:
+ *  - Arena de memoria para ensayos repetidos y trabajos por lotes: reserva
+ *    una vez una región grande (BufferAlineado, con huge pages opcionales)
+ *    y entrega de ella, con un puntero que avanza, los arreglos A, B, C_seq
+ *    y C_par de cada trabajo. reinicia() devuelve todo de una vez; el
+ *    siguiente trabajo vuelve a recibir las mismas páginas.
+ *  - Si un trabajo pide más de lo que queda se agrega otra región (una
+ *    asignación del SO, que se cuenta) y se conserva para los siguientes:
+ *    tras el primer trabajo más grande no hay más asignaciones.
+ *  - Opcional:
+ *      prefalla(): escribe un byte por página en paralelo con
+ *        schedule(static) para que las páginas existan (y queden en el nodo
+ *        NUMA de quien las toca) antes del primer trabajo
+ *      bloquea(): mlock(2) de las regiones, para que no se paginen; puede
+ *        fallar por RLIMIT_MEMLOCK (ulimit -l) y entonces solo se reporta
+ *  - No es segura entre hilos: la usa el hilo que arma cada trabajo.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // max
+#include <cerrno>
+#include <cstddef>      // byte, size_t
+#include <cstring>      // strerror
+#include <stdexcept>    // runtime_error
+#include <string>
+#include <vector>
+
+#include <sys/mman.h>   // mlock, munlock
+#include <unistd.h>     // sysconf
+
+#include "memoria.hpp"  // BufferAlineado, ALINEACION, redondeaArriba
+
+class Arena {
+public:
+    explicit Arena(std::size_t bytes, bool paginas_grandes = false)
+        : paginas_grandes_(paginas_grandes) {
+        agregaRegion(bytes);
+    }
+
+    ~Arena() {
+        if (bloqueada_) {
+            for (Region &r : regiones_) munlock(r.memoria.data(), r.memoria.bytes());
+        }
+    }
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // Arreglo de n elementos T alineado a 64 bytes, válido hasta reinicia()
+    template <typename T>
+    T *reserva(std::size_t n) {
+        const std::size_t bytes = redondeaArriba(n * sizeof(T) > 0 ? n * sizeof(T) : 1, ALINEACION);
+        while (actual_ < regiones_.size()) {
+            Region &r = regiones_[actual_];
+            if (r.usados + bytes <= r.memoria.bytes()) return entrega<T>(r, bytes);
+            actual_++;
+        }
+        // No cabe en ninguna: región nueva, del doble de la mayor o lo pedido
+        agregaRegion(std::max(bytes, 2 * regiones_.back().memoria.bytes()));
+        return entrega<T>(regiones_.back(), bytes);
+    }
+
+    // Todo lo entregado vuelve a estar libre; las regiones se conservan
+    void reinicia() {
+        for (Region &r : regiones_) r.usados = 0;
+        actual_ = 0;
+        enUso_ = 0;
+    }
+
+    // Toca cada página de todas las regiones (ver la descripción)
+    void prefalla() {
+        const long long pagina = sysconf(_SC_PAGESIZE) > 0 ? sysconf(_SC_PAGESIZE) : 4096;
+        for (Region &r : regiones_) {
+            volatile unsigned char *p = reinterpret_cast<unsigned char *>(r.memoria.data());
+            const long long paginas = static_cast<long long>(r.memoria.bytes()) / pagina;
+#pragma omp parallel for schedule(static)
+            for (long long k = 0; k < paginas; k++) {
+                p[k * pagina] = 0;
+            }
+        }
+    }
+
+    // mlock de todas las regiones; devuelve el error si no se pudo
+    std::string bloquea() {
+        for (Region &r : regiones_) {
+            if (mlock(r.memoria.data(), r.memoria.bytes()) != 0) {
+                const std::string error = std::strerror(errno);
+                for (Region &b : regiones_) {
+                    if (&b == &r) break;
+                    munlock(b.memoria.data(), b.memoria.bytes());
+                }
+                return error;
+            }
+        }
+        bloqueada_ = true;
+        return "";
+    }
+
+    std::size_t capacidad() const {
+        std::size_t total = 0;
+        for (const Region &r : regiones_) total += r.memoria.bytes();
+        return total;
+    }
+    std::size_t enUso() const { return enUso_; }
+    std::size_t maximoEnUso() const { return maximo_; }
+    long asignacionesSistema() const { return static_cast<long>(regiones_.size()); }
+    bool bloqueada() const { return bloqueada_; }
+    TipoMemoria tipo() const { return regiones_.front().memoria.tipo(); }
+
+private:
+    struct Region {
+        BufferAlineado<std::byte> memoria;
+        std::size_t usados = 0;
+    };
+
+    void agregaRegion(std::size_t bytes) {
+        regiones_.push_back({BufferAlineado<std::byte>(bytes, paginas_grandes_), 0});
+        if (bloqueada_) {
+            Region &r = regiones_.back();
+            if (mlock(r.memoria.data(), r.memoria.bytes()) != 0) {
+                throw std::runtime_error(std::string("mlock de la region nueva: ") + std::strerror(errno));
+            }
+        }
+        actual_ = regiones_.size() - 1;
+    }
+
+    template <typename T>
+    T *entrega(Region &r, std::size_t bytes) {
+        T *p = reinterpret_cast<T *>(r.memoria.data() + r.usados);
+        r.usados += bytes;
+        enUso_ += bytes;
+        maximo_ = std::max(maximo_, enUso_);
+        return p;
+    }
+
+    bool paginas_grandes_ = false;
+    bool bloqueada_ = false;
+    std::vector<Region> regiones_;
+    std::size_t actual_ = 0;
+    std::size_t enUso_ = 0;
+    std::size_t maximo_ = 0;
+};
@@ -0,0 +1,252 @@
+/******************************************************************************
+ * asincrono.hpp
+ * Descripción:
+ *  - Interfaz asíncrona para usar la suma desde un servicio: envía una suma
+ *    (o una verificación) y sigue con otra cosa; el envío devuelve un
+ *    std::future y opcionalmente registra un aviso (callback) que corre al
+ *    completar, en el hilo que terminó el último bloque.
+ *  - Debajo está el equipo persistente de equipo.hpp. Un hilo conductor
+ *    (el id 0 del equipo) espera envíos y lanza sobre el equipo una tarea
+ *    que vacía la cola: cada hilo toma bloques del trabajo más antiguo que
+ *    tenga bloques sin tomar y, al acabarse, pasa al siguiente sin esperar
+ *    a los demás. No hay barrera entre trabajos: mientras los últimos
+ *    bloques de una suma terminan, los demás hilos ya avanzan en la
+ *    siguiente o en una verificación.
+ *  - La huella de verificacion.hpp es una suma por posición: cada bloque
+ *    suma su parte con un fetch_add y el total no depende del orden.
+ *      suma:        C = A + B y la huella de C en la misma pasada
+ *      verifica:    huella de C contra la de referencia desde A y B
+ *      sumaYVerifica: la verificación se encola sola cuando termina su
+ *                   suma (continuación), sin bloquear al que envió
+ *  - Los arreglos deben seguir vivos hasta que el future esté listo.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>   // function
+#include <future>       // future, promise
+#include <memory>       // shared_ptr
+#include <mutex>
+#include <thread>
+#include <utility>      // pair
+
+#include <omp.h>        // omp_get_wtime
+
+#include "equipo.hpp"        // EquipoPersistente
+#include "verificacion.hpp"  // mezclaElemento
+
+// Resultado de un envío
+struct ResultadoAsincrono {
+    std::uint64_t huella = 0;       // Huella de C
+    std::uint64_t referencia = 0;   // Huella esperada (solo verificación)
+    bool correcto = true;           // Solo verificación: huella == referencia
+    double ms = 0.0;                // Desde el envío hasta completar
+};
+
+using AvisoAsincrono = std::function<void(const ResultadoAsincrono &)>;
+
+template <typename T>
+class ServicioSuma {
+public:
+    // "hilos" del equipo (contando al conductor); bloques de "bloque" elementos
+    ServicioSuma(int hilos, long long bloque)
+        : bloque_(bloque > 0 ? bloque : 1), equipo_(hilos),
+          conductor_([this] { bucleConductor(); }) {}
+
+    // Termina los trabajos pendientes antes de destruir el equipo
+    ~ServicioSuma() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            fin_ = true;
+        }
+        cv_.notify_all();
+        conductor_.join();
+    }
+
+    ServicioSuma(const ServicioSuma &) = delete;
+    ServicioSuma &operator=(const ServicioSuma &) = delete;
+
+    std::future<ResultadoAsincrono> suma(const T *A, const T *B, T *C, long long n,
+                                         AvisoAsincrono aviso = {}) {
+        std::shared_ptr<Trabajo> t = nuevo(Tipo::Suma, A, B, C, n, std::move(aviso));
+        std::future<ResultadoAsincrono> f = t->promesa.get_future();
+        encola(t);
+        return f;
+    }
+
+    std::future<ResultadoAsincrono> verifica(const T *A, const T *B, const T *C, long long n,
+                                             AvisoAsincrono aviso = {}) {
+        std::shared_ptr<Trabajo> t = nuevo(Tipo::Verificacion, A, B, const_cast<T *>(C), n, std::move(aviso));
+        std::future<ResultadoAsincrono> f = t->promesa.get_future();
+        encola(t);
+        return f;
+    }
+
+    // La verificación entra a la cola cuando termina la suma
+    std::pair<std::future<ResultadoAsincrono>, std::future<ResultadoAsincrono>>
+    sumaYVerifica(const T *A, const T *B, T *C, long long n, AvisoAsincrono aviso_suma = {},
+                  AvisoAsincrono aviso_verificacion = {}) {
+        std::shared_ptr<Trabajo> s = nuevo(Tipo::Suma, A, B, C, n, std::move(aviso_suma));
+        std::shared_ptr<Trabajo> v = nuevo(Tipo::Verificacion, A, B, C, n, std::move(aviso_verificacion));
+        s->continuacion = v;
+        v->envio = s->envio;   // La latencia de la verificación cuenta desde este envío
+        auto futuros = std::make_pair(s->promesa.get_future(), v->promesa.get_future());
+        encola(s);
+        return futuros;
+    }
+
+    // Espera a que se completen todos los envíos hechos hasta ahora
+    void espera() {
+        std::unique_lock<std::mutex> lk(m_);
+        cv_fin_.wait(lk, [&] { return activos_ == 0; });
+    }
+
+    int hilos() const { return equipo_.hilos(); }
+
+private:
+    enum class Tipo { Suma, Verificacion };
+
+    struct Trabajo {
+        Tipo tipo;
+        const T *A;
+        const T *B;
+        T *C;
+        long long n;
+        long long bloques;
+        std::atomic<long long> siguiente{0};   // Próximo bloque sin tomar
+        std::atomic<long long> restantes{0};   // Bloques sin terminar
+        std::atomic<std::uint64_t> huella{0};
+        std::atomic<std::uint64_t> referencia{0};
+        double envio = 0.0;                    // Envío del que llama (la continuación hereda el de su suma)
+        std::promise<ResultadoAsincrono> promesa;
+        AvisoAsincrono aviso;
+        std::shared_ptr<Trabajo> continuacion;
+    };
+
+    std::shared_ptr<Trabajo> nuevo(Tipo tipo, const T *A, const T *B, T *C, long long n,
+                                   AvisoAsincrono aviso) {
+        auto t = std::make_shared<Trabajo>();
+        t->tipo = tipo;
+        t->A = A;
+        t->B = B;
+        t->C = C;
+        t->n = n;
+        t->bloques = (n + bloque_ - 1) / bloque_;
+        t->restantes.store(t->bloques, std::memory_order_relaxed);
+        t->aviso = std::move(aviso);
+        t->envio = omp_get_wtime();
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            activos_++;
+        }
+        return t;
+    }
+
+    void encola(const std::shared_ptr<Trabajo> &t) {
+        if (t->bloques == 0) {
+            completa(*t);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            cola_.push_back(t);
+        }
+        cv_.notify_all();
+    }
+
+    // ===============================
+    // Conductor: cada vez que hay trabajos los vacía con todo el equipo
+    // ===============================
+    void bucleConductor() {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lk(m_);
+                cv_.wait(lk, [&] { return fin_ || !cola_.empty(); });
+                if (cola_.empty()) return;   // fin_ y nada pendiente
+            }
+            equipo_.ejecuta([this](int, int) { vaciaCola(); });
+        }
+    }
+
+    // Toma bloques hasta que no quede ninguno sin tomar en la cola
+    void vaciaCola() {
+        std::shared_ptr<Trabajo> t;
+        for (;;) {
+            long long b = t ? t->siguiente.fetch_add(1, std::memory_order_relaxed) : -1;
+            if (!t || b >= t->bloques) {
+                // El trabajo actual se agotó: el más antiguo con bloques libres
+                std::lock_guard<std::mutex> lk(m_);
+                t.reset();
+                while (!cola_.empty()) {
+                    b = cola_.front()->siguiente.fetch_add(1, std::memory_order_relaxed);
+                    if (b < cola_.front()->bloques) {
+                        t = cola_.front();
+                        break;
+                    }
+                    cola_.pop_front();
+                }
+                if (!t) return;
+            }
+            procesaBloque(*t, b);
+        }
+    }
+
+    void procesaBloque(Trabajo &t, long long b) {
+        const long long inicio = b * bloque_;
+        const long long fin = std::min(t.n, inicio + bloque_);
+        const T *A = t.A;
+        const T *B = t.B;
+        T *C = t.C;
+        std::uint64_t h = 0;
+        if (t.tipo == Tipo::Suma) {
+#pragma omp simd reduction(+ : h)
+            for (long long i = inicio; i < fin; i++) {
+                const T c = static_cast<T>(A[i] + B[i]);
+                C[i] = c;
+                h += mezclaElemento(i, c);
+            }
+        } else {
+            std::uint64_t r = 0;
+#pragma omp simd reduction(+ : h, r)
+            for (long long i = inicio; i < fin; i++) {
+                h += mezclaElemento(i, C[i]);
+                r += mezclaElemento(i, static_cast<T>(A[i] + B[i]));
+            }
+            t.referencia.fetch_add(r, std::memory_order_relaxed);
+        }
+        t.huella.fetch_add(h, std::memory_order_relaxed);
+        // acq_rel: el que termina el último bloque ve todas las escrituras de C
+        if (t.restantes.fetch_sub(1, std::memory_order_acq_rel) == 1) completa(t);
+    }
+
+    void completa(Trabajo &t) {
+        ResultadoAsincrono r;
+        r.huella = t.huella.load(std::memory_order_relaxed);
+        r.referencia = t.referencia.load(std::memory_order_relaxed);
+        r.correcto = t.tipo == Tipo::Suma || r.huella == r.referencia;
+        r.ms = (omp_get_wtime() - t.envio) * 1e3;
+        if (t.continuacion) encola(t.continuacion);
+        if (t.aviso) t.aviso(r);
+        t.promesa.set_value(r);
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            activos_--;
+        }
+        cv_fin_.notify_all();
+    }
+
+    const long long bloque_;
+    EquipoPersistente equipo_;
+    std::mutex m_;
+    std::condition_variable cv_;       // Hay trabajos o hay que terminar
+    std::condition_variable cv_fin_;   // Se completó algún trabajo
+    std::deque<std::shared_ptr<Trabajo>> cola_;
+    long activos_ = 0;                 // Enviados y no completados
+    bool fin_ = false;
+    std::thread conductor_;            // Último: arranca con todo lo demás listo
+};
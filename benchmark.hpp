@@ -0,0 +1,134 @@
+/******************************************************************************
+ * benchmark.hpp
+ * Descripción:
+ *  - Arnés de medición para los núcleos de suma:
+ *      (1) "calentamiento" ejecuciones descartadas (páginas, cachés, hilos)
+ *      (2) "repeticiones" ejecuciones medidas con steady_clock
+ *  - Estadísticas por muestra: mínimo, mediana, p95, p99 y media (ms).
+ *  - Métricas derivadas a partir de la mediana:
+ *      GB/s = bytes movidos / tiempo, elementos/s = N / tiempo.
+ *    Para C = A + B se cuentan 3 accesos por elemento (2 lecturas, 1 escritura),
+ *    igual que STREAM; no incluye el read-for-ownership de C.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // sort
+#include <chrono>       // steady_clock
+#include <cmath>        // ceil
+#include <cstddef>      // size_t
+#include <iomanip>      // setw, setprecision
+#include <iostream>
+#include <vector>
+
+// ===============================
+// Resumen estadístico de una serie de tiempos (ms)
+// ===============================
+struct Estadisticas {
+    double minimo = 0.0;
+    double mediana = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double media = 0.0;
+    int muestras = 0;
+};
+
+// Percentil por el método del rango más cercano sobre muestras ordenadas
+inline double percentil(const std::vector<double> &ordenadas, double p) {
+    if (ordenadas.empty()) return 0.0;
+    std::size_t rango = static_cast<std::size_t>(std::ceil(p / 100.0 * ordenadas.size()));
+    if (rango < 1) rango = 1;
+    return ordenadas[rango - 1];
+}
+
+inline Estadisticas calculaEstadisticas(std::vector<double> muestras) {
+    Estadisticas e;
+    if (muestras.empty()) return e;
+    std::sort(muestras.begin(), muestras.end());
+    double suma = 0.0;
+    for (double m : muestras) suma += m;
+    std::size_t n = muestras.size();
+    e.minimo = muestras.front();
+    e.mediana = (n % 2) ? muestras[n / 2] : 0.5 * (muestras[n / 2 - 1] + muestras[n / 2]);
+    e.p95 = percentil(muestras, 95.0);
+    e.p99 = percentil(muestras, 99.0);
+    e.media = suma / n;
+    e.muestras = static_cast<int>(n);
+    return e;
+}
+
+// ===============================
+// Ejecuta "kernel" con calentamiento y devuelve los tiempos medidos (ms)
+// ===============================
+template <typename Kernel>
+std::vector<double> mideKernel(Kernel &&kernel, int calentamiento, int repeticiones) {
+    for (int r = 0; r < calentamiento; r++) {
+        kernel();
+    }
+    std::vector<double> tiempos;
+    tiempos.reserve(repeticiones);
+    for (int r = 0; r < repeticiones; r++) {
+        auto inicio = std::chrono::steady_clock::now();
+        kernel();
+        auto fin = std::chrono::steady_clock::now();
+        tiempos.push_back(std::chrono::duration<double, std::milli>(fin - inicio).count());
+    }
+    return tiempos;
+}
+
+template <typename Kernel>
+Estadisticas mide(Kernel &&kernel, int calentamiento, int repeticiones) {
+    return calculaEstadisticas(mideKernel(kernel, calentamiento, repeticiones));
+}
+
+// Como mide, pero antes de cada ejecución corre "prepara" fuera del tiempo
+// medido (p. ej. poner C a cero para que la verificación no vea la anterior)
+template <typename Prepara, typename Kernel>
+Estadisticas mideConPreparacion(Prepara &&prepara, Kernel &&kernel, int calentamiento, int repeticiones) {
+    for (int r = 0; r < calentamiento; r++) {
+        prepara();
+        kernel();
+    }
+    std::vector<double> tiempos;
+    tiempos.reserve(repeticiones);
+    for (int r = 0; r < repeticiones; r++) {
+        prepara();
+        auto inicio = std::chrono::steady_clock::now();
+        kernel();
+        auto fin = std::chrono::steady_clock::now();
+        tiempos.push_back(std::chrono::duration<double, std::milli>(fin - inicio).count());
+    }
+    return calculaEstadisticas(tiempos);
+}
+
+// Ancho de banda efectivo (GB/s, 1 GB = 1e9 bytes) para "bytes" movidos en "ms"
+inline double gbPorSegundo(double bytes, double ms) {
+    return ms > 0.0 ? bytes / (ms * 1.0e6) : 0.0;
+}
+
+// Elementos procesados por segundo
+inline double elementosPorSegundo(double n, double ms) {
+    return ms > 0.0 ? n / (ms * 1.0e-3) : 0.0;
+}
+
+// ===============================
+// Reporte de una línea con las estadísticas de un núcleo
+// ===============================
+inline void imprimeEncabezadoEstadisticas() {
+    std::cout << std::left << std::setw(22) << "Kernel" << std::right
+              << std::setw(11) << "min(ms)" << std::setw(11) << "mediana"
+              << std::setw(11) << "p95" << std::setw(11) << "p99"
+              << std::setw(10) << "GB/s" << std::setw(12) << "Gelem/s" << "\n";
+}
+
+inline void imprimeEstadisticas(const char *nombre, const Estadisticas &e,
+                                double bytes, double n) {
+    std::cout << std::left << std::setw(22) << nombre << std::right
+              << std::fixed << std::setprecision(4)
+              << std::setw(11) << e.minimo << std::setw(11) << e.mediana
+              << std::setw(11) << e.p95 << std::setw(11) << e.p99
+              << std::setprecision(2)
+              << std::setw(10) << gbPorSegundo(bytes, e.mediana)
+              << std::setprecision(3)
+              << std::setw(12) << elementosPorSegundo(n, e.mediana) * 1.0e-9 << "\n";
+}
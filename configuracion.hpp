@@ -0,0 +1,479 @@
+/******************************************************************************
+ * configuracion.hpp
+ * Descripción:
+ *  - Parámetros del programa que antes eran constantes (#define N, chunk, ...).
+ *  - Se leen primero de variables de entorno (SUMA_N, SUMA_CHUNK, ...) y
+ *    después de la línea de comandos (--n=..., --chunk=..., ...), de modo que
+ *    la línea de comandos tiene prioridad.
+ *  - Los valores numéricos aceptan notación científica (p. ej. --n=1e8).
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <cstdlib>      // getenv, strtod, strtoull
+#include <cctype>       // toupper
+#include <cerrno>       // errno, ERANGE
+#include <climits>      // INT_MAX
+#include <cmath>        // floor
+#include <iostream>     // Mensaje de ayuda
+#include <stdexcept>    // invalid_argument
+#include <string>
+#include <vector>
+
+#include "tipos.hpp"    // TIPOS
+
+// ===============================
+// Parámetros configurables en tiempo de ejecución
+// ===============================
+struct Configuracion {
+    long long n = 1000;           // Tamaño de los arreglos
+    long long chunk = 100;        // Tamaño del bloque (chunk) para schedule
+    int hilos = 0;                // Hilos de OpenMP (0 = valor por defecto del runtime)
+    int mostrar = 10;             // Cuántos elementos imprimir para verificación
+    bool paginas_grandes = false; // Respaldar los arreglos con huge pages
+    int calentamiento = 2;        // Ejecuciones descartadas antes de medir
+    int repeticiones = 10;        // Ejecuciones medidas por núcleo
+    std::string modo = "basico";  // Ver MODOS
+    std::vector<long long> barrido_n = {1000, 10000, 100000, 1000000, 10000000};
+    bool barrido_n_dado = false;  // ¿Se dio --barrido-n? (persistente usa otro defecto)
+    std::vector<long long> barrido_hilos;  // Vacío = 1, 2, 4, ... hasta el máximo
+    std::string stream = "auto";  // Streaming stores para C: auto | si | no
+    long long umbral_stream = 0;  // Bytes de A+B+C para activar streaming (0 = 2 x LLC)
+    bool primer_toque = false;    // Inicializar en paralelo con schedule(static, chunk)
+    std::string afinidad;         // OMP_PROC_BIND (vacío = no tocar)
+    std::string lugares;          // OMP_PLACES (vacío = no tocar)
+    bool semilla_fija = false;    // ¿Se dio --semilla?
+    unsigned long long semilla = 0; // Semilla de Philox para A y B
+    std::string tipo = "int32";   // Tipo de elemento (ver tipos.hpp)
+    std::string verificacion = "paralela";  // serie | paralela | checksum
+    std::string schedule = "static";  // static | dynamic | guided | auto | runtime
+    std::vector<long long> barrido_chunk;  // Chunks del modo planificacion (vacío = chunk)
+    std::string cache_umbrales;   // Archivo de umbrales del despachador (vacío = ~/.cache)
+    bool recalibrar = false;      // Ignorar el caché de umbrales y volver a medir
+    long long grano = 0;          // Tamaño mínimo de tarea con robo de trabajo (0 = automático)
+    int antagonistas = 1;         // Hilos que compiten por CPU en el modo robo
+    long long bloque_dispositivo = 1 << 20;  // Elementos por bloque del pipeline al dispositivo
+    std::string entrada_a = "A.bin";  // Archivos del modo archivo (crudos, sin cabecera)
+    std::string entrada_b = "B.bin";
+    std::string salida = "C.bin";
+    bool mmap_secuencial = true;  // madvise(MADV_SEQUENTIAL) sobre los mapeos
+    bool mmap_poblar = false;     // MAP_POPULATE: prefallar al mapear
+    long long chunks_bloque = 16384;  // Chunks por bloque de la tubería del modo flujo
+    int ranuras = 3;              // Bloques en vuelo en la tubería (lector/cómputo/escritor)
+    std::string resultado;        // Archivo binario donde guardar C (vacío = no guardar)
+    std::string compresion = "ninguna";  // ninguna | lz4 | zstd
+    bool contadores = false;      // Contadores perf_event por núcleo e hilo (modo básico)
+    long long n_sonda = 0;        // Elementos por arreglo de la sonda STREAM (0 = 4 x LLC)
+    std::string alinear = "no";   // Límites de bloque de C_par: no | linea | pagina
+    long long tesela = 0;         // Elementos por tesela del modo teselas (0 = mitad de la L2)
+    bool arena_prefallar = true;  // Tocar las páginas de la arena antes del primer trabajo
+    bool arena_mlock = false;     // mlock de la arena
+    long long lote = 10000;       // Vectores por lote del modo lotes (longitudes n/2 .. 3n/2)
+    int envios = 16;              // Sumas independientes enviadas en el modo asincrono
+    int umbral_sucio = 75;        // % de chunks sucios a partir del cual se recalcula todo C
+    std::string traza;            // JSON de Chrome con la línea de tiempo por hilo (vacío = no)
+    long long traza_eventos = 65536;  // Tramos por hilo del anillo de la traza
+    std::string informe;          // Resultados en JSON (o CSV si termina en .csv); vacío = no
+    std::string base;             // Informe de referencia del modo comparar
+    std::string actual;           // Informe a comparar contra la base
+    double alfa = 0.01;           // Significancia de la prueba U del modo comparar
+    int tolerancia = 5;           // % de empeoramiento de la mediana tolerado
+    bool ayuda = false;           // Solo imprimir la ayuda
+};
+
+// ===============================
+// Claves reconocidas (--clave en argv, SUMA_CLAVE en el entorno).
+// Las banderas pueden aparecer sin valor (--hugepages equivale a --hugepages=1).
+// ===============================
+struct ClaveOpcion {
+    const char *nombre;
+    bool bandera;
+};
+
+inline constexpr ClaveOpcion CLAVES_CONOCIDAS[] = {
+    {"n", false},
+    {"chunk", false},
+    {"hilos", false},
+    {"mostrar", false},
+    {"hugepages", true},
+    {"calentamiento", false},
+    {"repeticiones", false},
+    {"modo", false},
+    {"barrido-n", false},
+    {"barrido-hilos", false},
+    {"stream", false},
+    {"umbral-stream", false},
+    {"primer-toque", true},
+    {"afinidad", false},
+    {"lugares", false},
+    {"semilla", false},
+    {"tipo", false},
+    {"verificacion", false},
+    {"schedule", false},
+    {"barrido-chunk", false},
+    {"cache-umbrales", false},
+    {"recalibrar", true},
+    {"grano", false},
+    {"antagonistas", false},
+    {"bloque-dispositivo", false},
+    {"entrada-a", false},
+    {"entrada-b", false},
+    {"salida", false},
+    {"mmap-secuencial", true},
+    {"mmap-populate", true},
+    {"chunks-bloque", false},
+    {"ranuras", false},
+    {"resultado", false},
+    {"compresion", false},
+    {"contadores", true},
+    {"n-sonda", false},
+    {"alinear", false},
+    {"tesela", false},
+    {"arena-prefallar", true},
+    {"arena-mlock", true},
+    {"lote", false},
+    {"envios", false},
+    {"umbral-sucio", false},
+    {"traza", false},
+    {"traza-eventos", false},
+    {"informe", false},
+    {"base", false},
+    {"actual", false},
+    {"alfa", false},
+    {"tolerancia", false},
+};
+
+// Políticas aceptadas por --schedule
+inline constexpr const char *PLANIFICACIONES[] = {"static", "dynamic", "guided", "auto", "runtime"};
+
+// Modos de ejecución aceptados por --modo
+inline constexpr const char *MODOS[] = {"basico", "barrido", "simd", "numa",
+                                            "operaciones", "planificacion", "persistente",
+                                            "adaptativo", "robo", "dispositivo",
+                                            "distribuido", "archivo", "flujo", "roofline",
+                                            "comparticion", "teselas", "arena", "lotes",
+                                            "asincrono", "incremental", "desborde",
+                                            "comparar", "fijo"};
+
+inline const ClaveOpcion *buscaClave(const std::string &clave) {
+    for (const ClaveOpcion &c : CLAVES_CONOCIDAS) {
+        if (clave == c.nombre) return &c;
+    }
+    return nullptr;
+}
+
+// ===============================
+// Convierte un texto a entero aceptando notación científica ("1e6"); los
+// campos int pasan maximo = INT_MAX para no envolver al convertir
+// ===============================
+inline long long parseaEntero(const std::string &texto, const std::string &nombre,
+                              long long minimo, long long maximo = 9000000000000000000LL) {
+    const char *inicio = texto.c_str();
+    char *fin = nullptr;
+    double valor = std::strtod(inicio, &fin);
+    if (fin == inicio || *fin != '\0' || valor != std::floor(valor) ||
+        valor < static_cast<double>(minimo) || valor > static_cast<double>(maximo)) {
+        throw std::invalid_argument("valor invalido para " + nombre + ": '" + texto + "'");
+    }
+    return static_cast<long long>(valor);
+}
+
+// Real en [minimo, maximo], p. ej. un nivel de significancia
+inline double parseaReal(const std::string &texto, const std::string &nombre, double minimo,
+                         double maximo) {
+    const char *inicio = texto.c_str();
+    char *fin = nullptr;
+    double valor = std::strtod(inicio, &fin);
+    if (fin == inicio || *fin != '\0' || !(valor >= minimo && valor <= maximo)) {
+        throw std::invalid_argument("valor invalido para " + nombre + ": '" + texto + "'");
+    }
+    return valor;
+}
+
+inline bool parseaBooleano(const std::string &texto, const std::string &nombre) {
+    if (texto == "1" || texto == "si" || texto == "true" || texto == "on") return true;
+    if (texto == "0" || texto == "no" || texto == "false" || texto == "off") return false;
+    throw std::invalid_argument("valor invalido para " + nombre + ": '" + texto + "'");
+}
+
+// Entero sin signo de 64 bits (decimal o 0x hexadecimal), p. ej. una semilla
+inline unsigned long long parseaSemilla(const std::string &texto, const std::string &nombre) {
+    const char *inicio = texto.c_str();
+    char *fin = nullptr;
+    errno = 0;
+    unsigned long long valor = std::strtoull(inicio, &fin, 0);
+    if (fin == inicio || *fin != '\0' || errno == ERANGE || texto[0] == '-') {
+        throw std::invalid_argument("valor invalido para " + nombre + ": '" + texto + "'");
+    }
+    return valor;
+}
+
+// Lista separada por comas: "1e3,1e6,1e8"
+inline std::vector<long long> parseaLista(const std::string &texto, const std::string &nombre,
+                                          long long minimo) {
+    std::vector<long long> lista;
+    std::size_t inicio = 0;
+    while (inicio <= texto.size()) {
+        std::size_t coma = texto.find(',', inicio);
+        if (coma == std::string::npos) coma = texto.size();
+        lista.push_back(parseaEntero(texto.substr(inicio, coma - inicio), nombre, minimo));
+        inicio = coma + 1;
+    }
+    return lista;
+}
+
+// ===============================
+// Aplica una opción "clave=valor" ya validada por buscaClave
+// ===============================
+inline void aplicaOpcion(Configuracion &cfg, const std::string &clave, const std::string &valor) {
+    if (clave == "n") {
+        cfg.n = parseaEntero(valor, clave, 1);
+    } else if (clave == "chunk") {
+        cfg.chunk = parseaEntero(valor, clave, 1);
+    } else if (clave == "hilos") {
+        cfg.hilos = static_cast<int>(parseaEntero(valor, clave, 0, INT_MAX));
+    } else if (clave == "mostrar") {
+        cfg.mostrar = static_cast<int>(parseaEntero(valor, clave, 0, INT_MAX));
+    } else if (clave == "hugepages") {
+        cfg.paginas_grandes = parseaBooleano(valor, clave);
+    } else if (clave == "calentamiento") {
+        cfg.calentamiento = static_cast<int>(parseaEntero(valor, clave, 0, INT_MAX));
+    } else if (clave == "repeticiones") {
+        cfg.repeticiones = static_cast<int>(parseaEntero(valor, clave, 1, INT_MAX));
+    } else if (clave == "modo") {
+        bool conocido = false;
+        for (const char *m : MODOS) conocido = conocido || valor == m;
+        if (!conocido) {
+            throw std::invalid_argument("modo desconocido: '" + valor + "'");
+        }
+        cfg.modo = valor;
+    } else if (clave == "barrido-n") {
+        cfg.barrido_n = parseaLista(valor, clave, 1);
+        cfg.barrido_n_dado = true;
+    } else if (clave == "barrido-hilos") {
+        cfg.barrido_hilos = parseaLista(valor, clave, 1);
+    } else if (clave == "stream") {
+        if (valor != "auto" && valor != "si" && valor != "no") {
+            throw std::invalid_argument("valor invalido para stream: '" + valor + "'");
+        }
+        cfg.stream = valor;
+    } else if (clave == "umbral-stream") {
+        cfg.umbral_stream = parseaEntero(valor, clave, 0);
+    } else if (clave == "primer-toque") {
+        cfg.primer_toque = parseaBooleano(valor, clave);
+    } else if (clave == "afinidad") {
+        cfg.afinidad = valor;
+    } else if (clave == "lugares") {
+        cfg.lugares = valor;
+    } else if (clave == "semilla") {
+        cfg.semilla = parseaSemilla(valor, clave);
+        cfg.semilla_fija = true;
+    } else if (clave == "tipo") {
+        bool conocido = false;
+        for (const char *t : TIPOS) conocido = conocido || valor == t;
+        if (!conocido) {
+            throw std::invalid_argument("tipo desconocido: '" + valor + "'");
+        }
+        cfg.tipo = valor;
+    } else if (clave == "verificacion") {
+        if (valor != "serie" && valor != "paralela" && valor != "checksum") {
+            throw std::invalid_argument("valor invalido para verificacion: '" + valor + "'");
+        }
+        cfg.verificacion = valor;
+    } else if (clave == "schedule") {
+        bool conocida = false;
+        for (const char *p : PLANIFICACIONES) conocida = conocida || valor == p;
+        if (!conocida) {
+            throw std::invalid_argument("valor invalido para schedule: '" + valor + "'");
+        }
+        cfg.schedule = valor;
+    } else if (clave == "barrido-chunk") {
+        cfg.barrido_chunk = parseaLista(valor, clave, 1);
+    } else if (clave == "cache-umbrales") {
+        cfg.cache_umbrales = valor;
+    } else if (clave == "recalibrar") {
+        cfg.recalibrar = parseaBooleano(valor, clave);
+    } else if (clave == "grano") {
+        cfg.grano = parseaEntero(valor, clave, 0);
+    } else if (clave == "antagonistas") {
+        cfg.antagonistas = static_cast<int>(parseaEntero(valor, clave, 0, INT_MAX));
+    } else if (clave == "bloque-dispositivo") {
+        cfg.bloque_dispositivo = parseaEntero(valor, clave, 1);
+    } else if (clave == "entrada-a") {
+        cfg.entrada_a = valor;
+    } else if (clave == "entrada-b") {
+        cfg.entrada_b = valor;
+    } else if (clave == "salida") {
+        cfg.salida = valor;
+    } else if (clave == "mmap-secuencial") {
+        cfg.mmap_secuencial = parseaBooleano(valor, clave);
+    } else if (clave == "mmap-populate") {
+        cfg.mmap_poblar = parseaBooleano(valor, clave);
+    } else if (clave == "chunks-bloque") {
+        cfg.chunks_bloque = parseaEntero(valor, clave, 1);
+    } else if (clave == "ranuras") {
+        cfg.ranuras = static_cast<int>(parseaEntero(valor, clave, 2, INT_MAX));
+    } else if (clave == "resultado") {
+        cfg.resultado = valor;
+    } else if (clave == "compresion") {
+        if (valor != "ninguna" && valor != "lz4" && valor != "zstd") {
+            throw std::invalid_argument("valor invalido para compresion: '" + valor + "'");
+        }
+        cfg.compresion = valor;
+    } else if (clave == "contadores") {
+        cfg.contadores = parseaBooleano(valor, clave);
+    } else if (clave == "n-sonda") {
+        cfg.n_sonda = parseaEntero(valor, clave, 0);
+    } else if (clave == "alinear") {
+        if (valor != "no" && valor != "linea" && valor != "pagina") {
+            throw std::invalid_argument("valor invalido para alinear: '" + valor + "'");
+        }
+        cfg.alinear = valor;
+    } else if (clave == "tesela") {
+        cfg.tesela = parseaEntero(valor, clave, 0);
+    } else if (clave == "arena-prefallar") {
+        cfg.arena_prefallar = parseaBooleano(valor, clave);
+    } else if (clave == "arena-mlock") {
+        cfg.arena_mlock = parseaBooleano(valor, clave);
+    } else if (clave == "lote") {
+        cfg.lote = parseaEntero(valor, clave, 1);
+    } else if (clave == "envios") {
+        cfg.envios = static_cast<int>(parseaEntero(valor, clave, 1, INT_MAX));
+    } else if (clave == "umbral-sucio") {
+        const long long pct = parseaEntero(valor, clave, 0);
+        if (pct > 100) throw std::invalid_argument("valor invalido para " + clave + ": '" + valor + "'");
+        cfg.umbral_sucio = static_cast<int>(pct);
+    } else if (clave == "traza") {
+        cfg.traza = valor;
+    } else if (clave == "traza-eventos") {
+        cfg.traza_eventos = parseaEntero(valor, clave, 1);
+    } else if (clave == "informe") {
+        cfg.informe = valor;
+    } else if (clave == "base") {
+        cfg.base = valor;
+    } else if (clave == "actual") {
+        cfg.actual = valor;
+    } else if (clave == "alfa") {
+        cfg.alfa = parseaReal(valor, clave, 0.0, 1.0);
+    } else if (clave == "tolerancia") {
+        cfg.tolerancia = static_cast<int>(parseaEntero(valor, clave, 0, INT_MAX));
+    }
+}
+
+inline void imprimeAyuda(const char *programa) {
+    std::cout
+        << "Uso: " << programa << " [opciones]\n"
+        << "  --n=<entero>        Tamano de los arreglos (SUMA_N, defecto 1000)\n"
+        << "  --chunk=<entero>    Chunk de schedule(static, chunk) (SUMA_CHUNK, defecto 100)\n"
+        << "  --hilos=<entero>    Hilos de OpenMP, 0 = defecto (SUMA_HILOS / OMP_NUM_THREADS)\n"
+        << "  --mostrar=<entero>  Elementos a imprimir (SUMA_MOSTRAR, defecto 10)\n"
+        << "  --hugepages[=0|1]   Respaldar arreglos con huge pages (SUMA_HUGEPAGES)\n"
+        << "  --calentamiento=<k> Ejecuciones descartadas por kernel (defecto 2)\n"
+        << "  --repeticiones=<k>  Ejecuciones medidas por kernel (defecto 10)\n"
+        << "  --modo=<m>          basico | barrido | simd | numa | operaciones |\n"
+        << "                      planificacion | persistente | adaptativo | robo |\n"
+        << "                      dispositivo | distribuido | archivo | flujo |\n"
+        << "                      roofline | comparticion | teselas | arena | lotes |\n"
+        << "                      asincrono | incremental | desborde | comparar |\n"
+        << "                      fijo\n"
+        << "  --barrido-n=<lista> Valores de N para el barrido, p. ej. 1e3,1e6,1e8\n"
+        << "  --barrido-hilos=<l> Hilos para el barrido (defecto 1,2,4,... max)\n"
+        << "  --stream=<m>        Streaming stores en C: auto | si | no (defecto auto)\n"
+        << "  --umbral-stream=<b> Bytes de A+B+C para activar streaming (0 = 2 x LLC)\n"
+        << "  --primer-toque      Inicializa en paralelo (colocacion NUMA por primer toque)\n"
+        << "  --afinidad=<p>      OMP_PROC_BIND: close | spread | master | true | false\n"
+        << "  --lugares=<l>       OMP_PLACES: cores | threads | sockets | lista explicita\n"
+        << "  --semilla=<u64>     Semilla fija para A y B (defecto: aleatoria, se reporta)\n"
+        << "  --tipo=<t>          int8 | int16 | int32 | int64 | float | double (defecto int32)\n"
+        << "  --verificacion=<v>  serie | paralela | checksum (defecto paralela)\n"
+        << "  --schedule=<p>      static | dynamic | guided | auto | runtime (OMP_SCHEDULE)\n"
+        << "  --barrido-chunk=<l> Chunks a comparar en el modo planificacion\n"
+        << "  --cache-umbrales=<r> Archivo de umbrales del despachador (defecto ~/.cache)\n"
+        << "  --recalibrar        Vuelve a medir los umbrales aunque esten en cache\n"
+        << "  --grano=<entero>    Tarea minima con robo de trabajo (0 = automatico)\n"
+        << "  --antagonistas=<k>  Hilos que compiten por CPU en el modo robo (defecto 1)\n"
+        << "  --bloque-dispositivo=<k> Elementos por bloque del pipeline al acelerador\n"
+        << "  --entrada-a=<ruta>  Archivo binario de A del modo archivo (defecto A.bin)\n"
+        << "  --entrada-b=<ruta>  Archivo binario de B (defecto B.bin)\n"
+        << "  --salida=<ruta>     Archivo donde se escribe C (defecto C.bin)\n"
+        << "  --mmap-secuencial[=0|1] madvise(MADV_SEQUENTIAL) sobre los mapeos (defecto 1)\n"
+        << "  --mmap-populate[=0|1]   MAP_POPULATE: prefallar las paginas al mapear\n"
+        << "  --chunks-bloque=<k> Chunks por bloque de la tuberia del modo flujo (16384)\n"
+        << "  --ranuras=<k>       Bloques en vuelo en la tuberia (defecto 3, minimo 2)\n"
+        << "  --resultado=<ruta>  Guarda C en formato binario (cabecera + datos LE)\n"
+        << "  --compresion=<c>    ninguna | lz4 | zstd para --resultado (defecto ninguna)\n"
+        << "  --contadores        Contadores de hardware (perf_event) por nucleo e hilo\n"
+        << "  --n-sonda=<entero>  Elementos por arreglo de la sonda STREAM (0 = 4 x LLC)\n"
+        << "  --alinear=<a>       Limites de bloque de C_par: no | linea | pagina\n"
+        << "  --tesela=<entero>   Elementos por tesela del modo teselas (0 = mitad de L2)\n"
+        << "  --arena-prefallar[=0|1] Prefallar la arena del modo arena (defecto 1)\n"
+        << "  --arena-mlock[=0|1] mlock de la arena del modo arena\n"
+        << "  --lote=<entero>     Vectores por lote del modo lotes (defecto 10000)\n"
+        << "  --envios=<entero>   Sumas independientes del modo asincrono (defecto 16)\n"
+        << "  --umbral-sucio=<%>  % de chunks sucios para recalculo completo (defecto 75)\n"
+        << "  --traza=<ruta>      Linea de tiempo por hilo en JSON de Chrome (modo basico,\n"
+        << "                      -DSUMA_TRAZA)\n"
+        << "  --traza-eventos=<k> Tramos por hilo en el anillo de la traza (defecto 65536)\n"
+        << "  --informe=<ruta>    Resultados en JSON (o CSV si es .csv) de los modos basico,\n"
+        << "                      barrido, simd, adaptativo y fijo\n"
+        << "  --base=<ruta>       Informe de referencia del modo comparar\n"
+        << "  --actual=<ruta>     Informe a comparar contra la base\n"
+        << "  --alfa=<real>       Significancia de la prueba U (defecto 0.01)\n"
+        << "  --tolerancia=<%>    Empeoramiento de la mediana tolerado (defecto 5)\n"
+        << "  --ayuda             Muestra esta ayuda\n";
+}
+
+// ===============================
+// Lee la configuración: entorno primero, luego argv.
+// Lanza invalid_argument ante opciones desconocidas o valores inválidos.
+// ===============================
+inline Configuracion leeConfiguracion(int argc, char **argv) {
+    Configuracion cfg;
+
+    // 1) Variables de entorno SUMA_<CLAVE>
+    for (const ClaveOpcion &c : CLAVES_CONOCIDAS) {
+        std::string var = "SUMA_" + std::string(c.nombre);
+        for (char &ch : var) {
+            ch = (ch == '-') ? '_' : static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+        }
+        if (const char *valor = std::getenv(var.c_str())) {
+            aplicaOpcion(cfg, c.nombre, valor);
+        }
+    }
+
+    // 2) Línea de comandos: --clave=valor, --clave valor, o --bandera
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help" || arg == "--ayuda") {
+            cfg.ayuda = true;
+            continue;
+        }
+        if (arg.rfind("--", 0) != 0) {
+            throw std::invalid_argument("argumento no reconocido: '" + arg + "'");
+        }
+        std::string clave = arg.substr(2);
+        std::string valor;
+        std::size_t igual = clave.find('=');
+        if (igual != std::string::npos) {
+            valor = clave.substr(igual + 1);
+            clave = clave.substr(0, igual);
+        }
+        const ClaveOpcion *info = buscaClave(clave);
+        if (!info) {
+            throw std::invalid_argument("opcion desconocida: --" + clave);
+        }
+        if (igual == std::string::npos) {
+            if (info->bandera) {
+                valor = "1";   // Bandera sin valor
+            } else if (i + 1 < argc) {
+                valor = argv[++i];
+            } else {
+                throw std::invalid_argument("falta el valor de --" + clave);
+            }
+        }
+        aplicaOpcion(cfg, clave, valor);
+    }
+
+    if (cfg.mostrar > cfg.n) cfg.mostrar = static_cast<int>(cfg.n);
+    return cfg;
+}
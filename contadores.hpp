@@ -0,0 +1,268 @@
+/******************************************************************************
+ * contadores.hpp
+ * Descripción:
+ *  - Contadores de hardware y del sistema por hilo con perf_event_open(2):
+ *      hardware: ciclos, instrucciones, ciclos de referencia, fallos de LLC
+ *                (lecturas) y fallos de DTLB (lecturas)
+ *      software: tiempo en CPU (task-clock), cambios de contexto, migraciones
+ *  - Cada hilo de OpenMP abre sus propios descriptores (pid = 0 desde dentro
+ *    de una región parallel); el hilo maestro los habilita y deshabilita
+ *    alrededor del núcleo. libgomp reutiliza los mismos hilos entre regiones
+ *    con el mismo tamaño de equipo.
+ *  - Si el kernel multiplexa, el valor se escala por enabled / running.
+ *  - En VMs sin PMU virtual los eventos de hardware no abren (ENOENT); se
+ *    reportan como "n/d" y quedan los de software.
+ *  - Métricas derivadas: IPC, GHz efectivos (ciclos / task-clock), ciclos /
+ *    ciclos de referencia (< 1 indica frecuencia reducida), bytes útiles por
+ *    ciclo y GB/s de DRAM estimados como 64 B por fallo de LLC.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // max
+#include <cstdint>
+#include <cstring>      // memset
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <omp.h>
+
+enum EventoContador {
+    CICLOS,
+    INSTRUCCIONES,
+    CICLOS_REF,
+    FALLOS_LLC,
+    FALLOS_DTLB,
+    RELOJ_TAREA,        // ns en CPU
+    CAMBIOS_CONTEXTO,
+    MIGRACIONES,
+    NUM_EVENTOS
+};
+
+inline const char *nombreEvento(int e) {
+    static const char *nombres[NUM_EVENTOS] = {"ciclos", "instrucciones", "ciclos-ref", "fallos-llc",
+                                               "fallos-dtlb", "task-clock", "cambios-ctx", "migraciones"};
+    return nombres[e];
+}
+
+inline perf_event_attr atributoEvento(int e) {
+    perf_event_attr a;
+    std::memset(&a, 0, sizeof(a));
+    a.size = sizeof(a);
+    a.disabled = 1;
+    a.exclude_kernel = 1;
+    a.exclude_hv = 1;
+    a.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    auto cache = [](std::uint64_t c) {
+        return c | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    };
+    switch (e) {
+        case CICLOS: a.type = PERF_TYPE_HARDWARE; a.config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case INSTRUCCIONES: a.type = PERF_TYPE_HARDWARE; a.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case CICLOS_REF: a.type = PERF_TYPE_HARDWARE; a.config = PERF_COUNT_HW_REF_CPU_CYCLES; break;
+        case FALLOS_LLC: a.type = PERF_TYPE_HW_CACHE; a.config = cache(PERF_COUNT_HW_CACHE_LL); break;
+        case FALLOS_DTLB: a.type = PERF_TYPE_HW_CACHE; a.config = cache(PERF_COUNT_HW_CACHE_DTLB); break;
+        case RELOJ_TAREA: a.type = PERF_TYPE_SOFTWARE; a.config = PERF_COUNT_SW_TASK_CLOCK; break;
+        case CAMBIOS_CONTEXTO: a.type = PERF_TYPE_SOFTWARE; a.config = PERF_COUNT_SW_CONTEXT_SWITCHES; break;
+        default: a.type = PERF_TYPE_SOFTWARE; a.config = PERF_COUNT_SW_CPU_MIGRATIONS; break;
+    }
+    // Los eventos de software ocurren en el kernel: excluirlo los dejaría en 0
+    if (a.type == PERF_TYPE_SOFTWARE) a.exclude_kernel = 0;
+    return a;
+}
+
+// Valores de un hilo (o la suma de varios); -1 = evento no disponible
+struct LecturaContadores {
+    double v[NUM_EVENTOS];
+    LecturaContadores() {
+        for (double &x : v) x = -1.0;
+    }
+    bool hay(int e) const { return v[e] >= 0.0; }
+    double ipc() const { return hay(CICLOS) && hay(INSTRUCCIONES) && v[CICLOS] > 0 ? v[INSTRUCCIONES] / v[CICLOS] : -1.0; }
+    double ghz() const { return hay(CICLOS) && hay(RELOJ_TAREA) && v[RELOJ_TAREA] > 0 ? v[CICLOS] / v[RELOJ_TAREA] : -1.0; }
+    double frecuenciaRelativa() const {
+        return hay(CICLOS) && hay(CICLOS_REF) && v[CICLOS_REF] > 0 ? v[CICLOS] / v[CICLOS_REF] : -1.0;
+    }
+};
+
+// ===============================
+// Descriptores de un hilo
+// ===============================
+class ContadoresHilo {
+public:
+    ContadoresHilo() {
+        for (int &f : fd_) f = -1;
+    }
+    ~ContadoresHilo() { cierra(); }
+    ContadoresHilo(const ContadoresHilo &) = delete;
+    ContadoresHilo &operator=(const ContadoresHilo &) = delete;
+
+    // Debe llamarse desde el hilo a medir
+    void abre() {
+        for (int e = 0; e < NUM_EVENTOS; e++) {
+            perf_event_attr a = atributoEvento(e);
+            fd_[e] = static_cast<int>(syscall(SYS_perf_event_open, &a, 0, -1, -1, 0));
+        }
+    }
+
+    void cierra() {
+        for (int &f : fd_) {
+            if (f >= 0) close(f);
+            f = -1;
+        }
+    }
+
+    void habilita() {
+        for (int f : fd_) {
+            if (f < 0) continue;
+            ioctl(f, PERF_EVENT_IOC_RESET, 0);
+            ioctl(f, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    void deshabilita() {
+        for (int f : fd_) {
+            if (f >= 0) ioctl(f, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    LecturaContadores lee() const {
+        LecturaContadores l;
+        for (int e = 0; e < NUM_EVENTOS; e++) {
+            std::uint64_t datos[3] = {0, 0, 0};   // valor, enabled, running
+            if (fd_[e] < 0 || read(fd_[e], datos, sizeof(datos)) != sizeof(datos)) continue;
+            const double escala = datos[2] > 0 ? static_cast<double>(datos[1]) / datos[2] : 1.0;
+            l.v[e] = static_cast<double>(datos[0]) * escala;
+        }
+        return l;
+    }
+
+    bool algunoAbierto() const {
+        for (int f : fd_) {
+            if (f >= 0) return true;
+        }
+        return false;
+    }
+
+private:
+    int fd_[NUM_EVENTOS];
+};
+
+// ===============================
+// Lectura de una medición: por hilo de OpenMP y total
+// ===============================
+struct MedicionContadores {
+    std::vector<LecturaContadores> por_hilo;
+    LecturaContadores total;   // Suma de los hilos
+    double segundos = 0.0;     // Tiempo de pared del bloque medido
+};
+
+inline LecturaContadores sumaLecturas(const std::vector<LecturaContadores> &ls) {
+    LecturaContadores t;
+    for (int e = 0; e < NUM_EVENTOS; e++) {
+        for (const LecturaContadores &l : ls) {
+            if (!l.hay(e)) continue;
+            t.v[e] = std::max(t.v[e], 0.0) + l.v[e];
+        }
+    }
+    return t;
+}
+
+// ===============================
+// Abre los contadores en cada hilo del equipo de OpenMP, corre "kernel"
+// "repeticiones" veces con todos habilitados y devuelve las lecturas.
+// ===============================
+template <typename Kernel>
+MedicionContadores mideContadores(Kernel &&kernel, int repeticiones) {
+    const int hilos = omp_get_max_threads();
+    std::vector<ContadoresHilo> contadores(hilos);
+#pragma omp parallel num_threads(hilos)
+    contadores[omp_get_thread_num()].abre();
+
+    MedicionContadores m;
+    for (ContadoresHilo &c : contadores) c.habilita();
+    const double t0 = omp_get_wtime();
+    for (int r = 0; r < repeticiones; r++) kernel();
+    m.segundos = omp_get_wtime() - t0;
+    for (ContadoresHilo &c : contadores) c.deshabilita();
+
+    for (const ContadoresHilo &c : contadores) m.por_hilo.push_back(c.lee());
+    m.total = sumaLecturas(m.por_hilo);
+    return m;
+}
+
+// "n/d" para eventos no disponibles
+inline std::string textoContador(double v, int decimales, double escala = 1.0) {
+    if (v < 0.0) return "n/d";
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(decimales) << v / escala;
+    return os.str();
+}
+
+inline void imprimeEncabezadoContadores(const char *primera) {
+    std::cout << std::left << std::setw(20) << primera << std::right << std::setw(10) << "Gciclos"
+              << std::setw(8) << "IPC" << std::setw(7) << "GHz" << std::setw(8) << "f/fref"
+              << std::setw(10) << "B/ciclo" << std::setw(11) << "LLC(M)" << std::setw(11) << "DTLB(M)"
+              << std::setw(10) << "DRAM GB/s" << std::setw(10) << "CPU ms" << std::setw(8) << "ctx"
+              << std::setw(7) << "migr" << "\n";
+}
+
+// Una fila; "bytes" son los bytes útiles que movió la fila (para B/ciclo)
+inline void imprimeFilaContadores(const std::string &nombre, const LecturaContadores &l,
+                                  double bytes, double segundos) {
+    const double b_ciclo = l.hay(CICLOS) && l.v[CICLOS] > 0 ? bytes / l.v[CICLOS] : -1.0;
+    const double dram = l.hay(FALLOS_LLC) && segundos > 0 ? 64.0 * l.v[FALLOS_LLC] / segundos / 1e9 : -1.0;
+    std::cout << std::left << std::setw(20) << nombre << std::right
+              << std::setw(10) << textoContador(l.v[CICLOS], 3, 1e9) << std::setw(8) << textoContador(l.ipc(), 2)
+              << std::setw(7) << textoContador(l.ghz(), 2) << std::setw(8) << textoContador(l.frecuenciaRelativa(), 2)
+              << std::setw(10) << textoContador(b_ciclo, 2) << std::setw(11) << textoContador(l.v[FALLOS_LLC], 2, 1e6)
+              << std::setw(11) << textoContador(l.v[FALLOS_DTLB], 2, 1e6) << std::setw(10) << textoContador(dram, 2)
+              << std::setw(10) << textoContador(l.v[RELOJ_TAREA], 2, 1e6)
+              << std::setw(8) << textoContador(l.v[CAMBIOS_CONTEXTO], 0)
+              << std::setw(7) << textoContador(l.v[MIGRACIONES], 0) << "\n";
+}
+
+// ===============================
+// Diagnóstico aproximado de una medición paralela:
+//  - frecuencia: ciclos / ciclos de referencia < 0.9
+//  - memoria:    el tráfico estimado de DRAM cubre la mitad o más de los
+//                bytes útiles
+//  - planificación: desbalance de task-clock (max / media) > 1.2, o más
+//                de un cambio de contexto por hilo y repetición
+// ===============================
+inline std::string diagnosticoContadores(const MedicionContadores &m, double bytes, int repeticiones) {
+    std::vector<std::string> causas;
+    const LecturaContadores &t = m.total;
+    if (t.frecuenciaRelativa() >= 0.0 && t.frecuenciaRelativa() < 0.9) {
+        causas.push_back("frecuencia reducida (throttling)");
+    }
+    if (t.hay(FALLOS_LLC) && 64.0 * t.v[FALLOS_LLC] >= 0.5 * bytes) {
+        causas.push_back("limitado por memoria");
+    }
+    double maximo = 0.0, suma = 0.0;
+    int con_reloj = 0;
+    for (const LecturaContadores &l : m.por_hilo) {
+        if (!l.hay(RELOJ_TAREA)) continue;
+        maximo = std::max(maximo, l.v[RELOJ_TAREA]);
+        suma += l.v[RELOJ_TAREA];
+        con_reloj++;
+    }
+    const double desbalance = con_reloj > 0 && suma > 0 ? maximo / (suma / con_reloj) : 1.0;
+    const double hilos = static_cast<double>(m.por_hilo.size());
+    if (desbalance > 1.2 || (t.hay(CAMBIOS_CONTEXTO) && t.v[CAMBIOS_CONTEXTO] > hilos * repeticiones)) {
+        causas.push_back("planificacion (desbalance o desalojos)");
+    }
+    if (causas.empty()) {
+        return t.hay(CICLOS) ? "limitado por computo / front-end" : "sin causa detectada (contadores de hardware n/d)";
+    }
+    std::string texto = causas[0];
+    for (std::size_t i = 1; i < causas.size(); i++) texto += ", " + causas[i];
+    return texto;
+}
@@ -0,0 +1,252 @@
+/******************************************************************************
+ * desborde.hpp
+ * Descripción:
+ *  - C[i] = A[i] + B[i] sobre enteros con signo es comportamiento indefinido
+ *    si desborda; el rango inicial [1, 1000] no llega, los datos reales sí.
+ *    Tres sumas seguras con la semántica definida:
+ *      comprobada: C queda con la suma envolvente (mod 2^bits) y se
+ *                  devuelve el primer índice que desbordó (-1 si ninguno)
+ *      saturada:   el resultado se satura a [min, max] del tipo; se
+ *                  devuelve cuántos elementos se saturaron
+ *      ampliada:   la salida es del doble de ancho (int8 -> int16,
+ *                  int16 -> int32, int32 -> int64) y no puede desbordar
+ *  - La detección no tiene saltos por elemento: con s = a + b envolvente,
+ *    hubo desborde si s tiene signo distinto de a y de b, es decir si
+ *    (a ^ s) & (b ^ s) es negativo. Cada bloque acumula esas palabras con
+ *    reduction(|:) dentro del bucle SIMD y solo mira el bit de signo al
+ *    final; únicamente los bloques marcados se recorren otra vez para dar
+ *    el índice exacto o la cuenta.
+ *  - Los bucles llevan #pragma omp simd y se compilan una vez por ISA con
+ *    target(...), con el despacho por CPUID de operaciones.hpp. Los
+ *    bloques son los de schedule(static, chunk).
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+#include <cstdint>
+#include <limits>       // numeric_limits
+#include <type_traits>  // make_unsigned
+
+#include "simd.hpp"     // SUMA_X86, soportaAVX512
+
+// Tipo de salida de la suma ampliada (void: no hay uno más ancho)
+template <typename T> struct Ampliado { using tipo = void; };
+template <> struct Ampliado<std::int8_t> { using tipo = std::int16_t; };
+template <> struct Ampliado<std::int16_t> { using tipo = std::int32_t; };
+template <> struct Ampliado<std::int32_t> { using tipo = std::int64_t; };
+
+template <typename T>
+using AmpliadoT = typename Ampliado<T>::tipo;
+
+// a + b módulo 2^bits, sin comportamiento indefinido
+template <typename T>
+inline T sumaEnvolvente(T a, T b) {
+    using U = typename std::make_unsigned<T>::type;
+    return static_cast<T>(static_cast<U>(static_cast<U>(a) + static_cast<U>(b)));
+}
+
+// Negativo si a + b desborda (el signo de s difiere del de a y del de b)
+template <typename T>
+inline T palabraDesborde(T a, T b, T s) {
+    return static_cast<T>((a ^ s) & (b ^ s));
+}
+
+template <typename T>
+inline T sumaSaturadaElemento(T a, T b) {
+    const T s = sumaEnvolvente(a, b);
+    if (palabraDesborde(a, b, s) >= 0) return s;
+    return a < 0 ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+}
+
+// ===============================
+// Cuerpos por bloque: se instancian dentro de cada función con target
+// distinto. Devuelven true si algún elemento del bloque desbordó.
+// ===============================
+#define SUMA_CUERPO_COMPROBADA                                        \
+    T d = 0;                                                          \
+    _Pragma("omp simd reduction(| : d)")                              \
+    for (long long i = 0; i < n; i++) {                               \
+        const T s = sumaEnvolvente(A[i], B[i]);                       \
+        C[i] = s;                                                     \
+        d |= palabraDesborde(A[i], B[i], s);                          \
+    }                                                                 \
+    return d < 0;
+
+#define SUMA_CUERPO_SATURADA                                          \
+    constexpr T MINIMO = std::numeric_limits<T>::min();               \
+    constexpr T MAXIMO = std::numeric_limits<T>::max();               \
+    T d = 0;                                                          \
+    _Pragma("omp simd reduction(| : d)")                              \
+    for (long long i = 0; i < n; i++) {                               \
+        const T s = sumaEnvolvente(A[i], B[i]);                       \
+        const T w = palabraDesborde(A[i], B[i], s);                   \
+        C[i] = w < 0 ? (A[i] < 0 ? MINIMO : MAXIMO) : s;              \
+        d |= w;                                                       \
+    }                                                                 \
+    return d < 0;
+
+#define SUMA_CUERPO_AMPLIADA                                          \
+    _Pragma("omp simd")                                               \
+    for (long long i = 0; i < n; i++) {                               \
+        C[i] = static_cast<W>(static_cast<W>(A[i]) + static_cast<W>(B[i])); \
+    }
+
+template <typename T>
+using BloqueDesborde = bool (*)(const T *A, const T *B, T *C, long long n);
+template <typename T, typename W>
+using BloqueAmpliado = void (*)(const T *A, const T *B, W *C, long long n);
+
+template <typename T>
+bool comprobadaBase(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_COMPROBADA }
+template <typename T>
+bool saturadaBase(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_SATURADA }
+template <typename T, typename W>
+void ampliadaBase(const T *A, const T *B, W *C, long long n) { SUMA_CUERPO_AMPLIADA }
+
+#ifdef SUMA_X86
+template <typename T>
+__attribute__((target("avx2")))
+bool comprobadaAVX2(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_COMPROBADA }
+template <typename T>
+__attribute__((target("avx2")))
+bool saturadaAVX2(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_SATURADA }
+template <typename T, typename W>
+__attribute__((target("avx2")))
+void ampliadaAVX2(const T *A, const T *B, W *C, long long n) { SUMA_CUERPO_AMPLIADA }
+
+// AVX512F para entradas de 32 bits; F + BW para 8 y 16 (simd.hpp)
+template <typename T>
+__attribute__((target("avx512f")))
+bool comprobadaAVX512F(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_COMPROBADA }
+template <typename T>
+__attribute__((target("avx512f")))
+bool saturadaAVX512F(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_SATURADA }
+template <typename T, typename W>
+__attribute__((target("avx512f")))
+void ampliadaAVX512F(const T *A, const T *B, W *C, long long n) { SUMA_CUERPO_AMPLIADA }
+
+template <typename T>
+__attribute__((target("avx512f,avx512bw")))
+bool comprobadaAVX512BW(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_COMPROBADA }
+template <typename T>
+__attribute__((target("avx512f,avx512bw")))
+bool saturadaAVX512BW(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_SATURADA }
+template <typename T, typename W>
+__attribute__((target("avx512f,avx512bw")))
+void ampliadaAVX512BW(const T *A, const T *B, W *C, long long n) { SUMA_CUERPO_AMPLIADA }
+#endif
+
+// ===============================
+// Despacho por CPUID, resuelto una vez por variante y tipo
+// ===============================
+#ifdef SUMA_X86
+#define SUMA_ELIGE_ISA(T, f, base, avx2, avx512f, avx512bw)                             \
+    f = base;                                                                           \
+    __builtin_cpu_init();                                                               \
+    if (__builtin_cpu_supports("avx2")) f = avx2;                                       \
+    if (soportaAVX512<T>()) {                                                           \
+        if constexpr (AVX512_REQUIERE_BW<T>) f = avx512bw;                              \
+        else f = avx512f;                                                               \
+    }
+#else
+#define SUMA_ELIGE_ISA(T, f, base, avx2, avx512f, avx512bw) f = base;
+#endif
+
+template <typename T>
+BloqueDesborde<T> bloqueComprobado() {
+    static const BloqueDesborde<T> elegida = [] {
+        BloqueDesborde<T> f;
+        SUMA_ELIGE_ISA(T, f, comprobadaBase<T>, comprobadaAVX2<T>, comprobadaAVX512F<T>,
+                       comprobadaAVX512BW<T>)
+        return f;
+    }();
+    return elegida;
+}
+
+template <typename T>
+BloqueDesborde<T> bloqueSaturado() {
+    static const BloqueDesborde<T> elegida = [] {
+        BloqueDesborde<T> f;
+        SUMA_ELIGE_ISA(T, f, saturadaBase<T>, saturadaAVX2<T>, saturadaAVX512F<T>,
+                       saturadaAVX512BW<T>)
+        return f;
+    }();
+    return elegida;
+}
+
+template <typename T, typename W = AmpliadoT<T>>
+BloqueAmpliado<T, W> bloqueAmpliado() {
+    static const BloqueAmpliado<T, W> elegida = [] {
+        BloqueAmpliado<T, W> f;
+        SUMA_ELIGE_ISA(T, f, (ampliadaBase<T, W>), (ampliadaAVX2<T, W>), (ampliadaAVX512F<T, W>),
+                       (ampliadaAVX512BW<T, W>))
+        return f;
+    }();
+    return elegida;
+}
+
+// Segunda pasada sobre un bloque marcado: el primer índice en escalar
+// (termina en cuanto lo encuentra), la cuenta también con SIMD
+template <typename T>
+long long primerDesborde(const T *A, const T *B, long long n) {
+    for (long long i = 0; i < n; i++) {
+        if (palabraDesborde(A[i], B[i], sumaEnvolvente(A[i], B[i])) < 0) return i;
+    }
+    return n;
+}
+
+template <typename T>
+long long cuentaDesbordes(const T *A, const T *B, long long n) {
+    long long k = 0;
+#pragma omp simd reduction(+ : k)
+    for (long long i = 0; i < n; i++) {
+        k += palabraDesborde(A[i], B[i], sumaEnvolvente(A[i], B[i])) < 0;
+    }
+    return k;
+}
+
+// ===============================
+// Sumas paralelas: bloques de schedule(static, chunk) con el cuerpo SIMD
+// ===============================
+
+// Primer índice que desbordó (-1 si ninguno); C con la suma envolvente
+template <typename T>
+long long sumaComprobada(const T *A, const T *B, T *C, long long n, long long chunk) {
+    const BloqueDesborde<T> f = bloqueComprobado<T>();
+    const long long bloques = (n + chunk - 1) / chunk;
+    long long primero = std::numeric_limits<long long>::max();
+#pragma omp parallel for schedule(static, 1) reduction(min : primero)
+    for (long long b = 0; b < bloques; b++) {
+        const long long i = b * chunk;
+        const long long m = std::min(chunk, n - i);
+        if (f(A + i, B + i, C + i, m)) primero = std::min(primero, i + primerDesborde(A + i, B + i, m));
+    }
+    return primero == std::numeric_limits<long long>::max() ? -1 : primero;
+}
+
+// Elementos saturados
+template <typename T>
+long long sumaSaturada(const T *A, const T *B, T *C, long long n, long long chunk) {
+    const BloqueDesborde<T> f = bloqueSaturado<T>();
+    const long long bloques = (n + chunk - 1) / chunk;
+    long long saturados = 0;
+#pragma omp parallel for schedule(static, 1) reduction(+ : saturados)
+    for (long long b = 0; b < bloques; b++) {
+        const long long i = b * chunk;
+        const long long m = std::min(chunk, n - i);
+        if (f(A + i, B + i, C + i, m)) saturados += cuentaDesbordes(A + i, B + i, m);
+    }
+    return saturados;
+}
+
+template <typename T, typename W>
+void sumaAmpliada(const T *A, const T *B, W *C, long long n, long long chunk) {
+    const BloqueAmpliado<T, W> f = bloqueAmpliado<T, W>();
+    const long long bloques = (n + chunk - 1) / chunk;
+#pragma omp parallel for schedule(static, 1)
+    for (long long b = 0; b < bloques; b++) {
+        const long long i = b * chunk;
+        f(A + i, B + i, C + i, std::min(chunk, n - i));
+    }
+}
@@ -0,0 +1,245 @@
+/******************************************************************************
+ * despachador.hpp
+ * Descripción:
+ *  - Punto de entrada único suma(A, B, C, n) que elige la ruta según N:
+ *      (1) n <  umbral_simd              -> bucle secuencial escalar
+ *      (2) umbral_simd <= n < paralelo   -> variante SIMD despachada (simd.hpp)
+ *      (3) n >= umbral_paralelo          -> OpenMP por bloques + SIMD
+ *  - Los umbrales se calibran con un microbenchmark corto (tamaños 2^8..2^20)
+ *    y se guardan en un archivo de caché, indexado por tipo, hilos, chunk y
+ *    variante SIMD, para no recalibrar en cada arranque.
+ *  - Con un solo hilo la ruta paralela nunca se elige.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min, max
+#include <climits>      // LLONG_MAX
+#include <cstdio>       // rename
+#include <cstdlib>      // getenv
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>   // mkdir
+#include <omp.h>
+
+#include "benchmark.hpp"      // mide
+#include "configuracion.hpp"  // Configuracion
+#include "kernels.hpp"        // sumaSecuencial, sumaParalelaCon
+#include "memoria.hpp"        // BufferAlineado
+#include "simd.hpp"           // varianteSimd
+#include "tipos.hpp"          // nombreTipo
+
+// Ruta elegida para una llamada
+enum class RutaSuma { Secuencial, Simd, Paralela };
+
+inline const char *nombreRuta(RutaSuma r) {
+    switch (r) {
+        case RutaSuma::Secuencial: return "secuencial";
+        case RutaSuma::Simd: return "simd";
+        default: return "paralela";
+    }
+}
+
+// Umbrales de cruce en elementos (LLONG_MAX = nunca)
+struct UmbralesSuma {
+    long long simd = 0;
+    long long paralelo = LLONG_MAX;
+    bool desde_cache = false;
+};
+
+// ===============================
+// Archivo de caché: --cache-umbrales, o bien
+// $XDG_CACHE_HOME (o $HOME/.cache)/suma_arreglos_umbrales.txt
+// ===============================
+inline std::string rutaCacheUmbrales(const Configuracion &cfg) {
+    if (!cfg.cache_umbrales.empty()) return cfg.cache_umbrales;
+    std::string dir;
+    if (const char *xdg = std::getenv("XDG_CACHE_HOME")) {
+        dir = xdg;
+    } else if (const char *home = std::getenv("HOME")) {
+        dir = std::string(home) + "/.cache";
+    }
+    if (dir.empty()) return "suma_arreglos_umbrales.txt";
+    mkdir(dir.c_str(), 0755);   // Si ya existe no pasa nada
+    return dir + "/suma_arreglos_umbrales.txt";
+}
+
+// Clave de una línea del archivo: "<tipo> <hilos> <chunk> <variante>"
+template <typename T>
+std::string claveUmbrales(int hilos, long long chunk) {
+    std::ostringstream os;
+    os << nombreTipo<T>() << ' ' << hilos << ' ' << chunk << ' ' << varianteSimd<T>().nombre;
+    return os.str();
+}
+
+// Busca la clave; cada línea es "<clave> <umbral_simd> <umbral_paralelo>"
+inline bool leeUmbrales(const std::string &ruta, const std::string &clave, UmbralesSuma &u) {
+    std::ifstream in(ruta);
+    std::string linea;
+    while (std::getline(in, linea)) {
+        if (linea.compare(0, clave.size() + 1, clave + ' ') != 0) continue;
+        std::istringstream is(linea.substr(clave.size() + 1));
+        if (is >> u.simd >> u.paralelo) {
+            u.desde_cache = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Reescribe el archivo reemplazando (o agregando) la línea de la clave.
+// Se escribe a un temporal y se renombra para no dejar el archivo a medias.
+inline bool guardaUmbrales(const std::string &ruta, const std::string &clave, const UmbralesSuma &u) {
+    std::vector<std::string> lineas;
+    {
+        std::ifstream in(ruta);
+        std::string linea;
+        while (std::getline(in, linea)) {
+            if (linea.compare(0, clave.size() + 1, clave + ' ') != 0) lineas.push_back(linea);
+        }
+    }
+    lineas.push_back(clave + ' ' + std::to_string(u.simd) + ' ' + std::to_string(u.paralelo));
+
+    const std::string temporal = ruta + ".tmp";
+    {
+        std::ofstream out(temporal, std::ios::trunc);
+        if (!out) return false;
+        for (const std::string &l : lineas) out << l << '\n';
+        if (!out) return false;
+    }
+    return std::rename(temporal.c_str(), ruta.c_str()) == 0;
+}
+
+// ===============================
+// Calibración: para cada tamaño 2^k se mide el mínimo de un lote de
+// llamadas (~2^20 elementos por lote) de cada ruta. El cruce es el primer
+// tamaño desde el cual la ruta más cara gana en ese tamaño y en todos los
+// siguientes, para que el ruido de un punto aislado no adelante el umbral.
+// En empate (5%) se prefiere SIMD; OpenMP debe ganar por más de un 10%.
+// ===============================
+template <typename T>
+UmbralesSuma calibraUmbrales(long long chunk) {
+    constexpr int K_MIN = 8;
+    constexpr int K_MAX = 20;
+    const long long n_max = 1LL << K_MAX;
+    BufferAlineado<T> bufA(n_max, false);
+    BufferAlineado<T> bufB(n_max, false);
+    BufferAlineado<T> bufC(n_max, false);
+    T *A = bufA.data();
+    T *B = bufB.data();
+    T *C = bufC.data();
+    std::fill(A, A + n_max, T(1));
+    std::fill(B, B + n_max, T(2));
+
+    const FuncionSumaT<T> simd = varianteSimd<T>().funcion;
+    const bool hay_paralelo = omp_get_max_threads() > 1;
+
+    std::vector<long long> tamanos;
+    std::vector<bool> gana_simd, gana_paralelo;
+    for (int k = K_MIN; k <= K_MAX; k++) {
+        const long long n = 1LL << k;
+        const long long llamadas = std::max(1LL, n_max / n);
+        auto lote = [&](int ruta) {
+            return mide([&] {
+                for (long long r = 0; r < llamadas; r++) {
+                    if (ruta == 0) sumaSecuencial(A, B, C, n);
+                    else if (ruta == 1) simd(A, B, C, n);
+                    else sumaParalelaCon(simd, A, B, C, n, chunk);
+                }
+            }, 1, 3).minimo;
+        };
+        const double t_seq = lote(0);
+        const double t_simd = lote(1);
+        tamanos.push_back(n);
+        gana_simd.push_back(t_simd <= 1.05 * t_seq);
+        gana_paralelo.push_back(hay_paralelo && lote(2) < 0.9 * std::min(t_seq, t_simd));
+    }
+
+    // Primer índice desde el cual todos los siguientes ganan
+    auto cruce = [&](const std::vector<bool> &gana) {
+        long long umbral = LLONG_MAX;
+        for (std::size_t i = gana.size(); i-- > 0 && gana[i];) umbral = tamanos[i];
+        return umbral;
+    };
+    UmbralesSuma u;
+    u.simd = cruce(gana_simd);
+    if (u.simd == tamanos.front()) u.simd = 0;     // SIMD gana desde el inicio
+    u.paralelo = cruce(gana_paralelo);
+    return u;
+}
+
+// ===============================
+// Umbrales para cfg: del caché si existen (salvo --recalibrar); si no, se
+// calibran y se guardan.
+// ===============================
+template <typename T>
+UmbralesSuma umbralesSuma(const Configuracion &cfg) {
+    const std::string ruta = rutaCacheUmbrales(cfg);
+    const std::string clave = claveUmbrales<T>(omp_get_max_threads(), cfg.chunk);
+    UmbralesSuma u;
+    if (!cfg.recalibrar && leeUmbrales(ruta, clave, u)) return u;
+    u = calibraUmbrales<T>(cfg.chunk);
+    if (!guardaUmbrales(ruta, clave, u)) {
+        std::cerr << "[AVISO] no se pudo escribir el cache de umbrales en " << ruta << "\n";
+    }
+    return u;
+}
+
+// ===============================
+// Despachador: elige y ejecuta la ruta según los umbrales
+// ===============================
+template <typename T>
+class DespachadorSuma {
+public:
+    DespachadorSuma() = default;
+    DespachadorSuma(const UmbralesSuma &u, long long chunk)
+        : umbrales_(u), chunk_(chunk), calibrado_(true) {}
+
+    bool calibrado() const { return calibrado_; }
+    const UmbralesSuma &umbrales() const { return umbrales_; }
+
+    RutaSuma elige(long long n) const {
+        if (n >= umbrales_.paralelo) return RutaSuma::Paralela;
+        if (n >= umbrales_.simd) return RutaSuma::Simd;
+        return RutaSuma::Secuencial;
+    }
+
+    void operator()(const T *A, const T *B, T *C, long long n) const {
+        switch (elige(n)) {
+            case RutaSuma::Secuencial: sumaSecuencial(A, B, C, n); break;
+            case RutaSuma::Simd: sumaSimd(A, B, C, n); break;
+            default: sumaParalelaCon(varianteSimd<T>().funcion, A, B, C, n, chunk_); break;
+        }
+    }
+
+private:
+    UmbralesSuma umbrales_;
+    long long chunk_ = 100;
+    bool calibrado_ = false;
+};
+
+// Despachador compartido por tipo (configúrese antes de usarlo desde varios hilos)
+template <typename T>
+DespachadorSuma<T> &despachadorSuma() {
+    static DespachadorSuma<T> d;
+    return d;
+}
+
+template <typename T>
+const DespachadorSuma<T> &configuraDespachador(const Configuracion &cfg) {
+    despachadorSuma<T>() = DespachadorSuma<T>(umbralesSuma<T>(cfg), cfg.chunk);
+    return despachadorSuma<T>();
+}
+
+// ===============================
+// C = A + B por la ruta más rápida para n. Si el despachador no se
+// configuró, se configura con los valores por defecto (caché incluido).
+// ===============================
+template <typename T>
+void suma(const T *A, const T *B, T *C, long long n) {
+    DespachadorSuma<T> &d = despachadorSuma<T>();
+    if (!d.calibrado()) configuraDespachador<T>(Configuracion{});
+    d(A, B, C, n);
+}
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * dispositivo.hpp
+ * Descripción:
+ *  - Suma descargada a un acelerador con directivas target de OpenMP:
+ *      (1) sumaDispositivo: una región target con map explícitos; mide por
+ *          separado la copia host->device, el núcleo y la copia de vuelta.
+ *      (2) sumaDispositivoResidente: solo el núcleo, con A, B y C ya
+ *          presentes en el dispositivo (target enter data).
+ *      (3) sumaDispositivoPipeline: por bloques; la copia del bloque k+1
+ *          se solapa con el cómputo del bloque k y con la copia de vuelta de
+ *          k-1 (target nowait + depend sobre cada bloque).
+ *  - Núcleo: #pragma omp target teams distribute parallel for.
+ *  - Sin dispositivos (omp_get_num_devices() == 0, o compilado sin
+ *    -foffload) las regiones target corren en el host: el resultado es el
+ *    mismo y los tiempos de copia miden solo el costo del runtime.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+#include <omp.h>
+
+// Tiempos de una llamada descargada (ms)
+struct TiemposDispositivo {
+    double ida = 0.0;       // host -> device
+    double nucleo = 0.0;
+    double vuelta = 0.0;    // device -> host
+    double total() const { return ida + nucleo + vuelta; }
+};
+
+inline int numeroDispositivos() { return omp_get_num_devices(); }
+
+// Núcleo sobre datos ya presentes en el dispositivo: los map solo suben el
+// contador de referencias, no copian (map(present, ...) es de OpenMP 5.1)
+template <typename T>
+void nucleoDispositivo(const T *A, const T *B, T *C, long long inicio, long long fin, int dispositivo) {
+#pragma omp target teams distribute parallel for device(dispositivo) \
+    map(to: A[inicio:fin - inicio], B[inicio:fin - inicio]) map(from: C[inicio:fin - inicio])
+    for (long long i = inicio; i < fin; i++) {
+        C[i] = static_cast<T>(A[i] + B[i]);
+    }
+}
+
+// ===============================
+// (1) Llamada completa: reserva, copia, núcleo, copia de vuelta y libera.
+// Cada fase es síncrona para poder atribuirle su tiempo.
+// ===============================
+template <typename T>
+TiemposDispositivo sumaDispositivo(const T *A, const T *B, T *C, long long n, int dispositivo) {
+    TiemposDispositivo t;
+#pragma omp target enter data device(dispositivo) map(alloc: A[0:n], B[0:n], C[0:n])
+
+    double t0 = omp_get_wtime();
+#pragma omp target update device(dispositivo) to(A[0:n], B[0:n])
+    double t1 = omp_get_wtime();
+    nucleoDispositivo(A, B, C, 0, n, dispositivo);
+    double t2 = omp_get_wtime();
+#pragma omp target update device(dispositivo) from(C[0:n])
+    double t3 = omp_get_wtime();
+
+#pragma omp target exit data device(dispositivo) map(release: A[0:n], B[0:n], C[0:n])
+    t.ida = (t1 - t0) * 1e3;
+    t.nucleo = (t2 - t1) * 1e3;
+    t.vuelta = (t3 - t2) * 1e3;
+    return t;
+}
+
+// ===============================
+// (2) Datos residentes: el llamador hace entraDispositivo antes y
+// saleDispositivo después; cada suma solo lanza el núcleo.
+// ===============================
+template <typename T>
+void entraDispositivo(const T *A, const T *B, T *C, long long n, int dispositivo) {
+#pragma omp target enter data device(dispositivo) map(to: A[0:n], B[0:n]) map(alloc: C[0:n])
+}
+
+template <typename T>
+void saleDispositivo(const T *A, const T *B, T *C, long long n, int dispositivo) {
+#pragma omp target exit data device(dispositivo) map(release: A[0:n], B[0:n]) map(from: C[0:n])
+}
+
+template <typename T>
+void sumaDispositivoResidente(const T *A, const T *B, T *C, long long n, int dispositivo) {
+    nucleoDispositivo(A, B, C, 0, n, dispositivo);
+}
+
+// ===============================
+// (3) Pipeline por bloques. Cada bloque encadena ida -> núcleo -> vuelta
+// con depend(inout: C[i]) como testigo; bloques distintos no dependen entre
+// sí y el runtime los solapa (varias colas/streams en el dispositivo).
+// La memoria del dispositivo se reserva completa una vez por llamada.
+// ===============================
+template <typename T>
+void sumaDispositivoPipeline(const T *A, const T *B, T *C, long long n, long long bloque,
+                             int dispositivo) {
+#pragma omp target enter data device(dispositivo) map(alloc: A[0:n], B[0:n], C[0:n])
+    for (long long i = 0; i < n; i += bloque) {
+        const long long m = std::min(bloque, n - i);
+#pragma omp target update device(dispositivo) to(A[i:m], B[i:m]) depend(inout: C[i]) nowait
+#pragma omp target teams distribute parallel for device(dispositivo) depend(inout: C[i]) nowait \
+    map(to: A[i:m], B[i:m]) map(from: C[i:m])
+        for (long long j = i; j < i + m; j++) {
+            C[j] = static_cast<T>(A[j] + B[j]);
+        }
+#pragma omp target update device(dispositivo) from(C[i:m]) depend(inout: C[i]) nowait
+    }
+#pragma omp taskwait
+#pragma omp target exit data device(dispositivo) map(release: A[0:n], B[0:n], C[0:n])
+}
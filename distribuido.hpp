@@ -0,0 +1,161 @@
+/******************************************************************************
+ * distribuido.hpp
+ * Descripción:
+ *  - Suma híbrida MPI + OpenMP: A, B y C se reparten por bloques contiguos
+ *    entre los procesos; cada proceso genera su tramo (Philox por índice
+ *    global, ver aleatorio.hpp) y corre el for de OpenMP sobre él.
+ *  - Verificación sin reunir C en el proceso 0: cada proceso calcula la
+ *    huella de su tramo de C y la de referencia desde A y B, ponderadas por
+ *    índice global, y ambas se suman con MPI_Allreduce (mod 2^64).
+ *  - El tiempo de una repetición es el del proceso más lento (MPI_MAX),
+ *    con una barrera antes de arrancar.
+ *  - Sin SUMA_MPI (compilado con g++ en vez de mpicxx -DSUMA_MPI) las mismas
+ *    funciones trabajan con un único proceso.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <omp.h>
+
+#ifdef SUMA_MPI
+#define OMPI_SKIP_MPICXX 1   // Solo la API de C: sin los enlaces C++ obsoletos
+#define MPICH_SKIP_MPICXX 1
+#include <mpi.h>
+#endif
+
+// ===============================
+// Inicio y fin de MPI (RAII). Solo el hilo maestro llama a MPI: basta
+// MPI_THREAD_FUNNELED.
+// ===============================
+class SesionMpi {
+public:
+    SesionMpi(int &argc, char **&argv) {
+#ifdef SUMA_MPI
+        int provisto = 0;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provisto);
+#else
+        (void)argc;
+        (void)argv;
+#endif
+    }
+
+    ~SesionMpi() {
+#ifdef SUMA_MPI
+        MPI_Finalize();
+#endif
+    }
+
+    SesionMpi(const SesionMpi &) = delete;
+    SesionMpi &operator=(const SesionMpi &) = delete;
+};
+
+inline bool hayMpi() {
+#ifdef SUMA_MPI
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Proceso e índice dentro de MPI_COMM_WORLD (0 y 1 sin MPI)
+inline int rangoMpi() {
+    int r = 0;
+#ifdef SUMA_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &r);
+#endif
+    return r;
+}
+
+inline int procesosMpi() {
+    int p = 1;
+#ifdef SUMA_MPI
+    MPI_Comm_size(MPI_COMM_WORLD, &p);
+#endif
+    return p;
+}
+
+// La semilla del proceso 0 para todos (si no se fijó, cada uno sacaría otra)
+inline std::uint64_t difundeSemilla(std::uint64_t semilla) {
+#ifdef SUMA_MPI
+    unsigned long long s = semilla;
+    MPI_Bcast(&s, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+    semilla = s;
+#endif
+    return semilla;
+}
+
+// ===============================
+// Grupo de los primeros "procesos" rangos, para medir escalado con 1, 2,
+// 4, ... procesos en una sola ejecución. Los rangos fuera del grupo no
+// participan (activo() == false).
+// ===============================
+class GrupoMpi {
+public:
+    explicit GrupoMpi(int procesos) : procesos_(procesos) {
+        const int rango = rangoMpi();
+        activo_ = rango < procesos;
+        rango_ = rango;
+#ifdef SUMA_MPI
+        MPI_Comm_split(MPI_COMM_WORLD, activo_ ? 0 : MPI_UNDEFINED, rango, &comm_);
+#endif
+    }
+
+    ~GrupoMpi() {
+#ifdef SUMA_MPI
+        if (comm_ != MPI_COMM_NULL) MPI_Comm_free(&comm_);
+#endif
+    }
+
+    GrupoMpi(const GrupoMpi &) = delete;
+    GrupoMpi &operator=(const GrupoMpi &) = delete;
+
+    bool activo() const { return activo_; }
+    int rango() const { return rango_; }
+    int procesos() const { return procesos_; }
+
+    void barrera() const {
+#ifdef SUMA_MPI
+        MPI_Barrier(comm_);
+#endif
+    }
+
+    double maximo(double v) const {
+#ifdef SUMA_MPI
+        MPI_Allreduce(MPI_IN_PLACE, &v, 1, MPI_DOUBLE, MPI_MAX, comm_);
+#endif
+        return v;
+    }
+
+    // Suma mod 2^64, como la huella local
+    std::uint64_t sumaHuellas(std::uint64_t h) const {
+#ifdef SUMA_MPI
+        unsigned long long v = h;
+        MPI_Allreduce(MPI_IN_PLACE, &v, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm_);
+        h = v;
+#endif
+        return h;
+    }
+
+private:
+    int procesos_;
+    int rango_ = 0;
+    bool activo_ = true;
+#ifdef SUMA_MPI
+    MPI_Comm comm_ = MPI_COMM_NULL;
+#endif
+};
+
+// Tramo del proceso "rango" en un reparto por bloques de n elementos:
+// los primeros n % procesos rangos llevan un elemento más.
+struct Tramo {
+    long long inicio;
+    long long cantidad;
+};
+
+inline Tramo tramoLocal(long long n, int rango, int procesos) {
+    const long long base = n / procesos;
+    const long long resto = n % procesos;
+    const long long inicio = rango * base + (rango < resto ? rango : resto);
+    return {inicio, base + (rango < resto ? 1 : 0)};
+}
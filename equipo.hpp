@@ -0,0 +1,185 @@
+/******************************************************************************
+ * equipo.hpp
+ * Descripción:
+ *  - Equipo de hilos persistente para invocar la suma muchas veces sobre
+ *    vectores chicos o medianos sin pagar en cada llamada el despertar del
+ *    equipo de OpenMP y su barrera:
+ *      (1) Los trabajadores se crean una vez (std::thread) y esperan la
+ *          siguiente tarea girando sobre un contador de época ("spin").
+ *      (2) Tras "giros" vueltas sin trabajo se duermen en una variable de
+ *          condición ("park"), para no quemar CPU entre ráfagas.
+ *      (3) El hilo que llama participa como hilo 0 y espera a los demás
+ *          girando sobre un contador de pendientes (luego cede la CPU).
+ *  - Con más hilos que CPUs no se gira: los trabajadores duermen enseguida.
+ *  - El fin de tarea usa un contador atómico en lugar de una barrera: solo
+ *    el llamador espera, los trabajadores vuelven a girar de inmediato.
+ *  - Sin asignaciones por llamada: la tarea se pasa como puntero a función +
+ *    contexto, no como std::function.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits> // remove_reference
+#include <vector>
+
+// Pausa de espera activa: reduce consumo y contención entre hermanos SMT
+inline void pausaCpu() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// ===============================
+// Equipo persistente con espera "spin-then-park"
+// ===============================
+class EquipoPersistente {
+public:
+    // Con más hilos que CPUs girar solo roba tiempo al hilo que trabaja:
+    // en ese caso los trabajadores duermen de inmediato (giros = 0).
+    explicit EquipoPersistente(int hilos, int giros = 1 << 14)
+        : hilos_(hilos > 0 ? hilos : 1),
+          giros_(static_cast<unsigned>(hilos_) > std::thread::hardware_concurrency() ? 0 : giros) {
+        trabajadores_.reserve(hilos_ - 1);
+        for (int id = 1; id < hilos_; id++) {
+            trabajadores_.emplace_back([this, id] { bucleTrabajador(id); });
+        }
+    }
+
+    ~EquipoPersistente() {
+        fin_.store(true);
+        despierta();
+        for (std::thread &t : trabajadores_) t.join();
+    }
+
+    EquipoPersistente(const EquipoPersistente &) = delete;
+    EquipoPersistente &operator=(const EquipoPersistente &) = delete;
+
+    int hilos() const { return hilos_; }
+
+    // ===============================
+    // Ejecuta f(id, hilos) en todos los hilos del equipo y espera a que
+    // terminen. El llamador corre como id = 0. No es reentrante: un solo
+    // hilo externo debe usar el equipo a la vez.
+    // ===============================
+    template <typename F>
+    void ejecuta(F &&f) {
+        using Fn = typename std::remove_reference<F>::type;
+        contexto_ = const_cast<void *>(static_cast<const void *>(&f));
+        invoca_ = [](void *ctx, int id, int hilos) { (*static_cast<Fn *>(ctx))(id, hilos); };
+        pendientes_.store(hilos_ - 1, std::memory_order_relaxed);
+        despierta();
+
+        invoca_(contexto_, 0, hilos_);
+        for (int g = 0; pendientes_.load(std::memory_order_acquire) != 0; g++) {
+            if (g < giros_) pausaCpu();
+            else std::this_thread::yield();
+        }
+    }
+
+private:
+    // Publica una nueva época; solo toma el mutex si alguien duerme.
+    // epoca_ y dormidos_ son seq_cst: o el trabajador ve la nueva época
+    // antes de dormir, o el llamador lo ve dormido y lo notifica.
+    void despierta() {
+        epoca_.fetch_add(1);
+        if (dormidos_.load() > 0) {
+            std::lock_guard<std::mutex> lk(m_);
+            cv_.notify_all();
+        }
+    }
+
+    void bucleTrabajador(int id) {
+        std::uint64_t vista = 0;
+        for (;;) {
+            std::uint64_t e;
+            int g = 0;
+            while ((e = epoca_.load(std::memory_order_acquire)) == vista) {
+                if (++g < giros_) {
+                    pausaCpu();
+                    continue;
+                }
+                std::unique_lock<std::mutex> lk(m_);
+                dormidos_.fetch_add(1);
+                cv_.wait(lk, [&] { return epoca_.load() != vista; });
+                dormidos_.fetch_sub(1);
+                g = 0;
+            }
+            vista = e;
+            if (fin_.load(std::memory_order_acquire)) return;
+            invoca_(contexto_, id, hilos_);
+            pendientes_.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    const int hilos_;
+    const int giros_;
+    std::vector<std::thread> trabajadores_;
+
+    // Tarea actual (se publica con la época)
+    void (*invoca_)(void *, int, int) = nullptr;
+    void *contexto_ = nullptr;
+
+    std::atomic<std::uint64_t> epoca_{0};
+    std::atomic<int> pendientes_{0};
+    std::atomic<int> dormidos_{0};
+    std::atomic<bool> fin_{false};
+    std::mutex m_;
+    std::condition_variable cv_;
+};
+
+// ===============================
+// Suma en el equipo persistente con el reparto de schedule(static, chunk):
+// el hilo id toma los bloques id, id + hilos, id + 2*hilos, ...
+// ===============================
+template <typename T>
+void sumaEquipo(EquipoPersistente &equipo, const T *A, const T *B, T *C,
+                long long n, long long chunk) {
+    equipo.ejecuta([=](int id, int hilos) {
+        const T *a = A;
+        const T *b = B;
+        T *c = C;
+        for (long long i = id * chunk; i < n; i += static_cast<long long>(hilos) * chunk) {
+            const long long fin = std::min(n, i + chunk);
+            for (long long j = i; j < fin; j++) {
+                c[j] = static_cast<T>(a[j] + b[j]);
+            }
+        }
+    });
+}
+
+// ===============================
+// Alternativa solo con OpenMP: una región parallel que envuelve "llamadas"
+// invocaciones; cada una es un omp for con el mismo schedule(static, chunk).
+//  - con_barrera: cada invocación termina con la barrera del for (C completo
+//    antes de la siguiente, como una llamada normal)
+//  - sin barrera (nowait): válido solo porque cada hilo reescribe siempre los
+//    mismos índices; es la cota inferior de costo por invocación.
+// ===============================
+template <typename T>
+void sumaRegionPersistente(const T *A, const T *B, T *C, long long n, long long chunk,
+                           long long llamadas, bool con_barrera) {
+#pragma omp parallel
+    {
+        for (long long k = 0; k < llamadas; k++) {
+            if (con_barrera) {
+#pragma omp for schedule(static, chunk)
+                for (long long i = 0; i < n; i++) {
+                    C[i] = static_cast<T>(A[i] + B[i]);
+                }
+            } else {
+#pragma omp for schedule(static, chunk) nowait
+                for (long long i = 0; i < n; i++) {
+                    C[i] = static_cast<T>(A[i] + B[i]);
+                }
+            }
+        }
+    }
+}
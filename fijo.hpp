@@ -0,0 +1,198 @@
+/******************************************************************************
+ * fijo.hpp
+ * Descripción:
+ *  - Suma para tamaños conocidos al compilar, para llamadas internas
+ *    calientes con N fija y chica (antes N y chunk eran #define; hoy son
+ *    opciones de ejecución, pero ese caso de uso sigue existiendo):
+ *      sumaFija<N, T>(A, B, C)   sin contador de vuelta variable, sin cola
+ *                                escalar, sin comprobación de solape y sin
+ *                                llamada por puntero: se expande en línea y
+ *                                el compilador la desenrolla entera cuando cabe
+ *      sumaTamano(A, B, C, n)    si n es uno de TamanosFijos usa sumaFija,
+ *                                si no la suma() de despachador.hpp; el
+ *                                cuerpo se compila por ISA y se elige por
+ *                                CPUID (una llamada por puntero, como suma())
+ *  - La ruta (RutaSuma de despachador.hpp) se elige con constexpr:
+ *      escalar:  N * sizeof(T) < 16 bytes (no llena un registro SSE2/NEON);
+ *                desenrollado por completo con una expresión de pliegue
+ *      simd:     #pragma omp simd sobre N constante
+ *      paralela: A + B + C >= SUMA_FIJO_PARALELO bytes (defecto 4 MiB;
+ *                -DSUMA_FIJO_PARALELO=... para otra máquina); bloques de
+ *                schedule(static, chunk) con el núcleo SIMD de operaciones.hpp
+ *  - El ancho vectorial es el de quien la llama: con -march=native, o dentro
+ *    de una función con target("avx2"/"avx512f"; "avx512f,avx512bw" para
+ *    int8/int16), la expansión en línea usa ese ISA. Un despacho por CPUID dentro de sumaFija obligaría a llamar
+ *    por puntero, que es justo lo que se quiere evitar.
+ *  - loteFijo<N, T>() da un lote de llamadas compilado por ISA (despacho por
+ *    CPUID de operaciones.hpp) para el modo fijo, que lo mide contra las
+ *    rutas con n en tiempo de ejecución.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <type_traits>  // integral_constant
+#include <utility>      // integer_sequence, make_integer_sequence
+
+#include "despachador.hpp"   // RutaSuma, suma
+#include "operaciones.hpp"   // OpSuma, opParalelaSimd
+#include "simd.hpp"          // SUMA_X86, FuncionSumaT, soportaAVX512
+
+#ifndef SUMA_FIJO_PARALELO
+#define SUMA_FIJO_PARALELO (4LL << 20)
+#endif
+
+// Expansión en línea obligatoria: con "inline" solo, GCC deja sumaSiConocida
+// fuera de línea (con el ISA base) en vez de expandirla dentro de las
+// funciones con target(...)
+#define SUMA_FIJO_EN_LINEA __attribute__((always_inline)) inline
+
+// Chunk de la ruta paralela si no se da uno
+constexpr long long CHUNK_FIJO = 4096;
+
+// Tamaños con sumaFija instanciada para sumaTamano
+using TamanosFijos = std::integer_sequence<long long, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096>;
+
+// f(integral_constant<long long, N>) por cada tamaño de la lista
+template <typename F, long long... Ns>
+inline void recorreTamanos(F &&f, std::integer_sequence<long long, Ns...>) {
+    (f(std::integral_constant<long long, Ns>{}), ...);
+}
+
+template <long long N, typename T>
+constexpr RutaSuma rutaFija() {
+    if (static_cast<long long>(sizeof(T)) * N < 16) return RutaSuma::Secuencial;
+    if (3 * static_cast<long long>(sizeof(T)) * N >= SUMA_FIJO_PARALELO) return RutaSuma::Paralela;
+    return RutaSuma::Simd;
+}
+
+// Todos los elementos en una expresión: sin bucle
+template <typename T, long long... I>
+SUMA_FIJO_EN_LINEA void sumaDesenrollada(const T *A, const T *B, T *C, std::integer_sequence<long long, I...>) {
+    ((C[I] = static_cast<T>(A[I] + B[I])), ...);
+}
+
+// ===============================
+// C[0..N) = A[0..N) + B[0..N) con N conocida al compilar
+// ===============================
+template <long long N, typename T, long long CHUNK = CHUNK_FIJO>
+SUMA_FIJO_EN_LINEA void sumaFija(const T *__restrict A, const T *__restrict B, T *__restrict C) {
+    static_assert(N > 0, "sumaFija necesita N > 0");
+    constexpr RutaSuma ruta = rutaFija<N, T>();
+    if constexpr (ruta == RutaSuma::Secuencial) {
+        sumaDesenrollada(A, B, C, std::make_integer_sequence<long long, N>{});
+    } else if constexpr (ruta == RutaSuma::Simd) {
+#pragma omp simd
+        for (long long i = 0; i < N; i++) {
+            C[i] = static_cast<T>(A[i] + B[i]);
+        }
+    } else {
+        opParalelaSimd<OpSuma, T>(C, A, B, nullptr, T(0), N, CHUNK);
+    }
+}
+
+// ===============================
+// n en tiempo de ejecución: tamaño fijo si está en la lista, si no la
+// ruta del despachador
+// ===============================
+template <typename T, long long... Ns>
+SUMA_FIJO_EN_LINEA bool sumaSiConocida(const T *A, const T *B, T *C, long long n, std::integer_sequence<long long, Ns...>) {
+    return ((n == Ns && (sumaFija<Ns, T>(A, B, C), true)) || ...);
+}
+
+// El cuerpo se compila una vez por ISA, como los núcleos de operaciones.hpp:
+// una sola llamada por puntero y dentro sumaFija ya expandida con el ancho
+// vectorial de la máquina (con el ISA base perdería contra suma())
+#define SUMA_CUERPO_TAMANO \
+    if (!sumaSiConocida(A, B, C, n, TamanosFijos{})) suma(A, B, C, n);
+
+template <typename T>
+void sumaTamanoBase(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_TAMANO }
+
+#ifdef SUMA_X86
+template <typename T>
+__attribute__((target("avx2")))
+void sumaTamanoAVX2(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_TAMANO }
+
+// Como en simd.hpp: AVX512F para 32 y 64 bits, F + BW para 8 y 16
+template <typename T>
+__attribute__((target("avx512f")))
+void sumaTamanoAVX512F(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_TAMANO }
+
+template <typename T>
+__attribute__((target("avx512f,avx512bw")))
+void sumaTamanoAVX512BW(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_TAMANO }
+#endif
+
+template <typename T>
+FuncionSumaT<T> varianteTamano() {
+    static const FuncionSumaT<T> elegida = [] {
+        FuncionSumaT<T> f = sumaTamanoBase<T>;
+#ifdef SUMA_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) f = sumaTamanoAVX2<T>;
+        if (soportaAVX512<T>()) {
+            if constexpr (AVX512_REQUIERE_BW<T>) f = sumaTamanoAVX512BW<T>;
+            else f = sumaTamanoAVX512F<T>;
+        }
+#endif
+        return f;
+    }();
+    return elegida;
+}
+
+template <typename T>
+inline void sumaTamano(const T *A, const T *B, T *C, long long n) {
+    varianteTamano<T>()(A, B, C, n);
+}
+
+// ===============================
+// Lote de llamadas a sumaFija para medir el costo por llamada. La barrera
+// del compilador impide que funda o elimine las repeticiones (las
+// direcciones y N son constantes); se compila una vez por ISA para que la
+// expansión en línea use el ancho vectorial de la máquina.
+// ===============================
+inline void barreraCompilador() { asm volatile("" ::: "memory"); }
+
+template <typename T>
+using LoteFijo = void (*)(const T *A, const T *B, T *C, long long llamadas);
+
+#define SUMA_CUERPO_LOTE_FIJO                       \
+    for (long long k = 0; k < llamadas; k++) {      \
+        sumaFija<N, T>(A, B, C);                    \
+        barreraCompilador();                        \
+    }
+
+template <long long N, typename T>
+void loteFijoBase(const T *A, const T *B, T *C, long long llamadas) { SUMA_CUERPO_LOTE_FIJO }
+
+#ifdef SUMA_X86
+template <long long N, typename T>
+__attribute__((target("avx2")))
+void loteFijoAVX2(const T *A, const T *B, T *C, long long llamadas) { SUMA_CUERPO_LOTE_FIJO }
+
+template <long long N, typename T>
+__attribute__((target("avx512f")))
+void loteFijoAVX512F(const T *A, const T *B, T *C, long long llamadas) { SUMA_CUERPO_LOTE_FIJO }
+
+template <long long N, typename T>
+__attribute__((target("avx512f,avx512bw")))
+void loteFijoAVX512BW(const T *A, const T *B, T *C, long long llamadas) { SUMA_CUERPO_LOTE_FIJO }
+#endif
+
+template <long long N, typename T>
+LoteFijo<T> loteFijo() {
+    static const LoteFijo<T> elegida = [] {
+        LoteFijo<T> f = loteFijoBase<N, T>;
+#ifdef SUMA_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) f = loteFijoAVX2<N, T>;
+        if (soportaAVX512<T>()) {
+            if constexpr (AVX512_REQUIERE_BW<T>) f = loteFijoAVX512BW<N, T>;
+            else f = loteFijoAVX512F<N, T>;
+        }
+#endif
+        return f;
+    }();
+    return elegida;
+}
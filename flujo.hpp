@@ -0,0 +1,271 @@
+/******************************************************************************
+ * flujo.hpp
+ * Descripción:
+ *  - Tubería por bloques para datos que no caben (o no están) en memoria:
+ *      (1) lector:    llena el siguiente bloque de A y B (archivos o stdin)
+ *      (2) cómputo:   el hilo llamador corre el for de OpenMP sobre el
+ *                     bloque actual (C = A + B, huella fusionada)
+ *      (3) escritor:  vuelca a disco (o stdout) los bloques ya calculados
+ *    Las etapas se comunican con colas de ranuras; con 3 ranuras el lector,
+ *    el cómputo y el escritor trabajan a la vez sobre bloques distintos.
+ *  - Memoria acotada: ranuras x 3 x bloque x sizeof(T), sin importar N.
+ *  - Un bloque son "chunks_bloque" chunks: dentro de él se usa el mismo
+ *    schedule(static, chunk) que el resto del programa.
+ *  - Lector y escritor usan read/write bloqueantes en su propio hilo (no
+ *    io_uring: no depende de liburing y el solape es el mismo).
+ *  - Formato en stdin: por bloque, "bloque" valores de A y luego los mismos
+ *    de B; el último bloque puede ser más corto (m de A y m de B).
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>      // memcpy, strerror
+#include <deque>
+#include <exception>    // exception_ptr
+#include <mutex>
+#include <stdexcept>    // runtime_error
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>      // open
+#include <unistd.h>     // read, write, close
+#include <omp.h>
+
+#include "memoria.hpp"       // BufferAlineado
+#include "verificacion.hpp"  // sumaParalelaConChecksum, checksumReferencia
+
+// ===============================
+// Cola acotada de índices de ranura; cerrar despierta a quien espera
+// ===============================
+class ColaRanuras {
+public:
+    void pon(int r) {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            datos_.push_back(r);
+        }
+        cv_.notify_one();
+    }
+
+    // false si la cola está cerrada y vacía
+    bool saca(int &r, double &espera) {
+        const double t0 = omp_get_wtime();
+        std::unique_lock<std::mutex> lk(m_);
+        cv_.wait(lk, [&] { return !datos_.empty() || cerrada_; });
+        espera += omp_get_wtime() - t0;
+        if (datos_.empty()) return false;
+        r = datos_.front();
+        datos_.pop_front();
+        return true;
+    }
+
+    void cierra() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            cerrada_ = true;
+        }
+        cv_.notify_all();
+    }
+
+private:
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::deque<int> datos_;
+    bool cerrada_ = false;
+};
+
+// Lee hasta "bytes" (menos solo en fin de archivo). Lanza ante errores.
+inline std::size_t leeCompleto(int fd, void *destino, std::size_t bytes) {
+    std::size_t leidos = 0;
+    while (leidos < bytes) {
+        const ssize_t r = read(fd, static_cast<char *>(destino) + leidos, bytes - leidos);
+        if (r == 0) break;
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("error de lectura: ") + std::strerror(errno));
+        }
+        leidos += static_cast<std::size_t>(r);
+    }
+    return leidos;
+}
+
+inline void escribeCompleto(int fd, const void *origen, std::size_t bytes) {
+    std::size_t escritos = 0;
+    while (escritos < bytes) {
+        const ssize_t r = write(fd, static_cast<const char *>(origen) + escritos, bytes - escritos);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("error de escritura: ") + std::strerror(errno));
+        }
+        escritos += static_cast<std::size_t>(r);
+    }
+}
+
+// Descriptor que se cierra solo (no cierra stdin/stdout)
+class Descriptor {
+public:
+    Descriptor(const std::string &ruta, bool escritura) {
+        if (ruta == "-") {
+            fd_ = escritura ? STDOUT_FILENO : STDIN_FILENO;
+            propio_ = false;
+            return;
+        }
+        fd_ = escritura ? open(ruta.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)
+                        : open(ruta.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw std::runtime_error("no se pudo abrir '" + ruta + "': " + std::strerror(errno));
+        }
+    }
+    ~Descriptor() {
+        if (propio_ && fd_ >= 0) close(fd_);
+    }
+    Descriptor(const Descriptor &) = delete;
+    Descriptor &operator=(const Descriptor &) = delete;
+
+    int fd() const { return fd_; }
+
+private:
+    int fd_ = -1;
+    bool propio_ = true;
+};
+
+// Resultado de una corrida de la tubería
+struct ResultadoFlujo {
+    long long n = 0;              // Elementos procesados
+    long long bloques = 0;
+    double total = 0.0;           // s
+    double lector = 0.0;          // s ocupados en cada etapa
+    double computo = 0.0;
+    double escritor = 0.0;
+    double espera_computo = 0.0;  // s que el cómputo esperó al lector
+    std::uint64_t huella_c = 0;   // Huella de C (índice global)
+    std::uint64_t huella_ref = 0; // Huella de referencia desde A + B
+    std::size_t memoria = 0;      // Bytes de las ranuras
+};
+
+// ===============================
+// Corre la tubería. entrada_b vacía = A y B intercalados por bloque en
+// entrada_a (el caso de stdin, "-"). "salida" puede ser "-" (stdout).
+// ===============================
+template <typename T>
+ResultadoFlujo sumaEnFlujo(const std::string &entrada_a, const std::string &entrada_b,
+                           const std::string &salida, long long chunk, long long chunks_bloque,
+                           int ranuras, bool verifica) {
+    const long long bloque = chunk * chunks_bloque;
+    const bool intercalado = entrada_b.empty();
+    Descriptor fa(entrada_a, false);
+    Descriptor fb(intercalado ? "-" : entrada_b, false);   // Sin uso si es intercalado
+    Descriptor fc(salida, true);
+
+    struct Ranura {
+        BufferAlineado<T> a, b, c;
+        long long inicio = 0;
+        long long n = 0;
+    };
+    std::vector<Ranura> r(ranuras);
+    for (Ranura &x : r) {
+        x.a = BufferAlineado<T>(bloque);
+        x.b = BufferAlineado<T>(bloque);
+        x.c = BufferAlineado<T>(bloque);
+    }
+
+    ResultadoFlujo res;
+    res.memoria = static_cast<std::size_t>(ranuras) * 3 * bloque * sizeof(T);
+    ColaRanuras libres, llenas, listas;
+    for (int i = 0; i < ranuras; i++) libres.pon(i);
+    std::exception_ptr error_lector, error_escritor;
+
+    const double t0 = omp_get_wtime();
+
+    // (1) Lector
+    std::thread lector([&] {
+        double espera = 0.0;
+        try {
+            long long inicio = 0;
+            int i;
+            while (libres.saca(i, espera)) {
+                const double ti = omp_get_wtime();
+                Ranura &x = r[i];
+                const std::size_t bytes = bloque * sizeof(T);
+                std::size_t ga = leeCompleto(fa.fd(), x.a.data(), bytes);
+                long long m = static_cast<long long>(ga / sizeof(T));
+                if (intercalado) {
+                    // Un bloque final corto trae m de A y m de B seguidos: se
+                    // reparten los 2m valores leídos entre "a" y "b"
+                    const long long gb = ga == bytes
+                        ? static_cast<long long>(leeCompleto(fa.fd(), x.b.data(), bytes) / sizeof(T))
+                        : 0;
+                    const long long total = m + gb;
+                    if (total % 2 != 0) {
+                        throw std::runtime_error("bloque final de stdin con A y B de distinto largo");
+                    }
+                    m = total / 2;
+                    if (gb < bloque) {
+                        std::memmove(x.b.data() + (ga / sizeof(T) - m), x.b.data(), gb * sizeof(T));
+                        std::memcpy(x.b.data(), x.a.data() + m, (ga / sizeof(T) - m) * sizeof(T));
+                    }
+                } else {
+                    const std::size_t gb = leeCompleto(fb.fd(), x.b.data(), ga);
+                    m = static_cast<long long>(std::min(ga, gb) / sizeof(T));
+                }
+                res.lector += omp_get_wtime() - ti;
+                if (m == 0) break;
+                x.inicio = inicio;
+                x.n = m;
+                inicio += m;
+                llenas.pon(i);
+                if (m < bloque) break;
+            }
+        } catch (...) {
+            error_lector = std::current_exception();
+        }
+        llenas.cierra();
+    });
+
+    // (3) Escritor
+    std::thread escritor([&] {
+        double espera = 0.0;
+        try {
+            int i;
+            while (listas.saca(i, espera)) {
+                const double ti = omp_get_wtime();
+                escribeCompleto(fc.fd(), r[i].c.data(), r[i].n * sizeof(T));
+                res.escritor += omp_get_wtime() - ti;
+                libres.pon(i);
+            }
+        } catch (...) {
+            error_escritor = std::current_exception();
+            libres.cierra();   // El lector deja de esperar ranuras
+        }
+    });
+
+    // (2) Cómputo en el hilo llamador (el que tiene el equipo de OpenMP)
+    int i;
+    while (llenas.saca(i, res.espera_computo)) {
+        const double ti = omp_get_wtime();
+        Ranura &x = r[i];
+        res.huella_c += sumaParalelaConChecksum(x.a.data(), x.b.data(), x.c.data(), x.n, chunk, x.inicio);
+        if (verifica) {
+            res.huella_ref += checksumReferencia(x.a.data(), x.b.data(), x.n, chunk, x.inicio);
+        }
+        res.n += x.n;
+        res.bloques++;
+        res.computo += omp_get_wtime() - ti;
+        listas.pon(i);
+    }
+    listas.cierra();
+    escritor.join();
+    libres.cierra();
+    lector.join();
+    res.total = omp_get_wtime() - t0;
+
+    if (error_lector) std::rethrow_exception(error_lector);
+    if (error_escritor) std::rethrow_exception(error_escritor);
+    return res;
+}
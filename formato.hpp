@@ -0,0 +1,402 @@
+/******************************************************************************
+ * formato.hpp
+ * Descripción:
+ *  - Formato binario de resultados para consumo por otros procesos sin
+ *    parsear texto. Todo en little-endian:
+ *      cabecera (48 bytes):
+ *        0  "SUMARES1"            magia
+ *        8  u32 versión (1)
+ *        12 u8 tipo (índice en TIPOS), u8 sizeof(T), u8 compresión, u8 0
+ *        16 u64 N
+ *        24 u64 huella de C (mezclaElemento por índice, ver verificacion.hpp)
+ *        32 u64 elementos por bloque (0 sin compresión)
+ *        40 u64 número de bloques
+ *      sin compresión: N valores crudos
+ *      con compresión: u64 tamaño comprimido de cada bloque y luego los
+ *        bloques comprimidos uno tras otro
+ *  - La compresión (LZ4 o zstd) es opcional y por bloques de 1 MiB, en
+ *    paralelo con OpenMP; cada bloque es independiente, así que también se
+ *    descomprime en paralelo. Requiere compilar con -DSUMA_LZ4 -llz4 o
+ *    -DSUMA_ZSTD -lzstd.
+ *  - Los errores (E/S, cabecera inválida, huella distinta) lanzan
+ *    std::runtime_error.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+#include <cstdint>
+#include <cstring>      // memcpy
+#include <fstream>
+#include <stdexcept>    // runtime_error
+#include <string>
+#include <utility>      // swap
+#include <vector>
+
+#include "memoria.hpp"       // BufferAlineado
+#include "tipos.hpp"         // TIPOS, nombreTipo
+#include "verificacion.hpp"  // checksumArreglo
+
+#ifdef SUMA_LZ4
+#include <lz4.h>
+#endif
+#ifdef SUMA_ZSTD
+#include <zstd.h>
+#endif
+
+enum class Compresion : std::uint8_t { Ninguna = 0, LZ4 = 1, Zstd = 2 };
+
+inline const char *nombreCompresion(Compresion c) {
+    switch (c) {
+        case Compresion::LZ4: return "lz4";
+        case Compresion::Zstd: return "zstd";
+        default: return "ninguna";
+    }
+}
+
+inline Compresion compresionDesdeNombre(const std::string &nombre) {
+    if (nombre == "lz4") return Compresion::LZ4;
+    if (nombre == "zstd") return Compresion::Zstd;
+    return Compresion::Ninguna;
+}
+
+inline bool compresionDisponible(Compresion c) {
+    switch (c) {
+#ifdef SUMA_LZ4
+        case Compresion::LZ4: return true;
+#endif
+#ifdef SUMA_ZSTD
+        case Compresion::Zstd: return true;
+#endif
+        case Compresion::Ninguna: return true;
+        default: return false;
+    }
+}
+
+constexpr std::size_t BLOQUE_COMPRESION = 1u << 20;   // Bytes sin comprimir por bloque
+constexpr char MAGIA_RESULTADO[8] = {'S', 'U', 'M', 'A', 'R', 'E', 'S', '1'};
+
+constexpr bool HOST_LITTLE_ENDIAN = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+// ===============================
+// Cabecera en memoria (se serializa campo a campo en little-endian)
+// ===============================
+struct CabeceraResultado {
+    std::uint32_t version = 1;
+    std::uint8_t tipo = 0;
+    std::uint8_t tamano = 0;
+    Compresion compresion = Compresion::Ninguna;
+    std::uint64_t n = 0;
+    std::uint64_t huella = 0;
+    std::uint64_t por_bloque = 0;
+    std::uint64_t bloques = 0;
+};
+
+constexpr std::size_t BYTES_CABECERA = 48;
+
+template <typename T>
+std::uint8_t codigoTipo() {
+    for (std::size_t i = 0; i < sizeof(TIPOS) / sizeof(TIPOS[0]); i++) {
+        if (std::string(TIPOS[i]) == nombreTipo<T>()) return static_cast<std::uint8_t>(i);
+    }
+    return 0xFF;
+}
+
+// Escribe/lee "bytes" bytes de v en little-endian
+inline void ponLE(unsigned char *p, std::uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+
+inline std::uint64_t tomaLE(const unsigned char *p, int bytes) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+    return v;
+}
+
+// Invierte los bytes de cada elemento (solo hace falta en hosts big-endian)
+template <typename T>
+void invierteBytes(T *d, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) {
+        unsigned char b[sizeof(T)];
+        std::memcpy(b, &d[i], sizeof(T));
+        for (std::size_t j = 0; j < sizeof(T) / 2; j++) std::swap(b[j], b[sizeof(T) - 1 - j]);
+        std::memcpy(&d[i], b, sizeof(T));
+    }
+}
+
+inline void serializaCabecera(const CabeceraResultado &c, unsigned char *p) {
+    std::memset(p, 0, BYTES_CABECERA);
+    std::memcpy(p, MAGIA_RESULTADO, 8);
+    ponLE(p + 8, c.version, 4);
+    p[12] = c.tipo;
+    p[13] = c.tamano;
+    p[14] = static_cast<unsigned char>(c.compresion);
+    ponLE(p + 16, c.n, 8);
+    ponLE(p + 24, c.huella, 8);
+    ponLE(p + 32, c.por_bloque, 8);
+    ponLE(p + 40, c.bloques, 8);
+}
+
+inline CabeceraResultado deserializaCabecera(const unsigned char *p, const std::string &ruta) {
+    if (std::memcmp(p, MAGIA_RESULTADO, 8) != 0) {
+        throw std::runtime_error("'" + ruta + "' no es un archivo de resultados");
+    }
+    CabeceraResultado c;
+    c.version = static_cast<std::uint32_t>(tomaLE(p + 8, 4));
+    c.tipo = p[12];
+    c.tamano = p[13];
+    c.compresion = static_cast<Compresion>(p[14]);
+    c.n = tomaLE(p + 16, 8);
+    c.huella = tomaLE(p + 24, 8);
+    c.por_bloque = tomaLE(p + 32, 8);
+    c.bloques = tomaLE(p + 40, 8);
+    if (c.version != 1) throw std::runtime_error("version de formato no soportada en '" + ruta + "'");
+    return c;
+}
+
+// ===============================
+// Compresión de un bloque; "destino" se redimensiona al tamaño comprimido
+// ===============================
+inline void comprimeBloque(Compresion c, const char *origen, std::size_t bytes, std::vector<char> &destino) {
+    switch (c) {
+#ifdef SUMA_LZ4
+        case Compresion::LZ4: {
+            destino.resize(LZ4_compressBound(static_cast<int>(bytes)));
+            const int r = LZ4_compress_default(origen, destino.data(), static_cast<int>(bytes),
+                                               static_cast<int>(destino.size()));
+            if (r <= 0) throw std::runtime_error("LZ4_compress_default fallo");
+            destino.resize(r);
+            return;
+        }
+#endif
+#ifdef SUMA_ZSTD
+        case Compresion::Zstd: {
+            destino.resize(ZSTD_compressBound(bytes));
+            const std::size_t r = ZSTD_compress(destino.data(), destino.size(), origen, bytes, 1);
+            if (ZSTD_isError(r)) throw std::runtime_error(ZSTD_getErrorName(r));
+            destino.resize(r);
+            return;
+        }
+#endif
+        default:
+            (void)origen;
+            (void)bytes;
+            (void)destino;
+            throw std::runtime_error(std::string("compresion no disponible: ") + nombreCompresion(c));
+    }
+}
+
+inline void descomprimeBloque(Compresion c, const char *origen, std::size_t bytes, char *destino,
+                              std::size_t esperados) {
+    switch (c) {
+#ifdef SUMA_LZ4
+        case Compresion::LZ4: {
+            const int r = LZ4_decompress_safe(origen, destino, static_cast<int>(bytes),
+                                              static_cast<int>(esperados));
+            if (r < 0 || static_cast<std::size_t>(r) != esperados) {
+                throw std::runtime_error("bloque LZ4 corrupto");
+            }
+            return;
+        }
+#endif
+#ifdef SUMA_ZSTD
+        case Compresion::Zstd: {
+            const std::size_t r = ZSTD_decompress(destino, esperados, origen, bytes);
+            if (ZSTD_isError(r) || r != esperados) throw std::runtime_error("bloque zstd corrupto");
+            return;
+        }
+#endif
+        default:
+            (void)origen;
+            (void)bytes;
+            (void)destino;
+            (void)esperados;
+            throw std::runtime_error(std::string("compresion no disponible: ") + nombreCompresion(c));
+    }
+}
+
+// Resumen de una escritura
+struct ResumenEscritura {
+    std::uint64_t bytes_datos = 0;     // n * sizeof(T)
+    std::uint64_t bytes_archivo = 0;   // Cabecera + tabla + datos (comprimidos o no)
+};
+
+// ===============================
+// Escribe C en "ruta" con la cabecera. La huella se recalcula de C.
+// ===============================
+template <typename T>
+ResumenEscritura escribeResultado(const std::string &ruta, const T *C, long long n, long long chunk,
+                                  Compresion compresion) {
+    if (!compresionDisponible(compresion)) {
+        throw std::runtime_error(std::string("compresion ") + nombreCompresion(compresion) +
+                                 " no disponible (compilar con -DSUMA_LZ4 o -DSUMA_ZSTD)");
+    }
+    CabeceraResultado cab;
+    cab.tipo = codigoTipo<T>();
+    cab.tamano = sizeof(T);
+    cab.compresion = compresion;
+    cab.n = static_cast<std::uint64_t>(n);
+    cab.huella = checksumArreglo(C, n, chunk);
+
+    const std::size_t bytes = static_cast<std::size_t>(n) * sizeof(T);
+    const std::size_t por_bloque = BLOQUE_COMPRESION / sizeof(T);
+    const long long bloques = (n + por_bloque - 1) / por_bloque;
+    const bool comprime = compresion != Compresion::Ninguna;
+    if (comprime) {
+        cab.por_bloque = por_bloque;
+        cab.bloques = static_cast<std::uint64_t>(bloques);
+    }
+
+    std::ofstream out(ruta, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("no se pudo crear '" + ruta + "'");
+    unsigned char cabecera[BYTES_CABECERA];
+    serializaCabecera(cab, cabecera);
+    out.write(reinterpret_cast<const char *>(cabecera), BYTES_CABECERA);
+
+    ResumenEscritura res;
+    res.bytes_datos = bytes;
+    res.bytes_archivo = BYTES_CABECERA;
+
+    // Bloque "b" listo para escribir en little-endian (copia solo en big-endian)
+    auto datosBloque = [&](long long b, std::vector<T> &copia) -> const char * {
+        const long long i = b * static_cast<long long>(por_bloque);
+        const std::size_t m = static_cast<std::size_t>(std::min<long long>(por_bloque, n - i));
+        if (HOST_LITTLE_ENDIAN) return reinterpret_cast<const char *>(C + i);
+        copia.assign(C + i, C + i + m);
+        invierteBytes(copia.data(), m);
+        return reinterpret_cast<const char *>(copia.data());
+    };
+
+    if (!comprime) {
+        std::vector<T> copia;
+        for (long long b = 0; b < bloques; b++) {
+            const long long i = b * static_cast<long long>(por_bloque);
+            const std::size_t m = static_cast<std::size_t>(std::min<long long>(por_bloque, n - i));
+            out.write(datosBloque(b, copia), static_cast<std::streamsize>(m * sizeof(T)));
+        }
+        res.bytes_archivo += bytes;
+    } else {
+        // Cada bloque se comprime en su propio búfer, en paralelo
+        std::vector<std::vector<char>> comprimidos(bloques);
+        bool fallo = false;
+        std::string error;
+#pragma omp parallel for schedule(dynamic, 1)
+        for (long long b = 0; b < bloques; b++) {
+            std::vector<T> copia;
+            const long long i = b * static_cast<long long>(por_bloque);
+            const std::size_t m = static_cast<std::size_t>(std::min<long long>(por_bloque, n - i));
+            try {
+                comprimeBloque(compresion, datosBloque(b, copia), m * sizeof(T), comprimidos[b]);
+            } catch (const std::exception &e) {
+#pragma omp critical(error_compresion)
+                {
+                    fallo = true;
+                    error = e.what();
+                }
+            }
+        }
+        if (fallo) throw std::runtime_error(error);
+
+        std::vector<unsigned char> tabla(8 * bloques);
+        for (long long b = 0; b < bloques; b++) ponLE(tabla.data() + 8 * b, comprimidos[b].size(), 8);
+        out.write(reinterpret_cast<const char *>(tabla.data()), static_cast<std::streamsize>(tabla.size()));
+        res.bytes_archivo += tabla.size();
+        for (const std::vector<char> &c : comprimidos) {
+            out.write(c.data(), static_cast<std::streamsize>(c.size()));
+            res.bytes_archivo += c.size();
+        }
+    }
+    out.flush();
+    if (!out) throw std::runtime_error("error al escribir '" + ruta + "'");
+    return res;
+}
+
+// ===============================
+// Lee un archivo de resultados en "destino" y comprueba tipo y huella
+// ===============================
+template <typename T>
+CabeceraResultado leeResultado(const std::string &ruta, BufferAlineado<T> &destino, long long chunk) {
+    std::ifstream in(ruta, std::ios::binary);
+    if (!in) throw std::runtime_error("no se pudo abrir '" + ruta + "'");
+    unsigned char cabecera[BYTES_CABECERA];
+    if (!in.read(reinterpret_cast<char *>(cabecera), BYTES_CABECERA)) {
+        throw std::runtime_error("cabecera truncada en '" + ruta + "'");
+    }
+    const CabeceraResultado cab = deserializaCabecera(cabecera, ruta);
+    if (cab.tipo != codigoTipo<T>() || cab.tamano != sizeof(T)) {
+        throw std::runtime_error("'" + ruta + "' no contiene elementos " + nombreTipo<T>());
+    }
+
+    // Lo que queda del archivo acota todo lo que se reserva: una cabecera
+    // corrupta no puede pedir más memoria que la que el archivo justifica
+    in.seekg(0, std::ios::end);
+    const std::uint64_t restante = static_cast<std::uint64_t>(in.tellg()) - BYTES_CABECERA;
+    in.seekg(static_cast<std::streamoff>(BYTES_CABECERA), std::ios::beg);
+    const bool comprime = cab.compresion != Compresion::Ninguna;
+    if (!comprime && (cab.n != restante / sizeof(T) || restante % sizeof(T) != 0)) {
+        throw std::runtime_error("'" + ruta + "' declara " + std::to_string(cab.n) + " elementos y trae " +
+                                 std::to_string(restante / sizeof(T)));
+    }
+    std::vector<std::uint64_t> desde;
+    if (comprime) {
+        // Bloques de a lo más BLOQUE_COMPRESION bytes, ceil(n / por_bloque) de
+        // ellos, y cada uno ocupa al menos un byte después de la tabla
+        const std::uint64_t maximo = BLOQUE_COMPRESION / sizeof(T);
+        if (cab.por_bloque == 0 || cab.por_bloque > maximo ||
+            cab.bloques != cab.n / cab.por_bloque + (cab.n % cab.por_bloque != 0) ||
+            cab.bloques > restante / 9) {
+            throw std::runtime_error("tabla de bloques invalida en '" + ruta + "'");
+        }
+        std::vector<unsigned char> tabla(8 * cab.bloques);
+        if (!in.read(reinterpret_cast<char *>(tabla.data()), static_cast<std::streamsize>(tabla.size()))) {
+            throw std::runtime_error("tabla de bloques truncada en '" + ruta + "'");
+        }
+        const std::uint64_t datos = restante - tabla.size();
+        desde.assign(cab.bloques + 1, 0);
+        for (std::uint64_t b = 0; b < cab.bloques; b++) {
+            const std::uint64_t tam = tomaLE(tabla.data() + 8 * b, 8);
+            if (tam == 0 || tam > datos - desde[b]) {
+                throw std::runtime_error("tamano de bloque " + std::to_string(b) + " invalido en '" + ruta + "'");
+            }
+            desde[b + 1] = desde[b] + tam;
+        }
+    }
+
+    const long long n = static_cast<long long>(cab.n);
+    destino = BufferAlineado<T>(static_cast<std::size_t>(n));
+    T *C = destino.data();
+    if (!comprime) {
+        if (!in.read(reinterpret_cast<char *>(C), static_cast<std::streamsize>(n * sizeof(T)))) {
+            throw std::runtime_error("datos truncados en '" + ruta + "'");
+        }
+    } else {
+        const long long bloques = static_cast<long long>(cab.bloques);
+        std::vector<char> comprimido(desde[bloques]);
+        if (!in.read(comprimido.data(), static_cast<std::streamsize>(comprimido.size()))) {
+            throw std::runtime_error("datos comprimidos truncados en '" + ruta + "'");
+        }
+        bool fallo = false;
+        std::string error;
+#pragma omp parallel for schedule(dynamic, 1)
+        for (long long b = 0; b < bloques; b++) {
+            const long long i = b * static_cast<long long>(cab.por_bloque);
+            const std::size_t m = static_cast<std::size_t>(std::min<long long>(cab.por_bloque, n - i));
+            try {
+                descomprimeBloque(cab.compresion, comprimido.data() + desde[b], desde[b + 1] - desde[b],
+                                  reinterpret_cast<char *>(C + i), m * sizeof(T));
+            } catch (const std::exception &e) {
+#pragma omp critical(error_compresion)
+                {
+                    fallo = true;
+                    error = e.what();
+                }
+            }
+        }
+        if (fallo) throw std::runtime_error(error);
+    }
+    if (!HOST_LITTLE_ENDIAN) invierteBytes(C, static_cast<std::size_t>(n));
+    if (checksumArreglo(C, n, chunk) != cab.huella) {
+        throw std::runtime_error("la huella de '" + ruta + "' no coincide con sus datos");
+    }
+    return cab;
+}
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * incremental.hpp
+ * Descripción:
+ *  - Recálculo incremental de C = A + B cuando entre dos ejecuciones solo
+ *    cambió una parte de A o de B: quien escribe avisa el rango que tocó y
+ *    la siguiente actualiza() recalcula solo los chunks de C afectados.
+ *  - La granularidad es la de schedule(static, chunk): el chunk k cubre
+ *    [k*chunk, (k+1)*chunk) y lo recalcula el hilo k mod hilos, el mismo
+ *    que lo escribió la primera vez (mismo primer toque NUMA).
+ *  - La huella de verificacion.hpp es una suma por posición, así que se
+ *    guarda la contribución de cada chunk: al recalcular uno se resta la
+ *    vieja y se suma la nueva, sin releer el resto de C.
+ *  - Por encima de "umbral" (fracción de chunks sucios) se recalcula todo
+ *    de corrido: una pasada contigua sin saltos le conviene más al
+ *    prefetcher que muchos tramos sueltos.
+ *  - Los registros no son seguros entre hilos: marca() la llama el hilo
+ *    que modificó A o B, antes de actualiza().
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // fill, max, min
+#include <cstdint>
+#include <vector>
+
+#include "verificacion.hpp"  // mezclaElemento
+
+// ===============================
+// Chunks sucios de un arreglo de n elementos (un byte por chunk)
+// ===============================
+class RegistroSucio {
+public:
+    RegistroSucio(long long n, long long chunk)
+        : n_(n), chunk_(chunk > 0 ? chunk : 1), sucio_((n + chunk_ - 1) / chunk_, 0) {}
+
+    // Se modificaron los elementos [inicio, fin)
+    void marca(long long inicio, long long fin) {
+        inicio = std::max(0LL, inicio);
+        fin = std::min(n_, fin);
+        if (inicio >= fin) return;
+        for (long long k = inicio / chunk_; k <= (fin - 1) / chunk_; k++) {
+            if (!sucio_[k]) {
+                sucio_[k] = 1;
+                sucios_++;
+            }
+        }
+    }
+    void marcaTodo() { marca(0, n_); }
+    void limpia() {
+        std::fill(sucio_.begin(), sucio_.end(), 0);
+        sucios_ = 0;
+    }
+
+    bool sucio(long long k) const { return sucio_[k] != 0; }
+    long long chunks() const { return static_cast<long long>(sucio_.size()); }
+    long long sucios() const { return sucios_; }
+    long long chunk() const { return chunk_; }
+
+private:
+    long long n_;
+    long long chunk_;
+    std::vector<unsigned char> sucio_;
+    long long sucios_ = 0;
+};
+
+// Qué hizo una llamada a actualiza()
+struct ResultadoIncremental {
+    long long chunks = 0;         // Chunks de C
+    long long recalculados = 0;   // Chunks escritos en esta llamada
+    bool completo = false;        // Se superó el umbral: recálculo completo
+    double fraccion = 0.0;        // Fracción de chunks sucios antes de actualizar
+};
+
+// ===============================
+// C = A + B sobre arreglos del que llama, con huella por chunk
+// ===============================
+template <typename T>
+class SumaIncremental {
+public:
+    // La primera actualiza() calcula todo C
+    SumaIncremental(const T *A, const T *B, T *C, long long n, long long chunk, double umbral)
+        : A_(A), B_(B), C_(C), n_(n), umbral_(umbral), sucioA_(n, chunk), sucioB_(n, chunk),
+          huellas_(sucioA_.chunks(), 0) {
+        sucioA_.marcaTodo();
+    }
+
+    // Avisos de escritura: rangos [inicio, fin) de A o B que cambiaron
+    void cambioA(long long inicio, long long fin) { sucioA_.marca(inicio, fin); }
+    void cambioB(long long inicio, long long fin) { sucioB_.marca(inicio, fin); }
+
+    // Fracción de chunks de C que hay que recalcular (unión de A y B)
+    double fraccionSucia() const {
+        const long long chunks = sucioA_.chunks();
+        if (chunks == 0) return 0.0;
+        long long sucios = 0;
+        for (long long k = 0; k < chunks; k++) {
+            if (sucioA_.sucio(k) || sucioB_.sucio(k)) sucios++;
+        }
+        return static_cast<double>(sucios) / chunks;
+    }
+
+    // Deja C y la huella al día con A y B
+    ResultadoIncremental actualiza() {
+        ResultadoIncremental r;
+        r.chunks = sucioA_.chunks();
+        r.fraccion = fraccionSucia();
+        r.completo = r.fraccion > umbral_;
+        r.recalculados = recalcula(r.completo);
+        sucioA_.limpia();
+        sucioB_.limpia();
+        return r;
+    }
+
+    std::uint64_t huella() const { return huella_; }
+    double umbral() const { return umbral_; }
+    long long chunk() const { return sucioA_.chunk(); }
+
+private:
+    // Recalcula los chunks sucios (o todos) y devuelve cuántos escribió.
+    // schedule(static, 1) sobre chunks = schedule(static, chunk) sobre índices.
+    long long recalcula(bool todos) {
+        const long long chunks = sucioA_.chunks();
+        const long long chunk = sucioA_.chunk();
+        std::uint64_t delta = 0;
+        long long escritos = 0;
+#pragma omp parallel for schedule(static, 1) reduction(+ : delta, escritos)
+        for (long long k = 0; k < chunks; k++) {
+            if (!todos && !sucioA_.sucio(k) && !sucioB_.sucio(k)) continue;
+            const long long fin = std::min(n_, (k + 1) * chunk);
+            std::uint64_t h = 0;
+#pragma omp simd reduction(+ : h)
+            for (long long i = k * chunk; i < fin; i++) {
+                const T c = static_cast<T>(A_[i] + B_[i]);
+                C_[i] = c;
+                h += mezclaElemento(i, c);
+            }
+            delta += h - huellas_[k];   // mod 2^64, como la huella
+            huellas_[k] = h;
+            escritos++;
+        }
+        huella_ += delta;
+        return escritos;
+    }
+
+    const T *A_;
+    const T *B_;
+    T *C_;
+    long long n_;
+    double umbral_;
+    RegistroSucio sucioA_, sucioB_;
+    std::vector<std::uint64_t> huellas_;   // Contribución de cada chunk a huella_
+    std::uint64_t huella_ = 0;
+};
@@ -0,0 +1,539 @@
+/******************************************************************************
+ * informe.hpp
+ * Descripción:
+ *  - Resultados legibles por máquina para seguir el rendimiento en el
+ *    tiempo: configuración, datos de la máquina, tiempos de cada repetición
+ *    de cada núcleo y, con --contadores, los contadores de hardware.
+ *  - --informe=<ruta> los guarda en JSON, o en CSV si la ruta termina en
+ *    .csv (formato largo: una fila por repetición o contador, con la
+ *    configuración y la máquina en líneas de comentario "#").
+ *  - comparaInformes: carga un informe base y uno actual (cualquiera de los
+ *    dos formatos) y, por núcleo, tipo, N e hilos, aplica la prueba U de
+ *    Mann-Whitney a los tiempos. Es una regresión si el actual es más lento
+ *    con p < alfa y la mediana empeora más que la tolerancia: la prueba
+ *    sola marcaría diferencias de 0.1% con muchas repeticiones, y la
+ *    tolerancia sola confundiría ruido con regresiones.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // sort
+#include <cctype>       // isspace, isxdigit
+#include <cerrno>       // errno, ERANGE
+#include <climits>      // INT_MAX
+#include <cmath>        // erfc, sqrt
+#include <cstdio>       // snprintf
+#include <cstdlib>      // strtol, strtoll, strtod
+#include <ctime>        // time, gmtime_r, strftime
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>    // runtime_error
+#include <string>
+#include <thread>       // hardware_concurrency
+#include <utility>      // pair
+#include <vector>
+
+#include <sys/utsname.h>  // uname
+#include <unistd.h>       // gethostname
+#include <omp.h>
+
+#include "benchmark.hpp"      // mideKernel, calculaEstadisticas
+#include "configuracion.hpp"  // Configuracion
+#include "contadores.hpp"     // LecturaContadores, nombreEvento
+#include "particion.hpp"      // lineaCache, tamanoPagina
+#include "streaming.hpp"      // tamanoLLC
+#include "teselas.hpp"        // tamanoL2
+
+// Una medición: un núcleo con un tipo, una N y un número de hilos
+struct MedicionInforme {
+    std::string kernel;
+    std::string tipo;
+    long long n = 0;
+    int hilos = 1;
+    double bytes = 0.0;                   // Bytes por ejecución (como STREAM)
+    std::vector<double> ms;               // Una por repetición
+    std::vector<std::pair<std::string, double>> contadores;  // Por ejecución, de la pasada con contadores
+};
+
+inline std::string escapaJson(const std::string &s) {
+    std::string r;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            r += '\\';
+            r += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char u[8];
+            std::snprintf(u, sizeof(u), "\\u%04x", c);
+            r += u;
+        } else {
+            r += c;
+        }
+    }
+    return r;
+}
+
+// 9 cifras significativas: de sobra para tiempos de steady_clock en ms
+inline std::string numeroInforme(double x) {
+    char b[32];
+    std::snprintf(b, sizeof(b), "%.9g", x);
+    return b;
+}
+
+// ===============================
+// Datos de la máquina y del compilador
+// ===============================
+inline std::vector<std::pair<std::string, std::string>> datosMaquina(const std::string &simd) {
+    std::vector<std::pair<std::string, std::string>> d;
+    std::string cpu = "desconocida";
+    std::ifstream info("/proc/cpuinfo");
+    for (std::string linea; std::getline(info, linea);) {
+        if (linea.rfind("model name", 0) == 0 && linea.find(':') != std::string::npos) {
+            cpu = linea.substr(linea.find(':') + 2);
+            break;
+        }
+    }
+    char host[256] = "desconocido";
+    gethostname(host, sizeof(host) - 1);
+    utsname u{};
+    uname(&u);
+    d.push_back({"cpu", cpu});
+    d.push_back({"host", host});
+    d.push_back({"sistema", std::string(u.sysname) + " " + u.release + " " + u.machine});
+    d.push_back({"hilos_logicos", std::to_string(std::thread::hardware_concurrency())});
+    d.push_back({"hilos_openmp", std::to_string(omp_get_max_threads())});
+    d.push_back({"llc_bytes", std::to_string(tamanoLLC())});
+    d.push_back({"l2_bytes", std::to_string(tamanoL2())});
+    d.push_back({"linea_bytes", std::to_string(lineaCache())});
+    d.push_back({"pagina_bytes", std::to_string(tamanoPagina())});
+    d.push_back({"simd", simd});
+#if defined(__clang__)
+    d.push_back({"compilador", std::string("clang ") + __clang_version__});
+#elif defined(__GNUC__)
+    d.push_back({"compilador", std::string("gcc ") + __VERSION__});
+#else
+    d.push_back({"compilador", "desconocido"});
+#endif
+    d.push_back({"openmp", std::to_string(_OPENMP)});
+    return d;
+}
+
+// Opciones que cambian lo que se mide
+inline std::vector<std::pair<std::string, std::string>> datosConfiguracion(const Configuracion &cfg) {
+    std::string barrido;
+    for (long long n : cfg.barrido_n) barrido += (barrido.empty() ? "" : ",") + std::to_string(n);
+    return {{"modo", cfg.modo},
+            {"n", std::to_string(cfg.n)},
+            {"chunk", std::to_string(cfg.chunk)},
+            {"hilos", std::to_string(cfg.hilos)},
+            {"tipo", cfg.tipo},
+            {"schedule", cfg.schedule},
+            {"verificacion", cfg.verificacion},
+            {"semilla", std::to_string(cfg.semilla)},
+            {"calentamiento", std::to_string(cfg.calentamiento)},
+            {"repeticiones", std::to_string(cfg.repeticiones)},
+            {"hugepages", cfg.paginas_grandes ? "1" : "0"},
+            {"stream", cfg.stream},
+            {"primer_toque", cfg.primer_toque ? "1" : "0"},
+            {"afinidad", cfg.afinidad},
+            {"lugares", cfg.lugares},
+            {"alinear", cfg.alinear},
+            {"barrido_n", barrido}};
+}
+
+// ===============================
+// Informe de una ejecución
+// ===============================
+class Informe {
+public:
+    Informe(const Configuracion &cfg, std::string tipo, const std::string &simd)
+        : tipo_(std::move(tipo)), configuracion_(datosConfiguracion(cfg)), maquina_(datosMaquina(simd)) {
+        char fecha[32];
+        const std::time_t ahora = std::time(nullptr);
+        std::tm t{};
+        gmtime_r(&ahora, &t);
+        std::strftime(fecha, sizeof(fecha), "%Y-%m-%dT%H:%M:%SZ", &t);
+        fecha_ = fecha;
+    }
+
+    // Como mide() de benchmark.hpp, guardando cada repetición
+    template <typename Kernel>
+    Estadisticas mide(const std::string &kernel, long long n, int hilos, double bytes, Kernel &&k,
+                      int calentamiento, int repeticiones) {
+        MedicionInforme m;
+        m.kernel = kernel;
+        m.tipo = tipo_;
+        m.n = n;
+        m.hilos = hilos;
+        m.bytes = bytes;
+        m.ms = mideKernel(k, calentamiento, repeticiones);
+        mediciones_.push_back(m);
+        return calculaEstadisticas(m.ms);
+    }
+
+    // Contadores del núcleo (se agregan a su última medición)
+    void agregaContadores(const std::string &kernel, const LecturaContadores &l, int repeticiones) {
+        for (auto m = mediciones_.rbegin(); m != mediciones_.rend(); ++m) {
+            if (m->kernel != kernel) continue;
+            for (int e = 0; e < NUM_EVENTOS; e++) {
+                if (l.hay(e)) m->contadores.push_back({nombreEvento(e), l.v[e] / repeticiones});
+            }
+            return;
+        }
+    }
+
+    std::size_t mediciones() const { return mediciones_.size(); }
+
+    // JSON, o CSV si la ruta termina en .csv
+    void escribe(const std::string &ruta) const {
+        std::ofstream f(ruta);
+        if (!f) throw std::runtime_error("no se pudo abrir el informe " + ruta);
+        const bool csv = ruta.size() >= 4 && ruta.compare(ruta.size() - 4, 4, ".csv") == 0;
+        if (csv) escribeCsv(f);
+        else escribeJson(f);
+        if (!f) throw std::runtime_error("error al escribir el informe " + ruta);
+    }
+
+private:
+    void escribeJson(std::ostream &f) const {
+        auto objeto = [&](const std::vector<std::pair<std::string, std::string>> &pares) {
+            f << "{";
+            for (std::size_t k = 0; k < pares.size(); k++) {
+                f << (k ? ", " : "") << "\"" << escapaJson(pares[k].first) << "\": \""
+                  << escapaJson(pares[k].second) << "\"";
+            }
+            f << "}";
+        };
+        f << "{\n  \"formato\": \"suma_arreglos/1\",\n  \"fecha\": \"" << fecha_ << "\",\n";
+        f << "  \"configuracion\": ";
+        objeto(configuracion_);
+        f << ",\n  \"maquina\": ";
+        objeto(maquina_);
+        f << ",\n  \"mediciones\": [";
+        for (std::size_t j = 0; j < mediciones_.size(); j++) {
+            const MedicionInforme &m = mediciones_[j];
+            const Estadisticas e = calculaEstadisticas(m.ms);
+            f << (j ? "," : "") << "\n    {\"kernel\": \"" << escapaJson(m.kernel) << "\", \"tipo\": \""
+              << m.tipo << "\", \"n\": " << m.n << ", \"hilos\": " << m.hilos << ", \"bytes\": "
+              << numeroInforme(m.bytes) << ", \"mediana_ms\": " << numeroInforme(e.mediana) << ", \"ms\": [";
+            for (std::size_t r = 0; r < m.ms.size(); r++) f << (r ? ", " : "") << numeroInforme(m.ms[r]);
+            f << "]";
+            if (!m.contadores.empty()) {
+                f << ", \"contadores\": {";
+                for (std::size_t c = 0; c < m.contadores.size(); c++) {
+                    f << (c ? ", " : "") << "\"" << m.contadores[c].first << "\": "
+                      << numeroInforme(m.contadores[c].second);
+                }
+                f << "}";
+            }
+            f << "}";
+        }
+        f << "\n  ]\n}\n";
+    }
+
+    // Formato largo: medida "ms" con su repetición o el nombre del contador
+    void escribeCsv(std::ostream &f) const {
+        f << "# formato=suma_arreglos/1\n# fecha=" << fecha_ << "\n";
+        for (const auto &p : configuracion_) f << "# configuracion." << p.first << "=" << p.second << "\n";
+        for (const auto &p : maquina_) f << "# maquina." << p.first << "=" << p.second << "\n";
+        f << "kernel,tipo,n,hilos,bytes,medida,repeticion,valor\n";
+        for (const MedicionInforme &m : mediciones_) {
+            const std::string clave = m.kernel + "," + m.tipo + "," + std::to_string(m.n) + "," +
+                                      std::to_string(m.hilos) + "," + numeroInforme(m.bytes) + ",";
+            for (std::size_t r = 0; r < m.ms.size(); r++) {
+                f << clave << "ms," << r << "," << numeroInforme(m.ms[r]) << "\n";
+            }
+            for (const auto &c : m.contadores) {
+                f << clave << c.first << ",," << numeroInforme(c.second) << "\n";
+            }
+        }
+    }
+
+    std::string tipo_;
+    std::string fecha_;
+    std::vector<std::pair<std::string, std::string>> configuracion_;
+    std::vector<std::pair<std::string, std::string>> maquina_;
+    std::vector<MedicionInforme> mediciones_;
+};
+
+// Modos que llenan un Informe; los demás rechazan --informe
+inline constexpr const char *MODOS_CON_INFORME[] = {"basico", "barrido", "simd", "adaptativo", "fijo"};
+
+inline bool modoConInforme(const std::string &modo) {
+    for (const char *m : MODOS_CON_INFORME) {
+        if (modo == m) return true;
+    }
+    return false;
+}
+
+inline std::string listaModosConInforme() {
+    std::string lista;
+    for (const char *m : MODOS_CON_INFORME) lista += (lista.empty() ? "" : ", ") + std::string(m);
+    return lista;
+}
+
+// ===============================
+// Lectura de un informe (JSON o CSV) para comparar: solo los tiempos
+// ===============================
+
+// Lector JSON mínimo: lo justo para los informes de arriba
+class LectorJson {
+public:
+    explicit LectorJson(const std::string &texto) : s_(texto) {}
+
+    std::vector<MedicionInforme> mediciones() {
+        std::vector<MedicionInforme> r;
+        espera('{');
+        while (!consume('}')) {
+            const std::string clave = cadena();
+            espera(':');
+            if (clave == "mediciones") {
+                espera('[');
+                while (!consume(']')) {
+                    r.push_back(medicion());
+                    consume(',');
+                }
+            } else {
+                salta();
+            }
+            consume(',');
+        }
+        return r;
+    }
+
+private:
+    MedicionInforme medicion() {
+        MedicionInforme m;
+        espera('{');
+        while (!consume('}')) {
+            const std::string clave = cadena();
+            espera(':');
+            if (clave == "kernel") m.kernel = cadena();
+            else if (clave == "tipo") m.tipo = cadena();
+            else if (clave == "n") m.n = static_cast<long long>(numero());
+            else if (clave == "hilos") m.hilos = static_cast<int>(numero());
+            else if (clave == "bytes") m.bytes = numero();
+            else if (clave == "ms") {
+                espera('[');
+                while (!consume(']')) {
+                    m.ms.push_back(numero());
+                    consume(',');
+                }
+            } else {
+                salta();
+            }
+            consume(',');
+        }
+        return m;
+    }
+
+    void blancos() {
+        while (p_ < s_.size() && std::isspace(static_cast<unsigned char>(s_[p_]))) p_++;
+    }
+    bool consume(char c) {
+        blancos();
+        if (p_ < s_.size() && s_[p_] == c) {
+            p_++;
+            return true;
+        }
+        return false;
+    }
+    void espera(char c) {
+        if (!consume(c)) error(std::string("se esperaba '") + c + "'");
+    }
+    [[noreturn]] void error(const std::string &que) const {
+        throw std::runtime_error("informe JSON invalido (byte " + std::to_string(p_) + "): " + que);
+    }
+    std::string cadena() {
+        espera('"');
+        std::string r;
+        while (p_ < s_.size() && s_[p_] != '"') {
+            if (s_[p_] == '\\' && p_ + 1 < s_.size()) {
+                p_++;
+                if (s_[p_] == 'u') {   // Solo los \u00XX que escribe escapaJson
+                    const std::string hex = s_.substr(p_ + 1, 4);
+                    char *fin = nullptr;
+                    const long v = std::strtol(hex.c_str(), &fin, 16);
+                    bool valido = hex.size() == 4 && *fin == '\0' && v <= 0xFF;
+                    for (char h : hex) valido = valido && std::isxdigit(static_cast<unsigned char>(h));
+                    if (!valido) error("escape \\u invalido");
+                    r += static_cast<char>(v);
+                    p_ += 4;
+                } else {
+                    r += s_[p_] == 'n' ? '\n' : s_[p_] == 't' ? '\t' : s_[p_];
+                }
+            } else {
+                r += s_[p_];
+            }
+            p_++;
+        }
+        espera('"');
+        return r;
+    }
+    double numero() {
+        blancos();
+        const char *inicio = s_.c_str() + p_;
+        char *fin = nullptr;
+        const double v = std::strtod(inicio, &fin);
+        if (fin == inicio) error("se esperaba un numero");
+        p_ += static_cast<std::size_t>(fin - inicio);
+        return v;
+    }
+    // Cualquier valor que no interesa
+    void salta() {
+        blancos();
+        if (p_ >= s_.size()) error("fin inesperado");
+        const char c = s_[p_];
+        if (c == '"') {
+            cadena();
+        } else if (c == '{' || c == '[') {
+            const char cierre = c == '{' ? '}' : ']';
+            p_++;
+            while (!consume(cierre)) {
+                if (c == '{') {
+                    cadena();
+                    espera(':');
+                }
+                salta();
+                consume(',');
+            }
+        } else if (s_.compare(p_, 4, "true") == 0 || s_.compare(p_, 4, "null") == 0) {
+            p_ += 4;
+        } else if (s_.compare(p_, 5, "false") == 0) {
+            p_ += 5;
+        } else {
+            numero();
+        }
+    }
+
+    const std::string &s_;
+    std::size_t p_ = 0;
+};
+
+// Campos numéricos de una fila CSV: el texto entero tiene que ser el número
+inline long long campoEnteroCsv(const std::string &x, const std::string &ruta, const std::string &linea) {
+    char *fin = nullptr;
+    errno = 0;
+    const long long v = std::strtoll(x.c_str(), &fin, 10);
+    if (x.empty() || *fin != '\0' || errno == ERANGE) {
+        throw std::runtime_error("fila CSV invalida en " + ruta + ": " + linea);
+    }
+    return v;
+}
+
+inline double campoRealCsv(const std::string &x, const std::string &ruta, const std::string &linea) {
+    char *fin = nullptr;
+    const double v = std::strtod(x.c_str(), &fin);
+    if (x.empty() || *fin != '\0') throw std::runtime_error("fila CSV invalida en " + ruta + ": " + linea);
+    return v;
+}
+
+inline std::vector<MedicionInforme> leeInforme(const std::string &ruta) {
+    std::ifstream f(ruta);
+    if (!f) throw std::runtime_error("no se pudo abrir el informe " + ruta);
+    std::stringstream contenido;
+    contenido << f.rdbuf();
+    const std::string texto = contenido.str();
+    const bool csv = ruta.size() >= 4 && ruta.compare(ruta.size() - 4, 4, ".csv") == 0;
+    if (!csv) return LectorJson(texto).mediciones();
+
+    // CSV: se agrupan las filas "ms" por kernel, tipo, n e hilos
+    std::vector<MedicionInforme> r;
+    std::map<std::string, std::size_t> indice;
+    std::istringstream lineas(texto);
+    bool encabezado = true;
+    for (std::string linea; std::getline(lineas, linea);) {
+        if (linea.empty() || linea[0] == '#') continue;
+        if (encabezado) {
+            encabezado = false;
+            continue;
+        }
+        std::vector<std::string> c;
+        std::istringstream campos(linea);
+        for (std::string x; std::getline(campos, x, ',');) c.push_back(x);
+        if (c.size() < 8) throw std::runtime_error("fila CSV invalida en " + ruta + ": " + linea);
+        if (c[5] != "ms") continue;
+        const std::string clave = c[0] + "," + c[1] + "," + c[2] + "," + c[3];
+        auto it = indice.find(clave);
+        if (it == indice.end()) {
+            MedicionInforme m;
+            m.kernel = c[0];
+            m.tipo = c[1];
+            m.n = campoEnteroCsv(c[2], ruta, linea);
+            const long long hilos = campoEnteroCsv(c[3], ruta, linea);
+            if (hilos < 0 || hilos > INT_MAX) throw std::runtime_error("fila CSV invalida en " + ruta + ": " + linea);
+            m.hilos = static_cast<int>(hilos);
+            m.bytes = campoRealCsv(c[4], ruta, linea);
+            it = indice.emplace(clave, r.size()).first;
+            r.push_back(m);
+        }
+        r[it->second].ms.push_back(campoRealCsv(c[7], ruta, linea));
+    }
+    return r;
+}
+
+// ===============================
+// Prueba U de Mann-Whitney (aproximación normal con corrección por empates
+// y de continuidad). Devuelve la p de una cola de "y tiende a ser mayor que x".
+// ===============================
+inline double pMannWhitneyMayor(const std::vector<double> &x, const std::vector<double> &y) {
+    const std::size_t nx = x.size(), ny = y.size(), n = nx + ny;
+    if (nx == 0 || ny == 0) return 1.0;
+    std::vector<std::pair<double, int>> todos;
+    for (double v : x) todos.push_back({v, 0});
+    for (double v : y) todos.push_back({v, 1});
+    std::sort(todos.begin(), todos.end());
+    double rangos_y = 0.0, empates = 0.0;
+    for (std::size_t i = 0; i < n;) {
+        std::size_t j = i;
+        while (j < n && todos[j].first == todos[i].first) j++;
+        const double rango = 0.5 * (i + 1 + j);   // Rango medio del grupo empatado
+        for (std::size_t k = i; k < j; k++) {
+            if (todos[k].second == 1) rangos_y += rango;
+        }
+        const double t = static_cast<double>(j - i);
+        empates += t * t * t - t;
+        i = j;
+    }
+    const double u = rangos_y - ny * (ny + 1) / 2.0;
+    const double media = nx * ny / 2.0;
+    const double varianza = nx * ny / 12.0 * ((n + 1) - empates / (static_cast<double>(n) * (n - 1)));
+    if (varianza <= 0.0) return 1.0;
+    const double z = (u - media - 0.5) / std::sqrt(varianza);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+// Veredicto de una medición presente en los dos informes
+struct ComparacionKernel {
+    const MedicionInforme *base;
+    const MedicionInforme *actual;
+    double mediana_base = 0.0;
+    double mediana_actual = 0.0;
+    double cambio = 0.0;      // (actual - base) / base
+    double p_lento = 1.0;     // Actual más lento
+    double p_rapido = 1.0;    // Actual más rápido
+    bool regresion = false;
+    bool mejora = false;
+};
+
+inline std::vector<ComparacionKernel> comparaInformes(const std::vector<MedicionInforme> &base,
+                                                      const std::vector<MedicionInforme> &actual,
+                                                      double alfa, double tolerancia) {
+    std::vector<ComparacionKernel> r;
+    for (const MedicionInforme &a : actual) {
+        for (const MedicionInforme &b : base) {
+            if (a.kernel != b.kernel || a.tipo != b.tipo || a.n != b.n || a.hilos != b.hilos) continue;
+            ComparacionKernel c{&b, &a};
+            c.mediana_base = calculaEstadisticas(b.ms).mediana;
+            c.mediana_actual = calculaEstadisticas(a.ms).mediana;
+            c.cambio = c.mediana_base > 0.0 ? (c.mediana_actual - c.mediana_base) / c.mediana_base : 0.0;
+            c.p_lento = pMannWhitneyMayor(b.ms, a.ms);
+            c.p_rapido = pMannWhitneyMayor(a.ms, b.ms);
+            c.regresion = c.p_lento < alfa && c.cambio > tolerancia;
+            c.mejora = c.p_rapido < alfa && c.cambio < -tolerancia;
+            r.push_back(c);
+            break;
+        }
+    }
+    return r;
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * kernels.hpp
+ * Descripción:
+ *  - Núcleos de cómputo C = A + B usados por main.cpp y por el arnés de
+ *    medición (benchmark.hpp), plantillas sobre el tipo de elemento T
+ *    (int8/16/32/64, float, double; ver tipos.hpp):
+ *      (1) sumaSecuencial: un solo hilo
+ *      (2) sumaParalela: #pragma omp parallel for con schedule(static, chunk)
+ *      (3) sumaSinVectorizar: escalar puro, referencia para medir la
+ *          vectorización automática del compilador
+ *      (4) sumaOmpSimd: vectorización pedida con #pragma omp simd
+ *      (5) sumaParalelaCon: reparte bloques de "chunk" entre hilos y aplica
+ *          a cada uno cualquier núcleo secuencial (p. ej. los de simd.hpp)
+ *  - Cada instanciación es el mismo bucle que la versión int original: el
+ *    tipo se fija en compilación y no hay despacho dentro del bucle.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+
+#include "traza.hpp"    // SUMA_TRAZA_TRAMO (sin -DSUMA_TRAZA no genera código)
+
+// Firma común de los núcleos secuenciales: C[0..n) = A[0..n) + B[0..n)
+template <typename T>
+using FuncionSumaT = void (*)(const T *A, const T *B, T *C, long long n);
+
+// ===============================
+// SUMA SECUENCIAL (baseline)
+//  - Cada iteración depende solo de A[i] y B[i]
+//  - No hay paralelismo, corre en un solo hilo
+// ===============================
+template <typename T>
+void sumaSecuencial(const T *A, const T *B, T *C, long long n) {
+    SUMA_TRAZA_TRAMO("secuencial", -1);
+    for (long long i = 0; i < n; i++) {
+        C[i] = static_cast<T>(A[i] + B[i]);
+    }
+}
+
+// ===============================
+// SUMA PARALELA CON OPENMP
+//  - shared(): arreglos compartidos entre hilos.
+//  - La variable del for es privada por hilo (evita condiciones de carrera).
+//  - schedule(static, chunk): reparte el trabajo en bloques fijos de "chunk" iteraciones.
+// ===============================
+template <typename T>
+void sumaParalela(const T *A, const T *B, T *C, long long n, long long chunk) {
+#pragma omp parallel shared(A, B, C)
+    {
+        SUMA_TRAZA_TRAMO("suma", -1);
+#ifdef SUMA_TRAZA
+        // Por bloques para el tramo de cada uno (ver traza.hpp)
+        const long long bloques = (n + chunk - 1) / chunk;
+#pragma omp for schedule(static, 1) nowait
+        for (long long b = 0; b < bloques; b++) {
+            SUMA_TRAZA_TRAMO("suma", b);
+            const long long fin = std::min(n, (b + 1) * chunk);
+            for (long long i = b * chunk; i < fin; i++) {
+                C[i] = static_cast<T>(A[i] + B[i]);
+            }
+        }
+#else
+#pragma omp for schedule(static, chunk) nowait
+        for (long long i = 0; i < n; i++) {
+            // Cada hilo escribe en una posición distinta C[i], por lo que es seguro
+            C[i] = static_cast<T>(A[i] + B[i]);
+        }
+#endif
+    }
+}
+
+// ===============================
+// Escalar sin vectorizar: desactiva el vectorizador solo en esta función
+// ===============================
+#if defined(__clang__)
+template <typename T>
+void sumaSinVectorizar(const T *A, const T *B, T *C, long long n) {
+#pragma clang loop vectorize(disable) interleave(disable)
+    for (long long i = 0; i < n; i++) {
+        C[i] = static_cast<T>(A[i] + B[i]);
+    }
+}
+#elif defined(__GNUC__)
+template <typename T>
+__attribute__((optimize("no-tree-vectorize")))
+void sumaSinVectorizar(const T *A, const T *B, T *C, long long n) {
+    for (long long i = 0; i < n; i++) {
+        C[i] = static_cast<T>(A[i] + B[i]);
+    }
+}
+#else
+template <typename T>
+void sumaSinVectorizar(const T *A, const T *B, T *C, long long n) {
+    sumaSecuencial(A, B, C, n);
+}
+#endif
+
+// ===============================
+// Secuencial con #pragma omp simd (vectorización portable vía OpenMP)
+// ===============================
+template <typename T>
+void sumaOmpSimd(const T *A, const T *B, T *C, long long n) {
+#pragma omp simd
+    for (long long i = 0; i < n; i++) {
+        C[i] = static_cast<T>(A[i] + B[i]);
+    }
+}
+
+// ===============================
+// Paralelo por bloques: el bloque b = [b*chunk, (b+1)*chunk) va al hilo
+// b mod hilos, igual que schedule(static, chunk) sobre los índices, y dentro
+// de cada bloque corre el núcleo secuencial "f".
+// ===============================
+template <typename T>
+void sumaParalelaCon(FuncionSumaT<T> f, const T *A, const T *B, T *C,
+                     long long n, long long chunk) {
+    const long long bloques = (n + chunk - 1) / chunk;
+#pragma omp parallel
+    {
+        SUMA_TRAZA_TRAMO("suma (bloques)", -1);
+#pragma omp for schedule(static, 1) nowait
+        for (long long b = 0; b < bloques; b++) {
+            SUMA_TRAZA_TRAMO("suma (bloques)", b);
+            const long long i = b * chunk;
+            f(A + i, B + i, C + i, std::min(chunk, n - i));
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * lotes.hpp
+ * Descripción:
+ *  - API por lotes para muchos vectores cortos independientes (cientos de
+ *    elementos, como N = 1000): paralelizar dentro de cada vector cuesta
+ *    una región parallel por vector para unos cientos de ns de trabajo.
+ *    Aquí el paralelismo es entre vectores y el SIMD dentro de cada uno.
+ *  - Entrada: una lista de ternas (A, B, C, n) en memoria del que llama.
+ *      sumaLote(ternas):  parallel for sobre las ternas tal cual, con el
+ *                         núcleo SIMD de operaciones.hpp en cada una
+ *      LoteSoA:           empaqueta las ternas en tres arreglos contiguos
+ *                         (todas las A, todas las B, todas las C: estructura
+ *                         de arreglos), cada vector alineado a 64 bytes, y
+ *                         reparte entre hilos tramos contiguos con el mismo
+ *                         número de elementos (no de vectores), así que las
+ *                         longitudes distintas no desbalancean
+ *  - Con LoteSoA el productor puede escribir directo en a(k) y b(k) y el
+ *    consumidor leer c(k), sin copias; empaqueta/desempaqueta son para
+ *    ternas que ya viven en otra parte.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // lower_bound, copy
+#include <vector>
+
+#include <omp.h>
+
+#include "memoria.hpp"       // BufferAlineado, ALINEACION, redondeaArriba
+#include "operaciones.hpp"   // OpSuma, opSimd
+
+// Un vector del lote: C[0..n) = A[0..n) + B[0..n)
+template <typename T>
+struct TernaVectores {
+    const T *A;
+    const T *B;
+    T *C;
+    long long n;
+};
+
+// ===============================
+// Lote sin empaquetar: un vector por iteración, SIMD dentro
+// ===============================
+template <typename T>
+void sumaLote(const std::vector<TernaVectores<T>> &ternas) {
+    const FuncionOp<T> f = opSimd<OpSuma, T>();
+    const long long k = static_cast<long long>(ternas.size());
+#pragma omp parallel for schedule(dynamic, 16)
+    for (long long v = 0; v < k; v++) {
+        const TernaVectores<T> &t = ternas[v];
+        f(t.C, t.A, t.B, nullptr, T(0), t.n);
+    }
+}
+
+// ===============================
+// Lote empaquetado en estructura de arreglos
+// ===============================
+template <typename T>
+class LoteSoA {
+public:
+    // Reserva el lote para vectores de las longitudes dadas
+    explicit LoteSoA(const std::vector<long long> &longitudes, bool paginas_grandes = false)
+        : n_(longitudes), inicio_(longitudes.size() + 1, 0) {
+        const long long por_linea = static_cast<long long>(ALINEACION / sizeof(T));
+        for (std::size_t v = 0; v < longitudes.size(); v++) {
+            inicio_[v + 1] = inicio_[v] + (longitudes[v] + por_linea - 1) / por_linea * por_linea;
+        }
+        A_ = BufferAlineado<T>(inicio_.back(), paginas_grandes);
+        B_ = BufferAlineado<T>(inicio_.back(), paginas_grandes);
+        C_ = BufferAlineado<T>(inicio_.back(), paginas_grandes);
+    }
+
+    long long vectores() const { return static_cast<long long>(n_.size()); }
+    long long longitud(long long v) const { return n_[v]; }
+    // Elementos útiles (sin el relleno hasta la línea)
+    long long elementos() const {
+        long long total = 0;
+        for (long long n : n_) total += n;
+        return total;
+    }
+    T *a(long long v) { return A_.data() + inicio_[v]; }
+    T *b(long long v) { return B_.data() + inicio_[v]; }
+    const T *c(long long v) const { return C_.data() + inicio_[v]; }
+
+    // Copia A y B de las ternas al lote (en paralelo entre vectores)
+    void empaqueta(const std::vector<TernaVectores<T>> &ternas) {
+        const long long k = vectores();
+#pragma omp parallel for schedule(dynamic, 16)
+        for (long long v = 0; v < k; v++) {
+            std::copy(ternas[v].A, ternas[v].A + n_[v], a(v));
+            std::copy(ternas[v].B, ternas[v].B + n_[v], b(v));
+        }
+    }
+
+    // Copia C del lote a las ternas
+    void desempaqueta(const std::vector<TernaVectores<T>> &ternas) const {
+        const long long k = vectores();
+#pragma omp parallel for schedule(dynamic, 16)
+        for (long long v = 0; v < k; v++) {
+            std::copy(c(v), c(v) + n_[v], ternas[v].C);
+        }
+    }
+
+    // Cada hilo suma los vectores que empiezan en su parte de los elementos
+    void suma() {
+        const FuncionOp<T> f = opSimd<OpSuma, T>();
+        T *A = A_.data();
+        T *B = B_.data();
+        T *C = C_.data();
+#pragma omp parallel
+        {
+            const int hilos = omp_get_num_threads();
+            const int h = omp_get_thread_num();
+            const long long desde = primerVector(inicio_.back() * h / hilos);
+            const long long hasta = primerVector(inicio_.back() * (h + 1) / hilos);
+            for (long long v = desde; v < hasta; v++) {
+                const long long i = inicio_[v];
+                f(C + i, A + i, B + i, nullptr, T(0), n_[v]);
+            }
+        }
+    }
+
+private:
+    // Primer vector que empieza en o después del elemento "e"
+    long long primerVector(long long e) const {
+        return std::lower_bound(inicio_.begin(), inicio_.end() - 1, e) - inicio_.begin();
+    }
+
+    std::vector<long long> n_;
+    std::vector<long long> inicio_;   // Desplazamiento de cada vector; inicio_[k] = total
+    BufferAlineado<T> A_, B_, C_;
+};
@@ -1,141 +1,2653 @@
 /******************************************************************************
  * Suma de arreglos en paralelo con OpenMP
  * Descripción:
- *  - Se generan dos arreglos A y B de tamaño N=1000 con valores aleatorios [1,1000].
+ *  - Se generan dos arreglos A y B de tamaño N (por defecto 1000) del tipo
+ *    elegido con --tipo (int8/16/32/64, float, double; defecto int32) con valores
+ *    aleatorios [1,1000], en paralelo y reproducibles con --semilla
+ *    (Philox, ver aleatorio.hpp).
  *  - Se calcula el arreglo C = A + B de forma:
  *      (1) Secuencial
  *      (2) Paralela usando OpenMP con #pragma omp parallel for
- *  - Se usa schedule(static, chunk=100) para controlar la asignación de trabajo.
- *  - Se muestran únicamente los primeros 10 elementos (mostrar=10) para verificar resultados.
- *  - Se miden tiempos (ms) de ambas ejecuciones para comparar desempeño.
+ *  - Se usa schedule(static, chunk) (por defecto chunk=100) para controlar la
+ *    asignación de trabajo.
+ *  - Se muestran únicamente los primeros elementos (mostrar=10) para verificar resultados.
+ *  - Cada núcleo se mide con calentamiento y repeticiones (ver benchmark.hpp):
+ *    min/mediana/p95/p99 en ms, GB/s y elementos/s.
+ *  - Modo "barrido": speedup y eficiencia paralela para varias N y hilos.
+ *  - Modo "simd": compara el escalar, #pragma omp simd y las variantes
+ *    SSE2/AVX2/AVX-512/NEON (ver simd.hpp), secuenciales y en paralelo.
+ *  - --verificacion=serie|paralela|checksum elige cómo se compara C_par; con
+ *    checksum la huella se acumula dentro de la suma paralela y C_seq no se
+ *    reserva (ver verificacion.hpp).
+ *  - --schedule elige static/dynamic/guided/auto/runtime para el for paralelo;
+ *    el modo "planificacion" mide cada política y chunk con telemetría por
+ *    hilo (iteraciones, tiempo ocupado y espera en la barrera; ver
+ *    planificacion.hpp).
+ *  - Modo "persistente": costo por llamada de una región parallel por llamada
+ *    contra un equipo que persiste entre llamadas (región OpenMP envolvente o
+ *    pool propio spin-then-park, ver equipo.hpp) para N chicas y medianas.
+ *  - Modo "adaptativo": suma() elige secuencial, SIMD u OpenMP según N con
+ *    umbrales calibrados al arrancar y guardados en caché (ver despachador.hpp).
+ *  - Modo "robo": p99 de static contra taskloop y deques Chase–Lev, sin y
+ *    con hilos antagonistas que simulan núcleos desalojados (ver robo.hpp).
+ *  - Modo "dispositivo": descarga con omp target teams distribute parallel
+ *    for; separa copia y núcleo, solapa bloques en pipeline y busca la N a
+ *    partir de la cual la descarga gana al host (ver dispositivo.hpp).
+ *  - Modo "distribuido": MPI + OpenMP con A y B repartidos por bloques entre
+ *    procesos, verificación por huella reducida y escalado fuerte y débil
+ *    (ver distribuido.hpp; compilar con mpicxx -DSUMA_MPI).
+ *  - Modo "archivo": A y B se mapean desde archivos binarios y C se escribe
+ *    en un archivo mapeado, sin copias (N puede superar la RAM); reporta
+ *    fallos de página y GB/s efectivos de E/S (ver archivos.hpp).
+ *  - Modo "flujo": tubería por bloques con memoria acotada; un hilo lee el
+ *    siguiente bloque (archivos o stdin) y otro escribe el anterior mientras
+ *    OpenMP calcula el actual (ver flujo.hpp).
+ *  - Modo "roofline": sondas de ancho de banda sostenible (triada STREAM) y
+ *    pico de cómputo por núcleo y por nodo; ubica cada variante por
+ *    intensidad aritmética y dice qué tan cerca del techo está C_par para
+ *    cada N y número de hilos (ver roofline.hpp).
+ *  - --alinear=linea|pagina redondea el chunk para que ningún límite de
+ *    bloque parta una línea de C_par entre dos hilos; el modo
+ *    "comparticion" mide la penalización del reparto actual contra el
+ *    alineado (ver particion.hpp).
+ *  - Modo "teselas": una cadena de etapas (suma, huella, escala, suma) en
+ *    pasadas completas contra teselas del tamaño de la L2 que pasan por
+ *    todas las etapas antes de la siguiente, con la residencia por etapa
+ *    (ver teselas.hpp).
+ *  - Modo "arena": trabajos por lotes con A, B, C_seq y C_par nuevos en
+ *    cada uno contra una arena reservada (y opcionalmente prefallada y con
+ *    mlock) una sola vez; fallos de página y asignaciones del SO antes y en
+ *    estado estable (ver arena.hpp).
+ *  - Modo "lotes": miles de vectores cortos independientes, paralelo entre
+ *    vectores con SIMD dentro de cada uno, sueltos o empaquetados en
+ *    estructura de arreglos; vectores/s contra el for paralelo por vector
+ *    (ver lotes.hpp).
+ *  - Modo "asincrono": sumas y verificaciones enviadas sin bloquear
+ *    (std::future y avisos al completar) a un servicio sobre el equipo
+ *    persistente, que encadena los trabajos sin barreras entre ellos
+ *    (ver asincrono.hpp).
+ *  - Modo "incremental": tras modificar tramos de A o B solo se recalculan
+ *    los chunks de C afectados y la huella se corrige por chunk; por encima
+ *    de --umbral-sucio se recalcula todo (ver incremental.hpp).
+ *  - Modo "desborde": la suma sin comprobar contra las sumas comprobada
+ *    (primer índice que desborda), saturada y ampliada a un tipo más ancho,
+ *    con la detección por reducción dentro del bucle SIMD (ver desborde.hpp).
+ *  - Modo "fijo": sumaFija<N, T> con N conocida al compilar (desenrollada,
+ *    sin cola ni llamada por puntero) contra las rutas con n en tiempo de
+ *    ejecución, para N = 16 ... 4096 (ver fijo.hpp).
+ *  - Modo "operaciones": familia STREAM (copia, escala, suma, triada) y
+ *    versiones fusionadas, con bytes por operación y lo que ahorra la fusión
+ *    (ver operaciones.hpp).
+ *  - --resultado guarda C en binario (cabecera con tipo, N y huella, datos
+ *    little-endian), opcionalmente comprimido por bloques con LZ4/zstd
+ *    (ver formato.hpp); imprimeArreglo queda solo para la muestra en texto.
+ *  - --contadores envuelve el secuencial y el paralelo con perf_event_open
+ *    (ciclos, instrucciones, fallos de LLC/DTLB, cambios de contexto) y
+ *    reporta IPC y bytes/ciclo por núcleo y por hilo (ver contadores.hpp).
+ *  - --informe=<ruta> guarda en JSON (o CSV) la configuración, la máquina
+ *    y cada repetición de cada núcleo de los modos básico, barrido, simd,
+ *    adaptativo y fijo (los demás rechazan la opción), y en el básico los
+ *    contadores de --contadores; el modo "comparar" marca las regresiones
+ *    significativas de --actual contra --base (ver informe.hpp).
+ *  - --traza=<ruta> (compilado con -DSUMA_TRAZA, modo básico) guarda en
+ *    JSON de Chrome un tramo por hilo de la inicialización, de cada llamada
+ *    a los núcleos medidos y de la verificación, leíble en chrome://tracing
+ *    y Perfetto (ver traza.hpp).
+ *  - Por encima de un umbral de tamaño el paralelo también se mide con
+ *    streaming stores en C (ver streaming.hpp).
+ *  - A y B se inicializan con el mismo schedule que la suma (colocación NUMA
+ *    por primer toque); --primer-toque hace lo mismo con C. --afinidad/--lugares fijan
+ *    OMP_PROC_BIND/OMP_PLACES y el modo "numa" compara ubicación y GB/s con
+ *    inicialización serie vs paralela (ver numa.hpp).
+ *  - N, chunk, hilos y mostrar se configuran por línea de comandos o entorno
+ *    (ver configuracion.hpp); los arreglos viven en el heap alineados a 64
+ *    bytes (ver memoria.hpp), opcionalmente sobre huge pages.
+ *
+ * Compilación:  g++ -O2 -fopenmp main.cpp -o suma_arreglos
+ *               (con acelerador: añadir -foffload=nvptx-none o amdgcn-amdhsa)
+ *               mpicxx -O2 -fopenmp -DSUMA_MPI main.cpp -o suma_arreglos
+ *               (con traza: añadir -DSUMA_TRAZA)
+ * Ejemplo:      ./suma_arreglos --n=1e8 --chunk=4096 --hilos=8 --hugepages
+ *               ./suma_arreglos --modo=barrido --barrido-n=1e3,1e5,1e7
+ *               ./suma_arreglos --modo=simd --n=1e8
  *
  ******************************************************************************/
 
 #include <iostream>     // Entrada/salida estándar
-#include <random>       // Números aleatorios (random_device, mt19937, distribution)
-#include <chrono>       // Medición de tiempos
 #include <iomanip>      // Formato de salida (setprecision)
+#include <stdexcept>    // invalid_argument, runtime_error
+#include <algorithm>    // fill, equal, max
+#include <chrono>       // steady_clock (tiempo de verificación)
+#include <cstdint>      // uint64_t
+#include <string>
+#include <vector>
+#include <atomic>       // bandera de los hilos antagonistas
+#include <thread>       // hilos antagonistas del modo robo
 #include <omp.h>        // OpenMP
 
-// ===============================
-// Constantes del programa
-// ===============================
-#define N 1000       // Tamaño de los arreglos
-#define chunk 100    // Tamaño del bloque (chunk) para schedule
-#define mostrar 10   // Cuántos elementos imprimir para verificación
+#include "configuracion.hpp"  // Parámetros N, chunk, hilos, mostrar
+#include "memoria.hpp"        // Buffers alineados en el heap
+#include "kernels.hpp"        // sumaSecuencial, sumaParalela
+#include "benchmark.hpp"      // Calentamiento, repeticiones y estadísticas
+#include "simd.hpp"           // Variantes SSE2/AVX2/AVX-512/NEON y despacho
+#include "streaming.hpp"      // Escrituras no temporales para N >> LLC
+#include "numa.hpp"           // Primer toque, afinidad y ubicación de páginas
+#include "aleatorio.hpp"      // Philox: inicialización paralela reproducible
+#include "operaciones.hpp"    // copia, escala, suma, triada y fusiones
+#include "verificacion.hpp"   // Verificación serie, paralela y por checksum
+#include "planificacion.hpp"  // Políticas de schedule y telemetría por hilo
+#include "equipo.hpp"         // Equipo de hilos persistente (spin-then-park)
+#include "despachador.hpp"    // suma(): secuencial, SIMD u OpenMP según N
+#include "robo.hpp"           // taskloop y deques Chase–Lev (robo de trabajo)
+#include "dispositivo.hpp"    // Descarga al acelerador con omp target
+#include "distribuido.hpp"    // MPI + OpenMP: reparto por bloques entre procesos
+#include "archivos.hpp"       // A, B y C mapeados desde archivos (mmap)
+#include "flujo.hpp"          // Tubería lector/cómputo/escritor por bloques
+#include "formato.hpp"        // Resultados binarios con cabecera y compresión
+#include "contadores.hpp"     // perf_event_open: ciclos, IPC, fallos LLC/DTLB
+#include "roofline.hpp"       // Sondas de ancho de banda y pico, techos por variante
+#include "particion.hpp"      // Bloques de C alineados a línea de caché o página
+#include "teselas.hpp"        // Cadena de operaciones por teselas del tamaño de la L2
+#include "arena.hpp"          // Arena que reutiliza A, B y C entre trabajos
+#include "lotes.hpp"          // Lotes de vectores cortos: paralelo entre vectores
+#include "asincrono.hpp"      // Envíos asíncronos (future + aviso) al equipo persistente
+#include "incremental.hpp"    // Recálculo solo de los chunks de C con A o B modificados
+#include "desborde.hpp"       // Sumas comprobada, saturada y ampliada (desborde sin saltos)
+#include "traza.hpp"          // Línea de tiempo por hilo y chunk (JSON de Chrome/Perfetto)
+#include "informe.hpp"        // Resultados en JSON/CSV y comparación contra una base
+#include "fijo.hpp"           // sumaFija<N, T>: tamaños conocidos al compilar
 
 using namespace std;
 
 // ===============================
 // Imprime solo los primeros "mostrar" elementos del arreglo
 // ===============================
-void imprimeArreglo(const int *d, const char *nombre);
+template <typename T>
+void imprimeArreglo(const T *d, const char *nombre, int mostrar);
+
+// ===============================
+// Modos de ejecución, instanciados por tipo de elemento
+// ===============================
+template <typename T> int ejecutaModo(const Configuracion &cfg);
+template <typename T> int ejecutaBasico(const Configuracion &cfg);
+template <typename T> int ejecutaBarrido(const Configuracion &cfg);
+template <typename T> int ejecutaSimd(const Configuracion &cfg);
+template <typename T> int ejecutaNuma(const Configuracion &cfg);
+template <typename T> int ejecutaOperaciones(const Configuracion &cfg);
+template <typename T> int ejecutaPlanificacion(const Configuracion &cfg);
+template <typename T> int ejecutaPersistente(const Configuracion &cfg);
+template <typename T> int ejecutaAdaptativo(const Configuracion &cfg);
+template <typename T> int ejecutaRobo(const Configuracion &cfg);
+template <typename T> int ejecutaDispositivo(const Configuracion &cfg);
+template <typename T> int ejecutaDistribuido(const Configuracion &cfg);
+template <typename T> int ejecutaArchivo(const Configuracion &cfg);
+template <typename T> int ejecutaFlujo(const Configuracion &cfg);
+template <typename T> int ejecutaRoofline(const Configuracion &cfg);
+template <typename T> int ejecutaComparticion(const Configuracion &cfg);
+template <typename T> int ejecutaTeselas(const Configuracion &cfg);
+template <typename T> int ejecutaArena(const Configuracion &cfg);
+template <typename T> int ejecutaLotes(const Configuracion &cfg);
+template <typename T> int ejecutaAsincrono(const Configuracion &cfg);
+template <typename T> int ejecutaIncremental(const Configuracion &cfg);
+template <typename T> int ejecutaDesborde(const Configuracion &cfg);
+template <typename T> int ejecutaComparar(const Configuracion &cfg);
+template <typename T> int ejecutaFijo(const Configuracion &cfg);
+
+int main(int argc, char **argv) {
+
+    Configuracion cfg;
+    try {
+        cfg = leeConfiguracion(argc, argv);
+    } catch (const invalid_argument &e) {
+        cerr << "[ERROR] " << e.what() << "\n";
+        imprimeAyuda(argv[0]);
+        return 1;
+    }
+    if (cfg.ayuda) {
+        imprimeAyuda(argv[0]);
+        return 0;
+    }
+    if (!compresionDisponible(compresionDesdeNombre(cfg.compresion))) {
+        cerr << "[ERROR] compresion " << cfg.compresion
+             << " no disponible (compilar con -DSUMA_LZ4 -llz4 o -DSUMA_ZSTD -lzstd)\n";
+        return 1;
+    }
+    if (!cfg.traza.empty() && !TRAZA_COMPILADA) {
+        cerr << "[ERROR] traza no disponible (compilar con -DSUMA_TRAZA)\n";
+        return 1;
+    }
+    if (!cfg.informe.empty() && !modoConInforme(cfg.modo)) {
+        cerr << "[ERROR] el modo " << cfg.modo << " no escribe --informe (modos con informe: "
+             << listaModosConInforme() << ")\n";
+        return 1;
+    }
+    if (!cfg.traza.empty() && cfg.modo != "basico") {
+        cerr << "[ERROR] --traza solo la escribe el modo basico (modo " << cfg.modo << ")\n";
+        return 1;
+    }
+    // Debe ir antes de cualquier llamada a OpenMP: puede re-ejecutar el programa
+    aplicaAfinidad(cfg, argv);
+    SesionMpi mpi(argc, argv);   // Sin SUMA_MPI no hace nada
+    if (!cfg.semilla_fija) {
+        cfg.semilla = difundeSemilla(semillaAleatoria());
+    }
+    if (cfg.hilos > 0) {
+        omp_set_num_threads(cfg.hilos);
+    }
+    aplicaPlanificacion(cfg.schedule, cfg.chunk);
+    if (!cfg.traza.empty()) {
+        Traza::global().activa(omp_get_max_threads(), static_cast<size_t>(cfg.traza_eventos));
+    }
+
+    try {
+        // El tipo de elemento se fija aquí; todo lo demás se instancia por tipo
+        return despachaTipo(cfg.tipo, [&](auto cero) {
+            return ejecutaModo<decltype(cero)>(cfg);
+        });
+    } catch (const bad_alloc &) {
+        cerr << "[ERROR] No hay memoria suficiente para los arreglos\n";
+        return 1;
+    } catch (const runtime_error &e) {
+        cerr << "[ERROR] " << e.what() << "\n";
+        return 1;
+    }
+}
+
+template <typename T>
+int ejecutaModo(const Configuracion &cfg) {
+    if (cfg.modo == "barrido") {
+        return ejecutaBarrido<T>(cfg);
+    }
+    if (cfg.modo == "simd") {
+        return ejecutaSimd<T>(cfg);
+    }
+    if (cfg.modo == "numa") {
+        return ejecutaNuma<T>(cfg);
+    }
+    if (cfg.modo == "operaciones") {
+        return ejecutaOperaciones<T>(cfg);
+    }
+    if (cfg.modo == "planificacion") {
+        return ejecutaPlanificacion<T>(cfg);
+    }
+    if (cfg.modo == "persistente") {
+        return ejecutaPersistente<T>(cfg);
+    }
+    if (cfg.modo == "adaptativo") {
+        return ejecutaAdaptativo<T>(cfg);
+    }
+    if (cfg.modo == "robo") {
+        return ejecutaRobo<T>(cfg);
+    }
+    if (cfg.modo == "dispositivo") {
+        return ejecutaDispositivo<T>(cfg);
+    }
+    if (cfg.modo == "distribuido") {
+        return ejecutaDistribuido<T>(cfg);
+    }
+    if (cfg.modo == "archivo") {
+        return ejecutaArchivo<T>(cfg);
+    }
+    if (cfg.modo == "flujo") {
+        return ejecutaFlujo<T>(cfg);
+    }
+    if (cfg.modo == "roofline") {
+        return ejecutaRoofline<T>(cfg);
+    }
+    if (cfg.modo == "comparticion") {
+        return ejecutaComparticion<T>(cfg);
+    }
+    if (cfg.modo == "teselas") {
+        return ejecutaTeselas<T>(cfg);
+    }
+    if (cfg.modo == "arena") {
+        return ejecutaArena<T>(cfg);
+    }
+    if (cfg.modo == "lotes") {
+        return ejecutaLotes<T>(cfg);
+    }
+    if (cfg.modo == "asincrono") {
+        return ejecutaAsincrono<T>(cfg);
+    }
+    if (cfg.modo == "incremental") {
+        return ejecutaIncremental<T>(cfg);
+    }
+    if (cfg.modo == "desborde") {
+        return ejecutaDesborde<T>(cfg);
+    }
+    if (cfg.modo == "comparar") {
+        return ejecutaComparar<T>(cfg);
+    }
+    if (cfg.modo == "fijo") {
+        return ejecutaFijo<T>(cfg);
+    }
+    return ejecutaBasico<T>(cfg);
+}
+
+// ===============================
+// Modo básico: una N, secuencial vs paralelo, verificación y estadísticas
+// ===============================
+template <typename T>
+int ejecutaBasico(const Configuracion &cfg) {
 
-int main() {
+    const long long N = cfg.n;
 
     cout << "Sumando Arreglos en Paralelo (OpenMP)\n";
+    cout << "N=" << N << " tipo=" << nombreTipo<T>() << " chunk=" << cfg.chunk
+         << " hilos=" << omp_get_max_threads()
+         << " schedule=" << (cfg.schedule == "static" ? "static," + to_string(cfg.chunk)
+                                                      : describePlanificacion())
+         << " simd=" << varianteSimd<T>().nombre << "\n";
 
     // ===============================
-    // 1) Declaración de arreglos 
+    // 1) Reserva de arreglos en el heap (alineados a 64 bytes)
+    //    - En la pila no caben más que unos pocos MB
     // ===============================
-    int A[N], B[N], C_seq[N], C_par[N];
+    BufferAlineado<T> bufA(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufC_par(N, cfg.paginas_grandes);
+    // Con checksum la referencia sale de A y B: C_seq no se materializa
+    const bool por_checksum = cfg.verificacion == "checksum";
+    BufferAlineado<T> bufC_seq;
+    if (!por_checksum) {
+        bufC_seq = BufferAlineado<T>(N, cfg.paginas_grandes);
+    }
+    cout << "Memoria: " << nombreTipoMemoria(bufA.tipo()) << ", "
+         << ((por_checksum ? 3.0 : 4.0) * bufA.bytes() / (1024.0 * 1024.0)) << " MB en total\n";
+
+    T *A = bufA.data();
+    T *B = bufB.data();
+    T *C_par = bufC_par.data();
+    // Sin C_seq el secuencial escribe en C_par solo para medir su tiempo
+    T *C_seq = por_checksum ? C_par : bufC_seq.data();
 
     // ===============================
     // 2) Inicialización: números aleatorios en [1, 1000]
-    //    - random_device: fuente de entropía
-    //    - mt19937: generador
-    //    - uniform_int_distribution: distribución uniforme
+    //    - Philox en paralelo con schedule(static, chunk): cada página de A y
+    //      B la escribe primero el hilo que la usará en la suma paralela
+    //    - Con --primer-toque también C se pone a cero en paralelo
     // ===============================
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<int> dist(1, 1000);
-
-    for (int i = 0; i < N; i++) {
-        A[i] = dist(gen);
-        B[i] = dist(gen);
-        // Inicializamos resultados por claridad
-        C_seq[i] = 0;
-        C_par[i] = 0;
+    if (cfg.primer_toque) {
+        if (!por_checksum) ceroParalelo(C_seq, N, cfg.chunk);
+        ceroParalelo(C_par, N, cfg.chunk);
+    } else {
+        for (long long i = 0; i < N; i++) {
+            // Inicializamos resultados por claridad
+            C_seq[i] = T(0);
+            C_par[i] = T(0);
+        }
     }
+    inicializaArreglosParalelo(A, B, N, cfg.chunk, cfg.semilla);
+    cout << "Semilla: " << cfg.semilla << "  huella A,B: 0x" << hex
+         << huellaArreglos(A, B, N) << dec << "\n";
 
     // ===============================
-    // 3) SUMA SECUENCIAL (baseline)
-    //    - Cada iteración depende solo de A[i] y B[i]
-    //    - No hay paralelismo, corre en un solo hilo
+    // 3) y 4) SUMA SECUENCIAL y PARALELA, cada una con calentamiento
+    //    y "repeticiones" muestras (ver kernels.hpp y benchmark.hpp)
     // ===============================
-    auto inicio_seq = chrono::high_resolution_clock::now();
+    long long pedazos = cfg.chunk;
+    const double bytes = 3.0 * sizeof(T) * N;
+    const int hilos = omp_get_max_threads();
+    Informe informe(cfg, nombreTipo<T>(), varianteSimd<T>().nombre);
 
-    for (int i = 0; i < N; i++) {
-        C_seq[i] = A[i] + B[i];
-    }
+    Estadisticas est_seq = informe.mide("secuencial", N, 1, bytes, [&] { sumaSecuencial(A, B, C_seq, N); },
+                                        cfg.calentamiento, cfg.repeticiones);
 
-    auto fin_seq = chrono::high_resolution_clock::now();
-    double tiempo_secuencial =
-        chrono::duration<double, milli>(fin_seq - inicio_seq).count();
+    // Cada variante paralela escribe C_par desde cero y se comprueba al
+    // terminar (contra C_seq o contra la huella de referencia): la
+    // verificación del paso 5 solo ve la última
+    const uint64_t referencia = por_checksum ? checksumReferencia(A, B, N, pedazos) : 0;
+    bool correcto = true;
+    auto reiniciaVariante = [&] { ceroParalelo(C_par, N, cfg.chunk); };
+    auto compruebaVariante = [&](const char *nombre) {
+        const bool ok = por_checksum ? checksumArreglo(C_par, N, pedazos) == referencia
+                                     : verificaIgualesParalelo(C_seq, C_par, N, pedazos);
+        if (!ok) {
+            cout << "[ERROR] " << nombre << ": C_par no coincide con la referencia\n";
+            correcto = false;
+        }
+    };
 
-    // ===============================
-    // 4) SUMA PARALELA CON OPENMP
-    //    - Se paraleliza el for.
-    //    - shared(): arreglos compartidos entre hilos.
-    //    - private(i): i privada por hilo (evita condiciones de carrera).
-    //    - schedule(static, chunk): reparte el trabajo en bloques fijos de 100 iteraciones.
-    // ===============================
-    int pedazos = chunk;
+    reiniciaVariante();
+    Estadisticas est_par = informe.mide("paralelo", N, hilos, bytes,
+                                        [&] { sumaParalelaPlanificada(cfg, A, B, C_par, N); },
+                                        cfg.calentamiento, cfg.repeticiones);
+    compruebaVariante("paralelo");
 
-    auto inicio_par = chrono::high_resolution_clock::now();
+    // Suma paralela con la huella de C en la misma pasada (solo con checksum)
+    Estadisticas est_fusion;
+    if (por_checksum) {
+        uint64_t huella_c = 0;
+        reiniciaVariante();
+        est_fusion = informe.mide("paralelo + checksum", N, hilos, bytes,
+                                  [&] { huella_c = sumaParalelaConChecksum(A, B, C_par, N, pedazos); },
+                                  cfg.calentamiento, cfg.repeticiones);
+        compruebaVariante("paralelo + checksum");
+        if (huella_c != referencia) {
+            cout << "[ERROR] paralelo + checksum: huella fusionada 0x" << hex << huella_c
+                 << " referencia 0x" << referencia << dec << "\n";
+            correcto = false;
+        }
+    }
 
-#pragma omp parallel for shared(A, B, C_par, pedazos) schedule(static, pedazos)
-    for (int i = 0; i < N; i++) {
-        // Cada hilo escribe en una posición distinta C_par[i], por lo que es seguro
-        C_par[i] = A[i] + B[i];
+    // Streaming stores: solo si A + B + C supera el umbral (o si se fuerza)
+    const bool streaming = usaStreaming(cfg, N, sizeof(T));
+    Estadisticas est_stream;
+    if (streaming) {
+        reiniciaVariante();
+        est_stream = informe.mide("paralelo (stream)", N, hilos, bytes,
+                                  [&] { sumaParalelaStream(A, B, C_par, N, pedazos); },
+                                  cfg.calentamiento, cfg.repeticiones);
+        compruebaVariante("paralelo (stream)");
     }
 
-    auto fin_par = chrono::high_resolution_clock::now();
-    double tiempo_paralelo =
-        chrono::duration<double, milli>(fin_par - inicio_par).count();
+    // Bloques alineados a línea o página (opcional); como las demás variantes
+    // se comprueba al terminar, y al ir al final es la que queda en C_par
+    const AlineacionChunk alineacion = alineacionDesdeNombre(cfg.alinear);
+    const Particion particion = particiona(C_par, N, cfg.chunk, alineacion);
+    Estadisticas est_alineado;
+    if (alineacion != AlineacionChunk::Ninguna) {
+        reiniciaVariante();
+        est_alineado = informe.mide("paralelo (alineado)", N, hilos, bytes,
+                                    [&] { sumaParticionada(A, B, C_par, particion); },
+                                    cfg.calentamiento, cfg.repeticiones);
+        compruebaVariante("paralelo (alineado)");
+    }
 
     // ===============================
     // 5) Verificación rápida:
-    //    - Imprimimos solo 10 elementos para validar visualmente
-    //    - Validamos que C_seq y C_par coincidan en todos los índices
+    //    - Imprimimos solo "mostrar" elementos para validar visualmente
+    //    - serie/paralela: C_seq y C_par deben coincidir en todos los índices
+    //    - checksum: la huella de C_par debe ser la de referencia (desde A y B)
+    //    C_par tiene el resultado de la última variante, que es el que se
+    //    guarda con --resultado
     // ===============================
-    imprimeArreglo(A, "A");
-    imprimeArreglo(B, "B");
-    imprimeArreglo(C_par, "C (paralelo)");
+    imprimeArreglo(A, "A", cfg.mostrar);
+    imprimeArreglo(B, "B", cfg.mostrar);
+    imprimeArreglo(C_par, "C (paralelo)", cfg.mostrar);
 
-    bool correcto = true;
-    for (int i = 0; i < N; i++) {
-        if (C_seq[i] != C_par[i]) {
-            correcto = false;
-            // Reporte mínimo del primer error encontrado
-            cout << "\n[ERROR] Diferencia en i=" << i
-                 << " C_seq=" << C_seq[i]
-                 << " C_par=" << C_par[i] << endl;
-            break;
+    bool correcto_final = true;
+    auto inicio_ver = chrono::steady_clock::now();
+    if (por_checksum) {
+        const uint64_t huella_c = checksumArreglo(C_par, N, pedazos);
+        correcto_final = huella_c == referencia;
+        if (!correcto_final) {
+            cout << "\n[ERROR] Checksum C_par=0x" << hex << huella_c
+                 << " referencia=0x" << referencia << dec << endl;
         }
+    } else if (cfg.verificacion == "paralela") {
+        correcto_final = verificaIgualesParalelo(C_seq, C_par, N, pedazos);
+    } else {
+        correcto_final = verificaIguales(C_seq, C_par, N);
     }
+    correcto = correcto && correcto_final;
+    const double tiempo_ver =
+        chrono::duration<double, milli>(chrono::steady_clock::now() - inicio_ver).count();
 
-    cout << "\nVerificacion (C_seq == C_par): " << (correcto ? "OK" : "FALLO") << endl;
+    cout << "\nVerificacion (" << (por_checksum ? "checksum" : "C_seq == C_par") << ", "
+         << cfg.verificacion << ", " << fixed << setprecision(4) << tiempo_ver << " ms): "
+         << (correcto ? "OK" : "FALLO") << endl;
 
     // ===============================
-    // 6) Reporte de tiempos (ms)
+    // 5b) Resultado binario (opcional): se escribe y se relee para comprobar
+    //     la huella de la cabecera. Solo si C_par pasó la verificación.
+    // ===============================
+    if (!cfg.resultado.empty() && !correcto) {
+        cout << "\n[ERROR] No se escribe " << cfg.resultado << ": C_par no paso la verificacion\n";
+    } else if (!cfg.resultado.empty()) {
+        const Compresion compresion = compresionDesdeNombre(cfg.compresion);
+        const double t0 = omp_get_wtime();
+        const ResumenEscritura r = escribeResultado(cfg.resultado, C_par, N, cfg.chunk, compresion);
+        const double t1 = omp_get_wtime();
+        BufferAlineado<T> releido;
+        leeResultado(cfg.resultado, releido, cfg.chunk);
+        const double t2 = omp_get_wtime();
+        cout << "\nResultado: " << cfg.resultado << " (" << nombreCompresion(compresion) << ", "
+             << r.bytes_archivo << " bytes, " << fixed << setprecision(2)
+             << 100.0 * r.bytes_archivo / max<uint64_t>(r.bytes_datos, 1) << "% de los datos)\n"
+             << "  escritura " << setprecision(3) << (t1 - t0) * 1e3 << " ms ("
+             << setprecision(2) << gbPorSegundo(r.bytes_datos, (t1 - t0) * 1e3) << " GB/s), relectura "
+             << setprecision(3) << (t2 - t1) * 1e3 << " ms: huella OK\n";
+    }
+
+    // ===============================
+    // 6) Reporte de tiempos (ms) sobre "repeticiones" muestras
     //    - Nota: En tamaños pequeños o entornos virtualizados, el paralelo puede salir más lento
     //    - Para ver ganancia real, suele requerirse más N o más trabajo por iteración
     // ===============================
+    cout << "\n" << cfg.calentamiento << " calentamientos, "
+         << cfg.repeticiones << " repeticiones por kernel\n";
+    imprimeEncabezadoEstadisticas();
+    imprimeEstadisticas("secuencial", est_seq, bytes, N);
+    imprimeEstadisticas("paralelo", est_par, bytes, N);
+    if (por_checksum) {
+        imprimeEstadisticas("paralelo + checksum", est_fusion, bytes, N);
+    }
+    if (streaming) {
+        imprimeEstadisticas("paralelo (stream)", est_stream, bytes, N);
+    }
+    if (alineacion != AlineacionChunk::Ninguna) {
+        imprimeEstadisticas("paralelo (alineado)", est_alineado, bytes, N);
+        const Particion original = particiona(C_par, N, cfg.chunk, AlineacionChunk::Ninguna);
+        cout << "Particion alineada a " << nombreAlineacion(alineacion) << " (" << particion.alineacion
+             << " B): chunk " << cfg.chunk << " -> " << particion.chunk << " elementos ("
+             << particion.chunk * sizeof(T) << " B), cabeza " << particion.cabeza << ", cola "
+             << particion.cola() << ", limites a mitad de linea " << limitesCompartidos(C_par, original)
+             << " -> " << limitesCompartidos(C_par, particion) << "\n";
+    }
+
+    if (cfg.contadores) {
+        // Una pasada aparte con los contadores habilitados (no afecta las
+        // estadísticas de arriba); mismas repeticiones que la medición
+        MedicionContadores m_seq = mideContadores([&] { sumaSecuencial(A, B, C_seq, N); },
+                                                  cfg.repeticiones);
+        MedicionContadores m_par = mideContadores([&] { sumaParalelaPlanificada(cfg, A, B, C_par, N); },
+                                                  cfg.repeticiones);
+        informe.agregaContadores("secuencial", m_seq.por_hilo[0], cfg.repeticiones);
+        informe.agregaContadores("paralelo", m_par.total, cfg.repeticiones);
+        const double bytes_total = bytes * cfg.repeticiones;
+        cout << "\nContadores (perf_event, " << cfg.repeticiones << " repeticiones; B/ciclo con bytes utiles)\n";
+        imprimeEncabezadoContadores("kernel");
+        imprimeFilaContadores("secuencial", m_seq.por_hilo[0], bytes_total, m_seq.segundos);
+        imprimeFilaContadores("paralelo", m_par.total, bytes_total, m_par.segundos);
+        if (m_par.por_hilo.size() > 1) {
+            imprimeEncabezadoContadores("hilo (paralelo)");
+            const double por_hilo = bytes_total / m_par.por_hilo.size();
+            for (size_t h = 0; h < m_par.por_hilo.size(); h++) {
+                imprimeFilaContadores("  " + to_string(h), m_par.por_hilo[h], por_hilo, m_par.segundos);
+            }
+        }
+        cout << "Diagnostico (paralelo): " << diagnosticoContadores(m_par, bytes_total, cfg.repeticiones) << "\n";
+    }
+
+    if (trazaActiva()) {
+        // Los tramos los dejaron los núcleos de arriba, medición incluida
+        const Traza &traza = Traza::global();
+        traza.escribeChrome(cfg.traza);
+        cout << "\nTraza: " << cfg.traza << " (" << traza.eventos() << " tramos, " << traza.perdidos()
+             << " perdidos; chrome://tracing o ui.perfetto.dev)\n";
+    }
+
+    cout << fixed << setprecision(1)
+         << "\nStreaming stores (" << varianteStream<T>().nombre << "): "
+         << (streaming ? "SI" : "NO") << " (modo " << cfg.stream << ", umbral "
+         << umbralStream(cfg) / (1024.0 * 1024.0) << " MB, A+B+C = "
+         << bytes / (1024.0 * 1024.0) << " MB)\n";
+    if (streaming) {
+        // Tráfico estimado: con caché A, B, RFO de C y C; con streaming A, B y C
+        cout << "Trafico estimado: " << 4.0 * sizeof(T) * N / 1.0e6 << " MB -> "
+             << 3.0 * sizeof(T) * N / 1.0e6 << " MB por pasada (-25%)\n";
+    }
+
     cout << fixed << setprecision(4);
-    cout << "\nTiempo secuencial (ms): " << tiempo_secuencial << endl;
-    cout << "Tiempo paralelo   (ms): " << tiempo_paralelo << endl;
+    cout << "\nTiempo secuencial (ms, mediana): " << est_seq.mediana << endl;
+    cout << "Tiempo paralelo   (ms, mediana): " << est_par.mediana << endl;
+    if (streaming) {
+        cout << "Tiempo stream     (ms, mediana): " << est_stream.mediana << endl;
+    }
+    cout << setprecision(2)
+         << "Speedup: " << est_seq.mediana / est_par.mediana << "x" << endl;
+
+    if (!cfg.informe.empty()) {
+        informe.escribe(cfg.informe);
+        cout << "Informe: " << cfg.informe << " (" << informe.mediciones() << " mediciones)" << endl;
+    }
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo barrido: para cada N y cada número de hilos reporta
+//  - speedup = T_secuencial / T_paralelo (medianas)
+//  - eficiencia = speedup / hilos
+//  - y la primera N en que el paralelo deja de perder contra el secuencial
+// ===============================
+template <typename T>
+int ejecutaBarrido(const Configuracion &cfg) {
+
+    const int hilos_originales = omp_get_max_threads();
+    vector<long long> hilos = cfg.barrido_hilos;
+    if (hilos.empty()) {
+        int maximo = hilos_originales;
+        for (int h = 1; h < maximo; h *= 2) hilos.push_back(h);
+        hilos.push_back(maximo);
+    }
+
+    // cruce[j]: primera N con speedup > 1 usando hilos[j] (0 = nunca)
+    vector<long long> cruce(hilos.size(), 0);
+    Informe informe(cfg, nombreTipo<T>(), varianteSimd<T>().nombre);
+
+    cout << "Barrido secuencial vs paralelo (chunk=" << cfg.chunk << ", "
+         << cfg.repeticiones << " repeticiones, medianas en ms)\n";
+    cout << setw(12) << "N" << setw(7) << "hilos" << setw(12) << "T_seq"
+         << setw(12) << "T_par" << setw(10) << "GB/s par" << setw(10) << "speedup"
+         << setw(12) << "eficiencia" << "\n";
+
+    for (long long N : cfg.barrido_n) {
+        BufferAlineado<T> bufA(N, cfg.paginas_grandes);
+        BufferAlineado<T> bufB(N, cfg.paginas_grandes);
+        BufferAlineado<T> bufC(N, cfg.paginas_grandes);
+        T *A = bufA.data();
+        T *B = bufB.data();
+        T *C = bufC.data();
+        inicializaArreglosParalelo(A, B, N, cfg.chunk, cfg.semilla);
+
+        const double bytes = 3.0 * sizeof(T) * N;
+        Estadisticas est_seq = informe.mide("secuencial", N, 1, bytes, [&] { sumaSecuencial(A, B, C, N); },
+                                            cfg.calentamiento, cfg.repeticiones);
+
+        for (size_t j = 0; j < hilos.size(); j++) {
+            omp_set_num_threads(static_cast<int>(hilos[j]));
+            Estadisticas est_par = informe.mide("paralelo", N, static_cast<int>(hilos[j]), bytes,
+                                                [&] { sumaParalela(A, B, C, N, cfg.chunk); },
+                                                cfg.calentamiento, cfg.repeticiones);
+            double speedup = est_seq.mediana / est_par.mediana;
+            if (speedup > 1.0 && cruce[j] == 0) cruce[j] = N;
+
+            cout << setw(12) << N << setw(7) << hilos[j]
+                 << fixed << setprecision(4)
+                 << setw(12) << est_seq.mediana << setw(12) << est_par.mediana
+                 << setprecision(2)
+                 << setw(10) << gbPorSegundo(bytes, est_par.mediana)
+                 << setw(10) << speedup
+                 << setw(11) << 100.0 * speedup / hilos[j] << "%\n";
+        }
+    }
+
+    cout << "\nPrimera N en que el paralelo supera al secuencial:\n";
+    for (size_t j = 0; j < hilos.size(); j++) {
+        cout << "  hilos=" << setw(3) << hilos[j] << ": ";
+        if (cruce[j]) cout << "N=" << cruce[j] << "\n";
+        else cout << "ninguna de las N probadas\n";
+    }
+
+    // Restauramos el número de hilos con el que se entró al barrido
+    omp_set_num_threads(hilos_originales);
+    if (!cfg.informe.empty()) {
+        informe.escribe(cfg.informe);
+        cout << "\nInforme: " << cfg.informe << " (" << informe.mediciones() << " mediciones)\n";
+    }
+    return 0;
+}
+
+// ===============================
+// Modo simd: mismas A y B, cada variante secuencial y paralela.
+//  - Si todas las variantes dan los mismos GB/s para N >> LLC, la suma está
+//    limitada por memoria; si las anchas ganan, el cuello era el front-end
+//    (instrucciones por elemento), algo típico cuando los datos caben en caché.
+// ===============================
+template <typename T>
+int ejecutaSimd(const Configuracion &cfg) {
+
+    const long long N = cfg.n;
+    BufferAlineado<T> bufA(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufC_ref(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufC(N, cfg.paginas_grandes);
+    T *A = bufA.data();
+    T *B = bufB.data();
+    T *C_ref = bufC_ref.data();
+    T *C = bufC.data();
+    inicializaArreglosParalelo(A, B, N, cfg.chunk, cfg.semilla);
+    sumaSinVectorizar(A, B, C_ref, N);
+
+    vector<VarianteSimd<T>> variantes = {
+        {"escalar", sumaSinVectorizar<T>, true},
+        {"auto-vectorizado", sumaSecuencial<T>, true},
+        {"omp simd", sumaOmpSimd<T>, true},
+    };
+    for (const VarianteSimd<T> &v : variantesSimd<T>()) variantes.push_back(v);
+    for (const VarianteSimd<T> &v : variantesStream<T>()) variantes.push_back(v);
+
+    cout << "Comparacion de variantes SIMD (N=" << N << ", chunk=" << cfg.chunk
+         << ", hilos=" << omp_get_max_threads() << ")\n";
+    cout << "Despacho en tiempo de ejecucion: " << varianteSimd<T>().nombre << "\n\n";
+    imprimeEncabezadoEstadisticas();
+
+    const double bytes = 3.0 * sizeof(T) * N;
+    double gbs_escalar = 0.0, gbs_mejor = 0.0;
+    bool correcto = true;
+    Informe informe(cfg, nombreTipo<T>(), varianteSimd<T>().nombre);
+
+    for (const VarianteSimd<T> &v : variantes) {
+        if (!v.disponible) {
+            cout << left << setw(22) << v.nombre << right << "  (no soportada por esta CPU)\n";
+            continue;
+        }
+        // Las variantes -stream dejan el sfence al llamador
+        const bool es_stream = string(v.nombre).find("-stream") != string::npos;
+        for (int paralelo = 0; paralelo <= 1; paralelo++) {
+            fill(C, C + N, T(0));
+            const string nombre = string(v.nombre) + (paralelo ? " (par)" : " (seq)");
+            const int hilos = paralelo ? omp_get_max_threads() : 1;
+            Estadisticas e;
+            if (paralelo && es_stream) {
+                e = informe.mide(nombre, N, hilos, bytes,
+                                 [&] { sumaParalelaStream(v.funcion, A, B, C, N, cfg.chunk); },
+                                 cfg.calentamiento, cfg.repeticiones);
+            } else if (paralelo) {
+                e = informe.mide(nombre, N, hilos, bytes,
+                                 [&] { sumaParalelaCon(v.funcion, A, B, C, N, cfg.chunk); },
+                                 cfg.calentamiento, cfg.repeticiones);
+            } else {
+                e = informe.mide(nombre, N, hilos, bytes, [&] { v.funcion(A, B, C, N); barreraStores(); },
+                                 cfg.calentamiento, cfg.repeticiones);
+            }
+            imprimeEstadisticas(nombre.c_str(), e, bytes, N);
+
+            if (!equal(C, C + N, C_ref)) {
+                cout << "  [ERROR] " << nombre << " no coincide con el escalar\n";
+                correcto = false;
+            }
+            if (!paralelo && !es_stream) {
+                double gbs = gbPorSegundo(bytes, e.mediana);
+                if (v.funcion == sumaSinVectorizar<T>) gbs_escalar = gbs;
+                gbs_mejor = max(gbs_mejor, gbs);
+            }
+        }
+    }
+
+    cout << fixed << setprecision(2)
+         << "\nMejor secuencial / escalar: " << gbs_mejor / gbs_escalar << "x -> "
+         << (gbs_mejor < 1.2 * gbs_escalar
+                 ? "limitado por memoria (las variantes anchas no ayudan)"
+                 : "limitado por front-end/computo (la vectorizacion ayuda)")
+         << "\n";
+    cout << "Verificacion de variantes: " << (correcto ? "OK" : "FALLO") << endl;
+    if (!cfg.informe.empty()) {
+        informe.escribe(cfg.informe);
+        cout << "Informe: " << cfg.informe << " (" << informe.mediciones() << " mediciones)" << endl;
+    }
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo numa: la misma suma paralela con dos colocaciones de páginas
+//  (1) inicialización en serie: todas las páginas en el nodo del hilo 0
+//  (2) primer toque en paralelo: cada página en el nodo de su hilo dueño
+// Reporta % de páginas locales y GB/s de cada caso. Sin afinidad fija
+// (--afinidad=close|spread) los hilos pueden migrar y la medida no es fiable.
+// ===============================
+template <typename T>
+int ejecutaNuma(const Configuracion &cfg) {
+
+    const long long N = cfg.n;
+    const double bytes = 3.0 * sizeof(T) * N;
+
+    imprimeAfinidad();
+    if (omp_get_proc_bind() == omp_proc_bind_false) {
+        cout << "[AVISO] Hilos sin afinidad: usa --afinidad=close o --afinidad=spread\n";
+    }
+    if (cfg.chunk * static_cast<long long>(sizeof(T)) < sysconf(_SC_PAGESIZE)) {
+        cout << "[AVISO] chunk=" << cfg.chunk << " es menor que una pagina: varios hilos"
+             << " comparten cada pagina y el primer toque no puede separarlas\n";
+    }
+
+    cout << "\nN=" << N << " chunk=" << cfg.chunk << " hilos=" << omp_get_max_threads() << "\n";
+    cout << left << setw(26) << "Inicializacion" << right << setw(12) << "% locales"
+         << setw(12) << "mediana" << setw(10) << "GB/s" << "\n";
+
+    double gbs[2] = {0.0, 0.0};
+    for (int paralela = 0; paralela <= 1; paralela++) {
+        // Buffers nuevos en cada caso: las páginas aún no tienen nodo
+        BufferAlineado<T> bufA(N, cfg.paginas_grandes);
+        BufferAlineado<T> bufB(N, cfg.paginas_grandes);
+        BufferAlineado<T> bufC(N, cfg.paginas_grandes);
+        T *A = bufA.data();
+        T *B = bufB.data();
+        T *C = bufC.data();
+
+        if (paralela) {
+            ceroParalelo(C, N, cfg.chunk);
+            inicializaArreglosParalelo(A, B, N, cfg.chunk, cfg.semilla);
+        } else {
+            fill(C, C + N, T(0));
+            inicializaArreglos(A, B, N, cfg.semilla);
+        }
+
+        Ubicacion u;
+        for (const T *d : {static_cast<const T *>(A), static_cast<const T *>(B),
+                           static_cast<const T *>(C)}) {
+            Ubicacion ud = ubicacionPaginas(d, N, cfg.chunk);
+            u.locales += ud.locales;
+            u.remotas += ud.remotas;
+            u.desconocidas += ud.desconocidas;
+        }
+
+        Estadisticas e = mide([&] { sumaParalela(A, B, C, N, cfg.chunk); },
+                              cfg.calentamiento, cfg.repeticiones);
+        gbs[paralela] = gbPorSegundo(bytes, e.mediana);
+
+        cout << left << setw(26) << (paralela ? "primer toque (paralela)" : "serie (hilo 0)")
+             << right << fixed << setprecision(1);
+        if (u.locales + u.remotas > 0) cout << setw(11) << 100.0 * u.fraccionLocal() << "%";
+        else cout << setw(12) << "n/d";
+        cout << setprecision(4) << setw(12) << e.mediana
+             << setprecision(2) << setw(10) << gbs[paralela] << "\n";
+    }
+
+    cout << fixed << setprecision(2)
+         << "\nGB/s primer toque / serie: " << gbs[1] / gbs[0] << "x";
+    if (numeroNodos() == 1) cout << " (un solo nodo NUMA: todo es local)";
+    cout << endl;
+    return 0;
+}
+
+// ===============================
+// Modo planificacion:
+//  (1) Telemetría por hilo de la política elegida con --schedule
+//  (2) Barrido de políticas x chunks (--barrido-chunk): mediana, desbalance
+//      y % de tiempo esperando en la barrera, para elegir el chunk con datos
+// ===============================
+template <typename T>
+int ejecutaPlanificacion(const Configuracion &cfg) {
 
+    const long long N = cfg.n;
+    BufferAlineado<T> bufA(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufC(N, cfg.paginas_grandes);
+    T *A = bufA.data();
+    T *B = bufB.data();
+    T *C = bufC.data();
+    inicializaArreglosParalelo(A, B, N, cfg.chunk, cfg.semilla);
+
+    // Telemetría acumulada sobre las repeticiones (tras el calentamiento)
+    auto telemetria = [&](vector<TelemetriaHilo> &tele) {
+        vector<TelemetriaHilo> descartada;
+        for (int r = 0; r < cfg.calentamiento; r++) sumaParalelaTelemetria(A, B, C, N, descartada);
+        tele.assign(omp_get_max_threads(), TelemetriaHilo{});
+        for (int r = 0; r < cfg.repeticiones; r++) sumaParalelaTelemetria(A, B, C, N, tele);
+    };
+
+    cout << "Planificacion del for paralelo (N=" << N << ", tipo=" << nombreTipo<T>()
+         << ", hilos=" << omp_get_max_threads() << ")\n";
+    cout << "\nPolitica elegida: " << describePlanificacion()
+         << " (promedio por repeticion)\n";
+    vector<TelemetriaHilo> tele;
+    telemetria(tele);
+    imprimeTelemetria(tele, cfg.repeticiones);
+
+    vector<long long> chunks = cfg.barrido_chunk;
+    if (chunks.empty()) chunks.push_back(cfg.chunk);
+
+    cout << "\n" << left << setw(18) << "schedule" << right << setw(12) << "mediana"
+         << setw(12) << "p99" << setw(12) << "desbalance" << setw(10) << "espera" << "\n";
+    string mejor;
+    double t_mejor = 0.0;
+    for (const char *politica : {"static", "dynamic", "guided", "auto"}) {
+        for (long long c : chunks) {
+            aplicaPlanificacion(politica, c);
+            Estadisticas e = mide([&] { sumaParalelaRuntime(A, B, C, N); },
+                                  cfg.calentamiento, cfg.repeticiones);
+            telemetria(tele);
+            ResumenTelemetria r = resumeTelemetria(tele);
+            string nombre = describePlanificacion();
+            cout << left << setw(18) << nombre << right << fixed << setprecision(4)
+                 << setw(12) << e.mediana << setw(12) << e.p99 << setprecision(2)
+                 << setw(12) << r.desbalance << setprecision(1) << setw(9) << r.espera_pct << "%\n";
+            if (mejor.empty() || e.mediana < t_mejor) {
+                mejor = nombre;
+                t_mejor = e.mediana;
+            }
+            if (string(politica) == "auto") break;   // auto ignora el chunk
+        }
+    }
+    cout << "\nMejor mediana: " << mejor << " (" << fixed << setprecision(4) << t_mejor << " ms)\n";
+
+    aplicaPlanificacion(cfg.schedule, cfg.chunk);
     return 0;
 }
 
+// ===============================
+// Modo persistente: costo por llamada de C = A + B repetida muchas veces.
+//  - por llamada: una región parallel (fork/join) en cada invocación
+//  - region+for: una sola región; cada llamada es un omp for con barrera
+//  - region+nowait: igual sin barrera (cota inferior, ver equipo.hpp)
+//  - equipo: pool propio que gira y luego duerme entre llamadas
+// Cada muestra agrupa suficientes llamadas para ~1e7 elementos; por defecto
+// N recorre 1e2..1e6 (--barrido-n lo reemplaza).
+// ===============================
+template <typename T>
+int ejecutaPersistente(const Configuracion &cfg) {
+
+    vector<long long> tamanos = cfg.barrido_n;
+    if (!cfg.barrido_n_dado) tamanos = {100, 1000, 10000, 100000, 1000000};
+    const long long n_max = *max_element(tamanos.begin(), tamanos.end());
+
+    BufferAlineado<T> bufA(n_max, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(n_max, cfg.paginas_grandes);
+    BufferAlineado<T> bufC(n_max, cfg.paginas_grandes);
+    BufferAlineado<T> bufR(n_max, cfg.paginas_grandes);
+    T *A = bufA.data();
+    T *B = bufB.data();
+    T *C = bufC.data();
+    T *R = bufR.data();
+    inicializaArreglosParalelo(A, B, n_max, cfg.chunk, cfg.semilla);
+    sumaSecuencial(A, B, R, n_max);
+
+    EquipoPersistente equipo(omp_get_max_threads());
+
+    cout << "Equipo persistente (tipo=" << nombreTipo<T>() << ", chunk=" << cfg.chunk
+         << ", hilos=" << equipo.hilos() << ")\n";
+    cout << "us por llamada (mediana de " << cfg.repeticiones << " muestras)\n\n";
+    cout << right << setw(10) << "N" << setw(10) << "llamadas" << setw(11) << "seq"
+         << setw(13) << "por llamada" << setw(12) << "region+for" << setw(14) << "region+nowait"
+         << setw(10) << "equipo" << setw(11) << "speedup" << "\n";
+
+    bool correcto = true;
+    for (long long n : tamanos) {
+        const long long llamadas = max(10LL, min(100000LL, 10000000LL / n));
+        auto porLlamada = [&](Estadisticas e) { return e.mediana * 1000.0 / llamadas; };
+
+        const char *nombres[5] = {"seq", "por llamada", "region+for", "region+nowait", "equipo"};
+        double us[5];
+        for (int v = 0; v < 5; v++) {
+            fill(C, C + n, T(0));
+            Estadisticas e = mide([&] {
+                switch (v) {
+                    case 0: for (long long k = 0; k < llamadas; k++) sumaSecuencial(A, B, C, n); break;
+                    case 1: for (long long k = 0; k < llamadas; k++) sumaParalela(A, B, C, n, cfg.chunk); break;
+                    case 2: sumaRegionPersistente(A, B, C, n, cfg.chunk, llamadas, true); break;
+                    case 3: sumaRegionPersistente(A, B, C, n, cfg.chunk, llamadas, false); break;
+                    default: for (long long k = 0; k < llamadas; k++) sumaEquipo(equipo, A, B, C, n, cfg.chunk); break;
+                }
+            }, cfg.calentamiento, cfg.repeticiones);
+            us[v] = porLlamada(e);
+            if (!equal(C, C + n, R)) {
+                cout << "  [ERROR] " << nombres[v] << " (N=" << n << ") no coincide con la referencia\n";
+                correcto = false;
+            }
+        }
+        cout << setw(10) << n << setw(10) << llamadas << fixed << setprecision(3)
+             << setw(11) << us[0] << setw(13) << us[1] << setw(12) << us[2]
+             << setw(14) << us[3] << setw(10) << us[4]
+             << setprecision(2) << setw(10) << us[1] / us[4] << "x\n";
+    }
+    cout << "\nspeedup = por llamada / equipo\n";
+    cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo adaptativo: calibra (o lee del caché) los umbrales de suma() y, para
+// cada N del barrido, compara la ruta elegida contra las tres rutas fijas.
+// ===============================
+template <typename T>
+int ejecutaAdaptativo(const Configuracion &cfg) {
+
+    const double t0 = omp_get_wtime();
+    const DespachadorSuma<T> &despachador = configuraDespachador<T>(cfg);
+    const double t_calibracion = omp_get_wtime() - t0;
+    const UmbralesSuma &u = despachador.umbrales();
+
+    auto textoUmbral = [](long long v) { return v == LLONG_MAX ? string("nunca") : to_string(v); };
+    cout << "Despachador adaptativo (tipo=" << nombreTipo<T>() << ", chunk=" << cfg.chunk
+         << ", hilos=" << omp_get_max_threads() << ", simd=" << varianteSimd<T>().nombre << ")\n";
+    cout << "Umbrales " << (u.desde_cache ? "leidos de " : "calibrados y guardados en ")
+         << rutaCacheUmbrales(cfg) << " (" << fixed << setprecision(3) << t_calibracion << " s)\n";
+    cout << "  simd desde N = " << textoUmbral(u.simd)
+         << ", paralela desde N = " << textoUmbral(u.paralelo) << "\n\n";
+
+    const long long n_max = *max_element(cfg.barrido_n.begin(), cfg.barrido_n.end());
+    BufferAlineado<T> bufA(n_max, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(n_max, cfg.paginas_grandes);
+    BufferAlineado<T> bufC(n_max, cfg.paginas_grandes);
+    BufferAlineado<T> bufR(n_max, cfg.paginas_grandes);
+    T *A = bufA.data();
+    T *B = bufB.data();
+    T *C = bufC.data();
+    T *R = bufR.data();
+    inicializaArreglosParalelo(A, B, n_max, cfg.chunk, cfg.semilla);
+    sumaSecuencial(A, B, R, n_max);
+
+    cout << right << setw(10) << "N" << setw(12) << "secuencial" << setw(12) << "simd"
+         << setw(12) << "paralela" << setw(12) << "suma()" << "  ruta       mejor\n";
+    bool correcto = true;
+    Informe informe(cfg, nombreTipo<T>(), varianteSimd<T>().nombre);
+    const char *nombres[4] = {"secuencial", "simd", "paralela", "suma()"};
+    for (long long n : cfg.barrido_n) {
+        // Lote de llamadas para que cada muestra cubra ~1e7 elementos
+        const long long llamadas = max(1LL, 10000000LL / n);
+        const FuncionSumaT<T> simd = varianteSimd<T>().funcion;
+        const double bytes = 3.0 * sizeof(T) * n * llamadas;   // Por muestra (lote entero)
+        double us[4];
+        for (int v = 0; v < 4; v++) {
+            fill(C, C + n, T(0));
+            const int hilos = v == 2 || (v == 3 && despachador.elige(n) == RutaSuma::Paralela)
+                                  ? omp_get_max_threads() : 1;
+            Estadisticas e = informe.mide(nombres[v], n, hilos, bytes, [&] {
+                for (long long k = 0; k < llamadas; k++) {
+                    switch (v) {
+                        case 0: sumaSecuencial(A, B, C, n); break;
+                        case 1: simd(A, B, C, n); break;
+                        case 2: sumaParalelaCon(simd, A, B, C, n, cfg.chunk); break;
+                        default: suma(A, B, C, n); break;
+                    }
+                }
+            }, cfg.calentamiento, cfg.repeticiones);
+            us[v] = e.mediana * 1000.0 / llamadas;
+            if (!equal(C, C + n, R)) {
+                cout << "  [ERROR] ruta " << v << " (N=" << n << ") no coincide con la referencia\n";
+                correcto = false;
+            }
+        }
+        const int mejor = static_cast<int>(min_element(us, us + 3) - us);
+        cout << setw(10) << n << fixed << setprecision(3) << setw(12) << us[0] << setw(12) << us[1]
+             << setw(12) << us[2] << setw(12) << us[3] << "  " << left << setw(11)
+             << nombreRuta(despachador.elige(n)) << nombreRuta(static_cast<RutaSuma>(mejor))
+             << right << "\n";
+    }
+    cout << "\nus por llamada (mediana de " << cfg.repeticiones << " muestras)\n";
+    if (!cfg.informe.empty()) {
+        informe.escribe(cfg.informe);
+        cout << "Informe: " << cfg.informe << " (" << informe.mediciones() << " mediciones; ms por lote)\n";
+    }
+    cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo robo: latencia de cola (p95/p99) de schedule(static, chunk) contra
+// dynamic, taskloop y el planificador Chase–Lev. El segundo escenario corre
+// "antagonistas" hilos de espera activa fuera de OpenMP durante la medición,
+// como un vecino ruidoso que desaloja núcleos en una VM compartida.
+// ===============================
+template <typename T>
+int ejecutaRobo(const Configuracion &cfg) {
+
+    const long long N = cfg.n;
+    const long long grano = granoRobo(N, cfg.chunk, cfg.grano, omp_get_max_threads());
+    BufferAlineado<T> bufA(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufC(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufR(N, cfg.paginas_grandes);
+    T *A = bufA.data();
+    T *B = bufB.data();
+    T *C = bufC.data();
+    T *R = bufR.data();
+    inicializaArreglosParalelo(A, B, N, cfg.chunk, cfg.semilla);
+    sumaSecuencial(A, B, R, N);
+
+    cout << "Robo de trabajo (N=" << N << ", tipo=" << nombreTipo<T>() << ", chunk=" << cfg.chunk
+         << ", grano=" << grano << ", hilos=" << omp_get_max_threads() << ")\n";
+    if (cfg.repeticiones < 100) {
+        cout << "Aviso: con " << cfg.repeticiones << " repeticiones el p99 es el maximo;"
+             << " use --repeticiones=200 o mas\n";
+    }
+
+    bool correcto = true;
+    const char *nombres[4] = {"static", "dynamic", "taskloop", "chase-lev"};
+    for (int antagonistas : {0, cfg.antagonistas}) {
+        atomic<bool> activo{true};
+        vector<thread> ruido;
+        for (int k = 0; k < antagonistas; k++) {
+            ruido.emplace_back([&activo] {
+                while (activo.load(memory_order_relaxed)) pausaCpu();
+            });
+        }
+
+        cout << "\nEscenario: " << (antagonistas == 0 ? string("sin interferencia")
+                                    : to_string(antagonistas) + " hilo(s) antagonista(s)") << "\n";
+        cout << left << setw(12) << "backend" << right << setw(12) << "mediana" << setw(12) << "p95"
+             << setw(12) << "p99" << setw(12) << "p99/static" << setw(10) << "robos" << "\n";
+        double p99_static = 0.0;
+        for (int v = 0; v < 4; v++) {
+            ContadoresRobo contadores;
+            fill(C, C + N, T(0));
+            if (v == 1) aplicaPlanificacion("dynamic", grano);
+            Estadisticas e = mide([&] {
+                switch (v) {
+                    case 0: sumaParalela(A, B, C, N, cfg.chunk); break;
+                    case 1: sumaParalelaRuntime(A, B, C, N); break;
+                    case 2: sumaTaskloop(A, B, C, N, grano); break;
+                    default: sumaRobo(A, B, C, N, grano, &contadores); break;
+                }
+            }, cfg.calentamiento, cfg.repeticiones);
+            if (v == 0) p99_static = e.p99;
+            if (!equal(C, C + N, R)) {
+                cout << "  [ERROR] " << nombres[v] << " no coincide con la referencia\n";
+                correcto = false;
+            }
+            const int llamadas = cfg.calentamiento + cfg.repeticiones;
+            cout << left << setw(12) << nombres[v] << right << fixed << setprecision(4)
+                 << setw(12) << e.mediana << setw(12) << e.p95 << setw(12) << e.p99
+                 << setprecision(2) << setw(12) << e.p99 / p99_static << setw(10);
+            if (v == 3) cout << setprecision(1) << static_cast<double>(contadores.robos) / llamadas;
+            else cout << "-";
+            cout << "\n";
+        }
+        aplicaPlanificacion(cfg.schedule, cfg.chunk);
+
+        activo.store(false);
+        for (thread &t : ruido) t.join();
+        if (cfg.antagonistas == 0) break;
+    }
+    cout << "\nTiempos en ms; robos = promedio por llamada\n";
+    cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo dispositivo: para cada N del barrido compara el paralelo en el host
+// contra la descarga al acelerador:
+//  - completa: copia A y B, núcleo y copia C de vuelta (fases por separado)
+//  - pipeline: lo mismo por bloques solapados
+//  - residente: solo el núcleo, con los datos ya en el dispositivo
+// La N de cruce es la primera desde la cual completa o pipeline gana al host.
+// ===============================
+template <typename T>
+int ejecutaDispositivo(const Configuracion &cfg) {
+
+    const int dispositivo = omp_get_default_device();
+    cout << "Descarga al acelerador (tipo=" << nombreTipo<T>() << ", dispositivo=" << dispositivo
+         << " de " << numeroDispositivos() << ", bloque=" << cfg.bloque_dispositivo << ")\n";
+    if (numeroDispositivos() == 0) {
+        cout << "Aviso: sin dispositivos, las regiones target corren en el host\n";
+    }
+
+    const long long n_max = *max_element(cfg.barrido_n.begin(), cfg.barrido_n.end());
+    BufferAlineado<T> bufA(n_max, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(n_max, cfg.paginas_grandes);
+    BufferAlineado<T> bufC(n_max, cfg.paginas_grandes);
+    BufferAlineado<T> bufR(n_max, cfg.paginas_grandes);
+    T *A = bufA.data();
+    T *B = bufB.data();
+    T *C = bufC.data();
+    T *R = bufR.data();
+    inicializaArreglosParalelo(A, B, n_max, cfg.chunk, cfg.semilla);
+    sumaSecuencial(A, B, R, n_max);
+
+    bool correcto = true;
+    auto verifica = [&](const char *nombre, long long n) {
+        if (!equal(C, C + n, R)) {
+            cout << "  [ERROR] " << nombre << " (N=" << n << ") no coincide con la referencia\n";
+            correcto = false;
+        }
+    };
+
+    cout << "\n" << right << setw(10) << "N" << setw(10) << "host" << setw(10) << "ida"
+         << setw(10) << "nucleo" << setw(10) << "vuelta" << setw(10) << "completa"
+         << setw(10) << "pipeline" << setw(11) << "residente" << setw(10) << "GB/s" << "\n";
+    long long cruce = -1, cruce_residente = -1;
+    for (long long n : cfg.barrido_n) {
+        fill(C, C + n, T(0));
+        Estadisticas host = mide([&] { sumaParalela(A, B, C, n, cfg.chunk); },
+                                 cfg.calentamiento, cfg.repeticiones);
+        verifica("host", n);
+
+        // Fases de la descarga completa, cada una con su propia serie
+        vector<double> ida, nucleo, vuelta, total;
+        fill(C, C + n, T(0));
+        for (int r = 0; r < cfg.calentamiento + cfg.repeticiones; r++) {
+            TiemposDispositivo t = sumaDispositivo(A, B, C, n, dispositivo);
+            if (r < cfg.calentamiento) continue;
+            ida.push_back(t.ida);
+            nucleo.push_back(t.nucleo);
+            vuelta.push_back(t.vuelta);
+            total.push_back(t.total());
+        }
+        verifica("completa", n);
+
+        fill(C, C + n, T(0));
+        Estadisticas pipeline = mide([&] {
+            sumaDispositivoPipeline(A, B, C, n, cfg.bloque_dispositivo, dispositivo);
+        }, cfg.calentamiento, cfg.repeticiones);
+        verifica("pipeline", n);
+
+        fill(C, C + n, T(0));
+        entraDispositivo(A, B, C, n, dispositivo);
+        Estadisticas residente = mide([&] { sumaDispositivoResidente(A, B, C, n, dispositivo); },
+                                      cfg.calentamiento, cfg.repeticiones);
+        saleDispositivo(A, B, C, n, dispositivo);
+        verifica("residente", n);
+
+        const double t_completa = calculaEstadisticas(total).mediana;
+        if (cruce < 0 && min(t_completa, pipeline.mediana) < host.mediana) cruce = n;
+        if (cruce_residente < 0 && residente.mediana < host.mediana) cruce_residente = n;
+        const double bytes = 2.0 * sizeof(T) * n;   // A y B de ida
+        cout << setw(10) << n << fixed << setprecision(4) << setw(10) << host.mediana
+             << setw(10) << calculaEstadisticas(ida).mediana
+             << setw(10) << calculaEstadisticas(nucleo).mediana
+             << setw(10) << calculaEstadisticas(vuelta).mediana << setw(10) << t_completa
+             << setw(10) << pipeline.mediana << setw(11) << residente.mediana << setprecision(2)
+             << setw(10);
+        if (numeroDispositivos() > 0) cout << gbPorSegundo(bytes, calculaEstadisticas(ida).mediana);
+        else cout << "-";   // Sin dispositivo no hay copia real
+        cout << "\n";
+    }
+    cout << "\nms por llamada (mediana); GB/s = copia host->device\n";
+    cout << "Cruce con copias: " << (cruce < 0 ? string("no se alcanza en el barrido") : "N = " + to_string(cruce))
+         << "\nCruce con datos residentes: "
+         << (cruce_residente < 0 ? string("no se alcanza en el barrido") : "N = " + to_string(cruce_residente)) << "\n";
+    cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Una fila del escalado distribuido: "n_global" elementos repartidos entre
+// los primeros "procesos" rangos. Devuelve la mediana (ms) del proceso más
+// lento; "correcto" queda en falso si las huellas reducidas no coinciden.
+// ===============================
+template <typename T>
+double mideDistribuido(const Configuracion &cfg, int procesos, long long n_global, bool &correcto) {
+    GrupoMpi grupo(procesos);
+    if (!grupo.activo()) return 0.0;
+
+    const Tramo t = tramoLocal(n_global, grupo.rango(), procesos);
+    BufferAlineado<T> bufA(t.cantidad, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(t.cantidad, cfg.paginas_grandes);
+    BufferAlineado<T> bufC(t.cantidad, cfg.paginas_grandes);
+    T *A = bufA.data();
+    T *B = bufB.data();
+    T *C = bufC.data();
+    inicializaTramoParalelo(A, B, t.inicio, t.cantidad, cfg.chunk, cfg.semilla);
+    ceroParalelo(C, t.cantidad, cfg.chunk);
+
+    vector<double> tiempos;
+    for (int r = 0; r < cfg.calentamiento + cfg.repeticiones; r++) {
+        grupo.barrera();
+        const double t0 = omp_get_wtime();
+        sumaParalela(A, B, C, t.cantidad, cfg.chunk);
+        const double ms = grupo.maximo((omp_get_wtime() - t0) * 1e3);
+        if (r >= cfg.calentamiento) tiempos.push_back(ms);
+    }
+
+    const uint64_t huella_c = grupo.sumaHuellas(checksumArreglo(C, t.cantidad, cfg.chunk, t.inicio));
+    const uint64_t huella_ref = grupo.sumaHuellas(checksumReferencia(A, B, t.cantidad, cfg.chunk, t.inicio));
+    if (huella_c != huella_ref) {
+        if (grupo.rango() == 0) {
+            cout << "  [ERROR] huella de C distinta de la referencia con " << procesos << " procesos\n";
+        }
+        correcto = false;
+    }
+    return calculaEstadisticas(tiempos).mediana;
+}
+
+// ===============================
+// Modo distribuido: escalado fuerte (N global fijo) y débil (N fijo por
+// proceso) con 1, 2, 4, ... procesos de los lanzados con mpirun. Cada
+// proceso usa el for de OpenMP con --hilos hilos sobre su tramo.
+// ===============================
+template <typename T>
+int ejecutaDistribuido(const Configuracion &cfg) {
+
+    const int procesos = procesosMpi();
+    const bool raiz = rangoMpi() == 0;
+    vector<int> grupos;
+    for (int p = 1; p < procesos; p *= 2) grupos.push_back(p);
+    grupos.push_back(procesos);
+
+    if (raiz) {
+        cout << "Suma distribuida MPI + OpenMP (N=" << cfg.n << ", tipo=" << nombreTipo<T>()
+             << ", procesos=" << procesos << ", hilos/proceso=" << omp_get_max_threads()
+             << ", semilla=" << cfg.semilla << ")\n";
+        if (!hayMpi()) cout << "Aviso: compilado sin SUMA_MPI, un solo proceso\n";
+    }
+
+    bool correcto = true;
+    for (int debil = 0; debil < 2; debil++) {
+        if (raiz) {
+            cout << "\nEscalado " << (debil ? "debil (N por proceso fijo)" : "fuerte (N global fijo)") << "\n";
+            cout << right << setw(9) << "procesos" << setw(14) << "N global" << setw(14) << "N/proceso"
+                 << setw(12) << "mediana" << setw(10) << "GB/s" << setw(10) << "speedup"
+                 << setw(11) << "eficiencia" << "\n";
+        }
+        double t_uno = 0.0;
+        for (int p : grupos) {
+            const long long n_global = debil ? cfg.n * p : cfg.n;
+            const double t = mideDistribuido<T>(cfg, p, n_global, correcto);
+            if (!raiz) continue;
+            if (p == 1) t_uno = t;
+            const double speedup = debil ? t_uno * p / t : t_uno / t;
+            cout << setw(9) << p << setw(14) << n_global << setw(14) << n_global / p
+                 << fixed << setprecision(4) << setw(12) << t << setprecision(2)
+                 << setw(10) << gbPorSegundo(3.0 * sizeof(T) * n_global, t)
+                 << setw(10) << speedup << setw(10) << 100.0 * speedup / p << "%\n";
+        }
+    }
+    if (raiz) {
+        cout << "\nms por repeticion (mediana del proceso mas lento); debil: speedup = p * t1 / tp\n";
+        cout << (correcto ? "\nVerificacion (huella reducida): Correcto\n"
+                          : "\nVerificacion (huella reducida): ERROR\n");
+    }
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modos archivo y flujo: si faltan A y B se generan ambos con N elementos.
+// Si falta solo uno es un error: regenerar el par pisaría la entrada que
+// sí dio el usuario.
+// ===============================
+template <typename T>
+void generaEntradasSiFaltan(const Configuracion &cfg, ostream &out) {
+    const bool hay_a = existeArchivo(cfg.entrada_a);
+    const bool hay_b = existeArchivo(cfg.entrada_b);
+    if (hay_a && hay_b) return;
+    if (hay_a || hay_b) {
+        throw runtime_error("falta la entrada " + (hay_a ? cfg.entrada_b : cfg.entrada_a) +
+                            " (" + (hay_a ? cfg.entrada_a : cfg.entrada_b) +
+                            " existe; no se regenera ninguna)");
+    }
+    ArchivoMapeado<T> a = ArchivoMapeado<T>::abreEscritura(cfg.entrada_a, cfg.n, true, false);
+    ArchivoMapeado<T> b = ArchivoMapeado<T>::abreEscritura(cfg.entrada_b, cfg.n, true, false);
+    inicializaArreglosParalelo(a.data(), b.data(), cfg.n, cfg.chunk, cfg.semilla);
+    a.sincroniza();
+    b.sincroniza();
+    out << "Entradas generadas: " << cfg.entrada_a << ", " << cfg.entrada_b << " (N=" << cfg.n
+        << ", semilla=" << cfg.semilla << ")\n";
+}
+
+// ===============================
+// Modo archivo: C = A + B sobre archivos mapeados.
+//  (0) Si faltan los dos archivos de entrada se generan con N elementos
+//  (1) Primera pasada en frío: suma + msync de C, con fallos de página
+//  (2) Pasadas siguientes (las páginas ya están en la caché del sistema)
+//  (3) Verificación por huella: C releída del mapeo contra A + B
+// ===============================
+template <typename T>
+int ejecutaArchivo(const Configuracion &cfg) {
+
+    const bool sec = cfg.mmap_secuencial;
+    const bool poblar = cfg.mmap_poblar;
+    generaEntradasSiFaltan<T>(cfg, cout);
+
+    FallosPagina f0 = fallosPagina();
+    const double t_abre0 = omp_get_wtime();
+    ArchivoMapeado<T> a = ArchivoMapeado<T>::abreLectura(cfg.entrada_a, sec, poblar);
+    ArchivoMapeado<T> b = ArchivoMapeado<T>::abreLectura(cfg.entrada_b, sec, poblar);
+    const long long N = static_cast<long long>(min(a.size(), b.size()));
+    if (a.size() != b.size()) {
+        cout << "Aviso: A y B tienen distinto largo; se usan los primeros " << N << " elementos\n";
+    }
+    ArchivoMapeado<T> c = ArchivoMapeado<T>::abreEscritura(cfg.salida, N, sec, poblar);
+    const double t_mapeo = omp_get_wtime() - t_abre0;
+    const FallosPagina f_mapeo = fallosPagina() - f0;
+
+    cout << "Arreglos mapeados desde archivo (N=" << N << ", tipo=" << nombreTipo<T>()
+         << ", hilos=" << omp_get_max_threads() << ")\n";
+    cout << "  A: " << cfg.entrada_a << "  B: " << cfg.entrada_b << "  C: " << cfg.salida << "\n";
+    cout << "  madvise(MADV_SEQUENTIAL): " << (sec ? "si" : "no")
+         << ", MAP_POPULATE: " << (poblar ? "si" : "no") << "\n";
+
+    const T *A = a.data();
+    const T *B = b.data();
+    T *C = c.data();
+    const double bytes_leidos = 2.0 * sizeof(T) * N;
+    const double bytes_escritos = 1.0 * sizeof(T) * N;
+
+    f0 = fallosPagina();
+    const double t0 = omp_get_wtime();
+    sumaParalela(A, B, C, N, cfg.chunk);
+    const double t1 = omp_get_wtime();
+    c.sincroniza();
+    const double t2 = omp_get_wtime();
+    const FallosPagina f_fria = fallosPagina() - f0;
+
+    auto gb = [](double bytes, double s) { return s > 0.0 ? bytes / s / 1e9 : 0.0; };
+    cout << fixed << setprecision(3);
+    cout << "\nMapeo:            " << setw(10) << t_mapeo * 1e3 << " ms, fallos " << f_mapeo.menores
+         << " menores / " << f_mapeo.mayores << " mayores\n";
+    cout << "Primera pasada:   " << setw(10) << (t1 - t0) * 1e3 << " ms suma + " << (t2 - t1) * 1e3
+         << " ms msync, fallos " << f_fria.menores << " menores / " << f_fria.mayores << " mayores\n";
+    cout << setprecision(2);
+    cout << "  E/S efectiva:   lectura " << gb(bytes_leidos, t2 - t0) << " GB/s, escritura "
+         << gb(bytes_escritos, t2 - t0) << " GB/s, total " << gb(bytes_leidos + bytes_escritos, t2 - t0)
+         << " GB/s\n";
+
+    f0 = fallosPagina();
+    Estadisticas e = mide([&] { sumaParalela(A, B, C, N, cfg.chunk); }, 0, cfg.repeticiones);
+    const FallosPagina f_caliente = fallosPagina() - f0;
+    cout << "Pasadas en cache: " << setprecision(3) << setw(10) << e.mediana << " ms (mediana de "
+         << cfg.repeticiones << "), " << setprecision(2)
+         << gbPorSegundo(bytes_leidos + bytes_escritos, e.mediana) << " GB/s, fallos "
+         << f_caliente.menores / cfg.repeticiones << " menores / "
+         << f_caliente.mayores / cfg.repeticiones << " mayores por pasada\n";
+    c.sincroniza();
+
+    const bool correcto = checksumArreglo(C, N, cfg.chunk) == checksumReferencia(A, B, N, cfg.chunk);
+    cout << (correcto ? "\nVerificacion (checksum): Correcto\n" : "\nVerificacion (checksum): ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo flujo: la tubería de flujo.hpp sobre archivos o stdin/stdout.
+//  - --entrada-a=- lee de stdin A y B intercalados por bloque
+//  - --salida=- escribe C en stdout (el reporte va entonces a stderr)
+// Se reporta el tiempo ocupado por etapa: si la tubería solapa bien, el
+// total se acerca al de la etapa más lenta y no a la suma de las tres.
+// ===============================
+template <typename T>
+int ejecutaFlujo(const Configuracion &cfg) {
+
+    ostream &out = cfg.salida == "-" ? cerr : cout;
+    const bool por_stdin = cfg.entrada_a == "-";
+    if (!por_stdin) generaEntradasSiFaltan<T>(cfg, out);
+
+    const ResultadoFlujo r = sumaEnFlujo<T>(cfg.entrada_a, por_stdin ? string() : cfg.entrada_b,
+                                            cfg.salida, cfg.chunk, cfg.chunks_bloque, cfg.ranuras, true);
+
+    const double bytes = 3.0 * sizeof(T) * r.n;
+    out << "Tuberia por bloques (tipo=" << nombreTipo<T>() << ", chunk=" << cfg.chunk
+        << ", bloque=" << cfg.chunk * cfg.chunks_bloque << " elementos, ranuras=" << cfg.ranuras
+        << ", hilos=" << omp_get_max_threads() << ")\n";
+    out << "  Entrada: " << (por_stdin ? string("stdin (A y B por bloque)")
+                                       : cfg.entrada_a + " + " + cfg.entrada_b)
+        << "  Salida: " << (cfg.salida == "-" ? string("stdout") : cfg.salida) << "\n";
+    out << "  N=" << r.n << " en " << r.bloques << " bloques, memoria de ranuras "
+        << fixed << setprecision(1) << r.memoria / 1048576.0 << " MiB\n\n";
+    out << setprecision(3);
+    out << "Total:     " << setw(10) << r.total * 1e3 << " ms, " << setprecision(2)
+        << (r.total > 0 ? bytes / r.total / 1e9 : 0.0) << " GB/s (A+B leidos, C escrito)\n";
+    out << setprecision(3);
+    out << "Lector:    " << setw(10) << r.lector * 1e3 << " ms ocupado\n";
+    out << "Computo:   " << setw(10) << r.computo * 1e3 << " ms ocupado, "
+        << r.espera_computo * 1e3 << " ms esperando al lector\n";
+    out << "Escritor:  " << setw(10) << r.escritor * 1e3 << " ms ocupado\n";
+    const double suma_etapas = r.lector + r.computo + r.escritor;
+    out << setprecision(2) << "Solape:    " << setw(10)
+        << (r.total > 0 ? suma_etapas / r.total : 0.0) << "x (suma de etapas / total)\n";
+
+    const bool correcto = r.huella_c == r.huella_ref;
+    out << (correcto ? "\nVerificacion (checksum por bloque): Correcto\n"
+                     : "\nVerificacion (checksum por bloque): ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo roofline:
+//  (1) Sondas: ancho de banda sostenible (triada STREAM) y pico de sumas,
+//      con 1 hilo (por núcleo), con el equipo completo y con cada número de
+//      hilos del barrido
+//  (2) Cada variante de la suma y de la familia de operaciones en el
+//      roofline a N = --n: intensidad aritmética, GB/s y % del techo
+//  (3) C_par (sumaParalela) para cada N y hilos: % del techo con esos hilos y
+//      del techo del nodo, y a partir de cuántos hilos deja de escalar
+// ===============================
+template <typename T>
+int ejecutaRoofline(const Configuracion &cfg) {
+
+    const int hilos_originales = omp_get_max_threads();
+    // Siempre 1 hilo (techo por núcleo) y el máximo (techo del nodo)
+    vector<int> hilos = {1, hilos_originales};
+    if (cfg.barrido_hilos.empty()) {
+        for (int h = 2; h < hilos_originales; h *= 2) hilos.push_back(h);
+    } else {
+        for (long long h : cfg.barrido_hilos) hilos.push_back(static_cast<int>(h));
+    }
+    sort(hilos.begin(), hilos.end());
+    hilos.erase(unique(hilos.begin(), hilos.end()), hilos.end());
+
+    const long long n_sonda = elementosSonda(cfg.n_sonda);
+    const vector<SondaRoofline> sondas = sondeaRoofline<T>(hilos, cfg.n_sonda, cfg.chunk,
+                                                           cfg.repeticiones, cfg.paginas_grandes);
+    auto sonda = [&](int h) -> const SondaRoofline & {
+        for (const SondaRoofline &s : sondas) if (s.hilos == h) return s;
+        return sondas.back();
+    };
+    const SondaRoofline &nucleo = sonda(1);
+    const SondaRoofline &nodo = sonda(hilos_originales);
+    const long long llc = tamanoLLC();
+
+    cout << "Roofline (tipo=" << nombreTipo<T>() << ", chunk=" << cfg.chunk
+         << ", hilos=" << hilos_originales << ", LLC=" << llc / 1048576 << " MiB)\n";
+    cout << "Sondas: triada STREAM en double con " << n_sonda << " elementos por arreglo ("
+         << fixed << setprecision(0) << 3.0 * sizeof(double) * n_sonda / 1048576.0
+         << " MiB), pico de sumas en " << nombreTipo<T>() << "; mejor de "
+         << cfg.repeticiones << "\n";
+    cout << setw(7) << "hilos" << setw(10) << "GB/s" << setw(12) << "GB/s/hilo"
+         << setw(10) << "Gops/s" << setw(14) << "quiebre op/B" << "\n";
+    for (const SondaRoofline &s : sondas) {
+        cout << setw(7) << s.hilos << fixed << setprecision(2) << setw(10) << s.gb_s
+             << setw(12) << s.gb_s / s.hilos << setw(10) << s.gops_s
+             << setprecision(3) << setw(14) << s.quiebre() << "\n";
+    }
+
+    // ===============================
+    // (2) Variantes a N = --n
+    // ===============================
+    omp_set_num_threads(hilos_originales);
+    const long long N = cfg.n;
+    BufferAlineado<T> bufA(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufC(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufD(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufR(N, cfg.paginas_grandes);
+    const T *A = bufA.data();
+    const T *B = bufB.data();
+    const T *Z = bufC.data();
+    T *D = bufD.data();
+    T *R = bufR.data();
+    inicializaArreglosParalelo(bufA.data(), bufB.data(), N, cfg.chunk, cfg.semilla);
+    inicializaArregloParalelo(bufC.data(), N, cfg.chunk, cfg.semilla);
+    ceroParalelo(D, N, cfg.chunk);
+    const T s = T(3);
+    bool correcto = true;
+
+    cout << "\nVariantes en el roofline (N=" << N << ", GB/s y Gops/s por mediana; techo = "
+         << "min(pico, AI x GB/s) con los hilos de la variante)\n";
+    cout << left << setw(16) << "variante" << right << setw(6) << "hilos" << setw(9) << "AI op/B"
+         << setw(10) << "GB/s" << setw(10) << "Gops/s" << setw(10) << "techo" << setw(9) << "% techo"
+         << "  limite\n";
+    auto fila = [&](const char *nombre, const SondaRoofline &techo, int operaciones, int accesos,
+                    auto &&kernel, auto &&referencia) {
+        referencia();
+        fill(D, D + N, T(0));
+        Estadisticas e = mide(kernel, cfg.calentamiento, cfg.repeticiones);
+        if (!equal(D, D + N, R)) {
+            cout << "  [ERROR] " << nombre << " no coincide con la referencia\n";
+            correcto = false;
+        }
+        const double ai = intensidadAritmetica<T>(operaciones, accesos);
+        const double bytes = static_cast<double>(accesos) * sizeof(T) * N;
+        const double gops = elementosPorSegundo(static_cast<double>(operaciones) * N, e.mediana) * 1.0e-9;
+        const double cota = techo.techo(ai);
+        // Por encima del 100%: restos en caché, stores sin RFO o ruido de la sonda
+        const char *limite = bytes < llc ? "cabe en LLC"
+                             : gops > cota ? "sobre el techo"
+                             : ai < techo.quiebre() ? "memoria" : "computo";
+        cout << left << setw(16) << nombre << right << setw(6) << techo.hilos << fixed
+             << setprecision(4) << setw(9) << ai << setprecision(2)
+             << setw(10) << gbPorSegundo(bytes, e.mediana) << setw(10) << gops
+             << setw(10) << cota << setprecision(1) << setw(8) << 100.0 * gops / cota << "%"
+             << "  " << limite << "\n";
+    };
+    auto refSuma = [&] { sumaSecuencial(A, B, R, N); };
+    const int op_suma = OpSuma::operaciones, ac_suma = OpSuma::accesos;
+    fila("seq", nucleo, op_suma, ac_suma, [&] { sumaSecuencial(A, B, D, N); }, refSuma);
+    fila("simd", nucleo, op_suma, ac_suma, [&] { sumaSimd(A, B, D, N); }, refSuma);
+    fila("omp (C_par)", nodo, op_suma, ac_suma, [&] { sumaParalela(A, B, D, N, cfg.chunk); }, refSuma);
+    fila("omp+simd", nodo, op_suma, ac_suma, [&] {
+        opParalelaSimd<OpSuma>(D, A, B, Z, s, N, cfg.chunk);
+    }, refSuma);
+    fila("stream", nodo, op_suma, ac_suma, [&] { sumaParalelaStream(A, B, D, N, cfg.chunk); }, refSuma);
+    fila("triada", nodo, OpTriada::operaciones, OpTriada::accesos, [&] {
+        opParalelaSimd<OpTriada>(D, A, B, Z, s, N, cfg.chunk);
+    }, [&] { opSecuencial<OpTriada>(R, A, B, Z, s, N); });
+    fila("suma3", nodo, OpSuma3::operaciones, OpSuma3::accesos, [&] {
+        opParalelaSimd<OpSuma3>(D, A, B, Z, s, N, cfg.chunk);
+    }, [&] { opSecuencial<OpSuma3>(R, A, B, Z, s, N); });
+    fila("escsuma", nodo, OpEscalaSuma::operaciones, OpEscalaSuma::accesos, [&] {
+        opParalelaSimd<OpEscalaSuma>(D, A, B, Z, s, N, cfg.chunk);
+    }, [&] { opSecuencial<OpEscalaSuma>(R, A, B, Z, s, N); });
+
+    // ===============================
+    // (3) C_par para cada N y número de hilos
+    // ===============================
+    const double ai_suma = intensidadAritmetica<T>(op_suma, ac_suma);
+    cout << "\nC_par (sumaParalela) contra el techo (AI=" << setprecision(4) << ai_suma
+         << " op/B; techo de los mismos hilos y del nodo con " << hilos_originales << ")\n";
+    cout << setw(12) << "N" << setw(7) << "hilos" << setw(12) << "T_par" << setw(10) << "GB/s"
+         << setw(12) << "% techo(h)" << setw(13) << "% techo nodo" << setw(10) << "vs h-1" << "\n";
+
+    vector<pair<long long, int>> saturacion;   // (N, hilos con los que satura)
+    for (long long n : cfg.barrido_n) {
+        BufferAlineado<T> bufX(n, cfg.paginas_grandes);
+        BufferAlineado<T> bufY(n, cfg.paginas_grandes);
+        BufferAlineado<T> bufZ(n, cfg.paginas_grandes);
+        T *X = bufX.data();
+        T *Y = bufY.data();
+        T *C_par = bufZ.data();
+        inicializaArreglosParalelo(X, Y, n, cfg.chunk, cfg.semilla);
+
+        const double bytes = 3.0 * sizeof(T) * n;
+        vector<double> gb(hilos.size());
+        for (size_t j = 0; j < hilos.size(); j++) {
+            omp_set_num_threads(hilos[j]);
+            Estadisticas e = mide([&] { sumaParalela(X, Y, C_par, n, cfg.chunk); },
+                                  cfg.calentamiento, cfg.repeticiones);
+            gb[j] = gbPorSegundo(bytes, e.mediana);
+            const double gops = gb[j] * ai_suma;
+            cout << setw(12) << n << setw(7) << hilos[j] << fixed << setprecision(4)
+                 << setw(12) << e.mediana << setprecision(2) << setw(10) << gb[j]
+                 << setprecision(1) << setw(11) << 100.0 * gops / sonda(hilos[j]).techo(ai_suma) << "%"
+                 << setw(12) << 100.0 * gops / nodo.techo(ai_suma) << "%";
+            if (j > 0) cout << setprecision(2) << setw(9) << gb[j] / gb[j - 1] << "x";
+            cout << "\n";
+        }
+        // Satura: menor número de hilos que ya logra el 90% del mejor GB/s
+        const double mejor = *max_element(gb.begin(), gb.end());
+        size_t j = 0;
+        while (gb[j] < 0.9 * mejor) j++;
+        saturacion.emplace_back(n, hilos[j]);
+    }
+
+    cout << "\nHilos a partir de los cuales C_par deja de escalar (>= 90% del mejor GB/s):\n";
+    for (const auto &[n, h] : saturacion) {
+        cout << "  N=" << setw(10) << n << ": " << setw(3) << h << " hilos";
+        if (3.0 * sizeof(T) * n < llc) cout << "  (cabe en LLC: el techo de DRAM no aplica)";
+        else if (h < hilos.back()) cout << "  (mas nucleos no agregan ancho de banda)";
+        cout << "\n";
+    }
+
+    omp_set_num_threads(hilos_originales);
+    cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo comparticion: penalización por compartición falsa en C_par
+//  - Para cada chunk, schedule(static, chunk) tal cual (límites a mitad de
+//    línea) contra la partición alineada a línea y a página (particion.hpp)
+//  - Con N chicas (en L1/L2) domina la coherencia entre núcleos, no la DRAM,
+//    y la penalización se ve más clara
+// ===============================
+template <typename T>
+int ejecutaComparticion(const Configuracion &cfg) {
+
+    const long long N = cfg.n;
+    vector<long long> chunks = cfg.barrido_chunk;
+    if (chunks.empty()) chunks = {1, 3, 10, 100, cfg.chunk};
+    sort(chunks.begin(), chunks.end());
+    chunks.erase(unique(chunks.begin(), chunks.end()), chunks.end());
+
+    BufferAlineado<T> bufA(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufC(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufR(N, cfg.paginas_grandes);
+    const T *A = bufA.data();
+    const T *B = bufB.data();
+    T *C = bufC.data();
+    inicializaArreglosParalelo(bufA.data(), bufB.data(), N, cfg.chunk, cfg.semilla);
+    ceroParalelo(C, N, cfg.chunk);
+    sumaSecuencial(A, B, bufR.data(), N);
+    bool correcto = true;
+
+    const int hilos = omp_get_max_threads();
+    cout << "Comparticion falsa en C_par (N=" << N << ", tipo=" << nombreTipo<T>()
+         << ", hilos=" << hilos << ", linea=" << lineaCache() << " B, pagina="
+         << tamanoPagina() << " B)\n";
+    if (hilos == 1) cout << "  Con 1 hilo no hay lineas compartidas: la penalizacion debe ser ~1x\n";
+    cout << "Medianas en ms; 'lim/2' = limites de bloque a mitad de linea\n\n";
+    cout << setw(8) << "chunk" << setw(8) << "lim/2" << setw(11) << "T_actual"
+         << setw(9) << "linea" << setw(11) << "T_linea" << setw(9) << "penal."
+         << setw(9) << "pagina" << setw(8) << "cabeza" << setw(11) << "T_pagina" << "\n";
+
+    auto verifica = [&](const char *nombre, long long chunk) {
+        if (!equal(C, C + N, bufR.data())) {
+            cout << "  [ERROR] " << nombre << " (chunk=" << chunk << ") no coincide con la referencia\n";
+            correcto = false;
+        }
+    };
+    for (long long chunk : chunks) {
+        const Particion actual = particiona(C, N, chunk, AlineacionChunk::Ninguna);
+        const Particion linea = particiona(C, N, chunk, AlineacionChunk::Linea);
+        const Particion pagina = particiona(C, N, chunk, AlineacionChunk::Pagina);
+
+        fill(C, C + N, T(0));
+        Estadisticas e_actual = mide([&] { sumaParalela(A, B, C, N, chunk); },
+                                     cfg.calentamiento, cfg.repeticiones);
+        verifica("actual", chunk);
+        fill(C, C + N, T(0));
+        Estadisticas e_linea = mide([&] { sumaParticionada(A, B, C, linea); },
+                                    cfg.calentamiento, cfg.repeticiones);
+        verifica("linea", chunk);
+        fill(C, C + N, T(0));
+        Estadisticas e_pagina = mide([&] { sumaParticionada(A, B, C, pagina); },
+                                     cfg.calentamiento, cfg.repeticiones);
+        verifica("pagina", chunk);
+
+        cout << setw(8) << chunk << setw(8) << limitesCompartidos(C, actual) << fixed
+             << setprecision(4) << setw(11) << e_actual.mediana << setw(9) << linea.chunk
+             << setw(11) << e_linea.mediana << setprecision(2) << setw(8)
+             << e_actual.mediana / e_linea.mediana << "x" << setw(9) << pagina.chunk
+             << setw(8) << pagina.cabeza << setprecision(4) << setw(11) << e_pagina.mediana << "\n";
+    }
+
+    cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo teselas: la cadena suma -> huella -> escala -> suma de teselas.hpp
+// en pasadas completas, por teselas del tamaño de la L2 y fusionada.
+// Las teselas se barren alrededor de --tesela para ver dónde deja de caber.
+// ===============================
+template <typename T>
+int ejecutaTeselas(const Configuracion &cfg) {
+
+    const long long N = cfg.n;
+    BufferAlineado<T> bufA(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufC(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufD(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufR(N, cfg.paginas_grandes);
+    const T *A = bufA.data();
+    const T *B = bufB.data();
+    const T *C = bufC.data();
+    T *D = bufD.data();
+    T *R = bufR.data();
+    inicializaArreglosParalelo(bufA.data(), bufB.data(), N, cfg.chunk, cfg.semilla);
+    inicializaArregloParalelo(bufC.data(), N, cfg.chunk, cfg.semilla);
+    ceroParalelo(D, N, cfg.chunk);
+    const T s = T(3);
+
+    // Referencia secuencial de la cadena
+    opSecuencial<OpSuma>(R, A, B, C, s, N);
+    const uint64_t h_ref = huellaTramo(R, N, 0);
+    opSecuencial<OpEscala>(R, static_cast<const T *>(R), B, C, s, N);
+    opSecuencial<OpSuma>(R, static_cast<const T *>(R), C, C, s, N);
+
+    bool correcto = true;
+    auto verifica = [&](const string &nombre, uint64_t h) {
+        if (h != h_ref || !equal(D, D + N, R)) {
+            cout << "  [ERROR] " << nombre << " no coincide con la referencia\n";
+            correcto = false;
+        }
+    };
+
+    const int hilos = omp_get_max_threads();
+    const double bytes = static_cast<double>(ACCESOS_CADENA) * sizeof(T) * N;
+    cout << "Cadena suma -> huella -> escala -> suma (N=" << N << ", tipo=" << nombreTipo<T>()
+         << ", hilos=" << hilos << ", L2=" << tamanoL2() / 1024 << " KiB, "
+         << ACCESOS_CADENA << " accesos/elemento)\n";
+    cout << "Medianas de " << cfg.repeticiones << " repeticiones\n\n";
+
+    uint64_t h = 0;
+    Estadisticas e_pasadas = mide([&] { h = cadenaPasadas(A, B, C, D, s, N, cfg.chunk); },
+                                  cfg.calentamiento, cfg.repeticiones);
+    verifica("pasadas", h);
+    Estadisticas e_fusion = mide([&] { h = cadenaFusionada(A, B, C, D, s, N, cfg.chunk); },
+                                 cfg.calentamiento, cfg.repeticiones);
+    verifica("fusionada", h);
+    cout << fixed << setprecision(4)
+         << "Fusionada:         " << setw(10) << e_fusion.mediana << " ms  "
+         << setprecision(2) << gbPorSegundo(bytes, e_fusion.mediana) << " GB/s  "
+         << e_pasadas.mediana / e_fusion.mediana << "x (una pasada, limite de la fusion)\n\n";
+
+    // GB/s de cada etapa a partir de su tiempo medio por hilo
+    auto gbEtapas = [&](const EtapasCadena &e, double *gb) {
+        for (int k = 0; k < 4; k++) {
+            gb[k] = gbPorSegundo(static_cast<double>(ACCESOS_ETAPA[k]) * sizeof(T) * N,
+                                 1e3 * e.segundos[k]);
+        }
+    };
+    const EtapasCadena etapas_pasadas = mideEtapasPasadas(A, B, C, D, s, N, cfg.chunk, cfg.repeticiones);
+    const double resto_pasadas = etapas_pasadas.segundos[1] + etapas_pasadas.segundos[2]
+                               + etapas_pasadas.segundos[3];
+    double gb_pasadas[4];
+    gbEtapas(etapas_pasadas, gb_pasadas);
+
+    // Barrido de teselas alrededor de la elegida: de 1/16 a 16 veces
+    const long long base = elementosTesela<T>(cfg.tesela);
+    cout << "GB/s por etapa (tiempo medio por hilo); reuso = tiempo de las etapas 2-4 en pasadas /\n"
+         << "en teselas (> 1: la tesela sigue en cache entre etapas)\n";
+    cout << setw(10) << "tesela" << setw(10) << "KiB" << setw(8) << "% L2" << setw(11) << "ms"
+         << setw(9) << "GB/s" << setw(9) << "speedup" << setw(9) << "suma"
+         << setw(9) << "huella" << setw(9) << "escala" << setw(9) << "suma2" << setw(8) << "reuso" << "\n";
+    cout << setw(10) << "pasadas" << setw(10) << "-" << setw(8) << "-" << fixed << setprecision(4)
+         << setw(11) << e_pasadas.mediana << setprecision(2) << setw(9)
+         << gbPorSegundo(bytes, e_pasadas.mediana) << setw(9) << "1.00x";
+    for (double g : gb_pasadas) cout << setw(9) << g;
+    cout << setw(8) << "1.00" << "\n";
+    for (long long factor : {-16LL, -4LL, 1LL, 4LL, 16LL}) {
+        const long long pedida = factor > 0 ? base * factor : max(1LL, base / -factor);
+        const Particion p = particiona(D, N, pedida, AlineacionChunk::Linea);
+        Estadisticas e = mide([&] { h = cadenaTeselas(A, B, C, D, s, p); },
+                              cfg.calentamiento, cfg.repeticiones);
+        verifica("teselas de " + to_string(p.chunk), h);
+        const EtapasCadena etapas = mideEtapasTeselas(A, B, C, D, s, p, cfg.repeticiones);
+        double gb[4];
+        gbEtapas(etapas, gb);
+        const double resto = etapas.segundos[1] + etapas.segundos[2] + etapas.segundos[3];
+
+        const double kib = 4.0 * sizeof(T) * min(p.chunk, N) / 1024.0;
+        cout << setw(10) << p.chunk << fixed << setprecision(1) << setw(10) << kib
+             << setw(7) << 100.0 * kib * 1024.0 / tamanoL2() << "%" << setprecision(4)
+             << setw(11) << e.mediana << setprecision(2) << setw(9) << gbPorSegundo(bytes, e.mediana)
+             << setw(8) << e_pasadas.mediana / e.mediana << "x";
+        for (double g : gb) cout << setw(9) << g;
+        cout << setw(8) << (resto > 0.0 ? resto_pasadas / resto : 0.0) << "\n";
+    }
+
+    cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo arena: trabajos por lotes (cada N de --barrido-n, "repeticiones"
+// veces), cada uno con sus A, B, C_seq y C_par: inicializa, suma en serie
+// y en paralelo y verifica.
+//  (a) heap: cuatro BufferAlineado nuevos por trabajo
+//  (b) arena: una Arena reservada al inicio (ver arena.hpp) que entrega los
+//      cuatro arreglos a cada trabajo y se reinicia entre trabajos
+// Se reportan fallos de página y reservas de la preparación, de la primera
+// ronda (un trabajo por N) y del estado estable (las demás rondas).
+// ===============================
+template <typename T>
+int ejecutaArena(const Configuracion &cfg) {
+
+    // La primera ronda (una pasada por cada N) paga las reservas; las demás
+    // son el estado estable
+    const size_t ronda = cfg.barrido_n.size();
+    vector<long long> trabajos;
+    for (int r = 0; r < cfg.repeticiones; r++) {
+        trabajos.insert(trabajos.end(), cfg.barrido_n.begin(), cfg.barrido_n.end());
+    }
+    const long long n_max = *max_element(cfg.barrido_n.begin(), cfg.barrido_n.end());
+
+    bool correcto = true;
+    auto trabajo = [&](T *A, T *B, T *C_seq, T *C_par, long long n) {
+        inicializaArreglosParalelo(A, B, n, cfg.chunk, cfg.semilla);
+        sumaSecuencial(A, B, C_seq, n);
+        sumaParalela(A, B, C_par, n, cfg.chunk);
+        if (!equal(C_seq, C_seq + n, C_par)) {
+            cout << "  [ERROR] trabajo con N=" << n << ": C_seq y C_par no coinciden\n";
+            correcto = false;
+        }
+    };
+
+    // Fallos y tiempo de un tramo de la ejecución
+    struct Tramo {
+        FallosPagina fallos;
+        double ms = 0.0;
+        long asignaciones = 0;
+    };
+    auto imprime = [&](const char *variante, const char *etapa, const Tramo &t, long trabajos_tramo,
+                       const string &asignaciones) {
+        cout << left << setw(7) << variante << setw(14) << etapa << right << setw(9) << trabajos_tramo
+             << fixed << setprecision(3) << setw(12) << t.ms << setw(12);
+        if (trabajos_tramo > 0) cout << t.ms / trabajos_tramo;
+        else cout << "-";
+        cout << setw(12) << t.fallos.menores
+             << setw(9) << t.fallos.mayores << setw(14) << asignaciones << "\n";
+    };
+
+    cout << "Trabajos por lotes (tipo=" << nombreTipo<T>() << ", " << trabajos.size()
+         << " trabajos: cada N de --barrido-n x " << cfg.repeticiones << ", hilos="
+         << omp_get_max_threads() << ")\n";
+    cout << "Cada trabajo: A, B, C_seq y C_par; inicializa, suma en serie y en paralelo, verifica\n"
+         << "reservas: aligned_alloc (heap) o regiones nuevas pedidas al SO (arena)\n\n";
+    cout << left << setw(7) << "modo" << setw(14) << "etapa" << right << setw(9) << "trabajos"
+         << setw(12) << "ms" << setw(12) << "ms/trabajo" << setw(12) << "fallos min"
+         << setw(9) << "mayores" << setw(14) << "reservas" << "\n";
+
+    // (a) Heap: cuatro reservas y liberaciones por trabajo
+    {
+        Tramo primero, estable;
+        for (size_t k = 0; k < trabajos.size(); k++) {
+            Tramo &t = k < ronda ? primero : estable;
+            const FallosPagina f0 = fallosPagina();
+            const double t0 = omp_get_wtime();
+            const long long n = trabajos[k];
+            BufferAlineado<T> bufA(n, cfg.paginas_grandes), bufB(n, cfg.paginas_grandes);
+            BufferAlineado<T> bufC_seq(n, cfg.paginas_grandes), bufC_par(n, cfg.paginas_grandes);
+            trabajo(bufA.data(), bufB.data(), bufC_seq.data(), bufC_par.data(), n);
+            t.ms += (omp_get_wtime() - t0) * 1e3;
+            const FallosPagina df = fallosPagina() - f0;
+            t.fallos.menores += df.menores;
+            t.fallos.mayores += df.mayores;
+        }
+        imprime("heap", "1a ronda", primero, static_cast<long>(ronda), to_string(4 * ronda));
+        imprime("heap", "estable", estable, static_cast<long>(trabajos.size() - ronda),
+                to_string(4 * (trabajos.size() - ronda)));
+    }
+
+    // (b) Arena: una reserva al inicio para los cuatro arreglos de la N mayor
+    {
+        Tramo preparacion, primero, estable;
+        FallosPagina f0 = fallosPagina();
+        double t0 = omp_get_wtime();
+        Arena arena(4 * redondeaArriba(n_max * sizeof(T), ALINEACION), cfg.paginas_grandes);
+        if (cfg.arena_prefallar) arena.prefalla();
+        string error_mlock;
+        if (cfg.arena_mlock) error_mlock = arena.bloquea();
+        preparacion.ms = (omp_get_wtime() - t0) * 1e3;
+        preparacion.fallos = fallosPagina() - f0;
+        long asignaciones_previas = arena.asignacionesSistema();
+
+        for (size_t k = 0; k < trabajos.size(); k++) {
+            Tramo &t = k < ronda ? primero : estable;
+            f0 = fallosPagina();
+            t0 = omp_get_wtime();
+            const long long n = trabajos[k];
+            arena.reinicia();
+            T *A = arena.reserva<T>(n);
+            T *B = arena.reserva<T>(n);
+            T *C_seq = arena.reserva<T>(n);
+            T *C_par = arena.reserva<T>(n);
+            trabajo(A, B, C_seq, C_par, n);
+            t.ms += (omp_get_wtime() - t0) * 1e3;
+            const FallosPagina df = fallosPagina() - f0;
+            t.fallos.menores += df.menores;
+            t.fallos.mayores += df.mayores;
+            t.asignaciones += arena.asignacionesSistema() - asignaciones_previas;
+            asignaciones_previas = arena.asignacionesSistema();
+        }
+        imprime("arena", "preparacion", preparacion, 0, to_string(arena.asignacionesSistema()
+                                                                  - primero.asignaciones
+                                                                  - estable.asignaciones));
+        imprime("arena", "1a ronda", primero, static_cast<long>(ronda), to_string(primero.asignaciones));
+        imprime("arena", "estable", estable, static_cast<long>(trabajos.size() - ronda),
+                to_string(estable.asignaciones));
+
+        cout << "\nArena: " << nombreTipoMemoria(arena.tipo()) << ", " << setprecision(1)
+             << arena.capacidad() / 1048576.0 << " MiB, maximo en uso " << arena.maximoEnUso() / 1048576.0
+             << " MiB, prefallada " << (cfg.arena_prefallar ? "si" : "no") << ", mlock "
+             << (!cfg.arena_mlock ? "no" : arena.bloqueada() ? "si" : "fallo (" + error_mlock + ")")
+             << "\n";
+        if (estable.asignaciones == 0 && estable.fallos.menores + estable.fallos.mayores == 0) {
+            cout << "Estado estable sin asignaciones del SO ni fallos de pagina\n";
+        }
+    }
+
+    cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo lotes: --lote vectores cortos independientes de longitud n/2 .. 3n/2
+// (n = --n), cada uno en su propia memoria, sumados:
+//  (1) uno por uno con el for paralelo actual (una región por vector)
+//  (2) uno por uno en un hilo, con SIMD
+//  (3) sumaLote: paralelo entre vectores, SIMD dentro (ver lotes.hpp)
+//  (4) LoteSoA: empaquetados en estructura de arreglos, solo la suma
+//  (5) LoteSoA con empaquetado y desempaquetado incluidos
+// ===============================
+template <typename T>
+int ejecutaLotes(const Configuracion &cfg) {
+
+    const long long K = cfg.lote;
+    vector<long long> longitudes(K);
+    for (long long v = 0; v < K; v++) {
+        longitudes[v] = cfg.n / 2 + philox4x32(static_cast<uint64_t>(v), cfg.semilla)[0] % (cfg.n + 1);
+    }
+
+    // Cada vector en su propia memoria, como llegan de quien llama
+    vector<BufferAlineado<T>> fuentes;
+    vector<TernaVectores<T>> ternas;
+    fuentes.reserve(3 * K);
+    ternas.reserve(K);
+    vector<long long> inicio_ref(K + 1, 0);
+    for (long long v = 0; v < K; v++) inicio_ref[v + 1] = inicio_ref[v] + longitudes[v];
+    vector<T> referencia(inicio_ref[K]);
+    for (long long v = 0; v < K; v++) {
+        const long long n = longitudes[v];
+        fuentes.emplace_back(n);
+        fuentes.emplace_back(n);
+        fuentes.emplace_back(n);
+        T *A = fuentes[3 * v].data();
+        T *B = fuentes[3 * v + 1].data();
+        for (long long i = 0; i < n; i++) valoresEn(inicio_ref[v] + i, cfg.semilla, A[i], B[i]);
+        sumaSecuencial(A, B, referencia.data() + inicio_ref[v], n);
+        ternas.push_back({A, B, fuentes[3 * v + 2].data(), n});
+    }
+    const long long elementos = inicio_ref[K];
+
+    bool correcto = true;
+    auto limpia = [&] {
+        for (const TernaVectores<T> &t : ternas) fill(t.C, t.C + t.n, T(0));
+    };
+    auto verifica = [&](const char *nombre, auto &&resultado) {
+        for (long long v = 0; v < K; v++) {
+            const T *c = resultado(v);
+            if (!equal(c, c + longitudes[v], referencia.data() + inicio_ref[v])) {
+                cout << "  [ERROR] " << nombre << ": el vector " << v << " no coincide\n";
+                correcto = false;
+                return;
+            }
+        }
+    };
+    auto deTernas = [&](long long v) -> const T * { return ternas[v].C; };
+
+    cout << "Lote de " << K << " vectores (tipo=" << nombreTipo<T>() << ", longitudes "
+         << cfg.n / 2 << ".." << cfg.n / 2 + cfg.n << ", " << elementos << " elementos, hilos="
+         << omp_get_max_threads() << ")\n";
+    cout << "Medianas de " << cfg.repeticiones << " repeticiones; GB/s con 3 accesos por elemento\n\n";
+    cout << left << setw(30) << "variante" << right << setw(11) << "ms" << setw(13) << "Mvect/s"
+         << setw(10) << "GB/s" << setw(10) << "speedup" << "\n";
+
+    const double bytes = 3.0 * sizeof(T) * elementos;
+    double ms_base = 0.0;
+    auto fila = [&](const char *nombre, const Estadisticas &e) {
+        if (ms_base == 0.0) ms_base = e.mediana;
+        cout << left << setw(30) << nombre << right << fixed << setprecision(4) << setw(11)
+             << e.mediana << setprecision(3) << setw(13) << elementosPorSegundo(K, e.mediana) * 1e-6
+             << setprecision(2) << setw(10) << gbPorSegundo(bytes, e.mediana)
+             << setw(9) << ms_base / e.mediana << "x\n";
+    };
+
+    limpia();
+    fila("por vector, for paralelo", mide([&] {
+        for (const TernaVectores<T> &t : ternas) sumaParalela(t.A, t.B, t.C, t.n, cfg.chunk);
+    }, cfg.calentamiento, cfg.repeticiones));
+    verifica("por vector, for paralelo", deTernas);
+
+    limpia();
+    const FuncionOp<T> simd = opSimd<OpSuma, T>();
+    fila("por vector, 1 hilo SIMD", mide([&] {
+        for (const TernaVectores<T> &t : ternas) simd(t.C, t.A, t.B, nullptr, T(0), t.n);
+    }, cfg.calentamiento, cfg.repeticiones));
+    verifica("por vector, 1 hilo SIMD", deTernas);
+
+    limpia();
+    fila("lote (ternas)", mide([&] { sumaLote(ternas); }, cfg.calentamiento, cfg.repeticiones));
+    verifica("lote (ternas)", deTernas);
+
+    LoteSoA<T> lote(longitudes, cfg.paginas_grandes);
+    lote.empaqueta(ternas);
+    fila("lote SoA (solo suma)", mide([&] { lote.suma(); }, cfg.calentamiento, cfg.repeticiones));
+    verifica("lote SoA", [&](long long v) { return lote.c(v); });
+
+    limpia();
+    fila("lote SoA + empaquetado", mide([&] {
+        lote.empaqueta(ternas);
+        lote.suma();
+        lote.desempaqueta(ternas);
+    }, cfg.calentamiento, cfg.repeticiones));
+    verifica("lote SoA + empaquetado", deTernas);
+
+    cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo asincrono: --envios sumas independientes de N elementos, cada una
+// seguida de su verificación por huella
+//  (1) síncrono: por cada una, suma con huella y verificación con OpenMP,
+//      una detrás de otra (barrera implícita al final de cada for)
+//  (2) asíncrono: sumaYVerifica en ServicioSuma (ver asincrono.hpp); el que
+//      envía solo espera al final, y los avisos cuentan lo completado
+// ===============================
+template <typename T>
+int ejecutaAsincrono(const Configuracion &cfg) {
+
+    const long long N = cfg.n;
+    const int K = cfg.envios;
+    const int hilos = omp_get_max_threads();
+    vector<BufferAlineado<T>> bufA, bufB, bufC;
+    vector<uint64_t> referencia(K);
+    for (int k = 0; k < K; k++) {
+        bufA.emplace_back(N, cfg.paginas_grandes);
+        bufB.emplace_back(N, cfg.paginas_grandes);
+        bufC.emplace_back(N, cfg.paginas_grandes);
+        // Tramos distintos de la misma secuencia: cada suma tiene sus datos
+        inicializaTramoParalelo(bufA[k].data(), bufB[k].data(), static_cast<long long>(k) * N, N,
+                                cfg.chunk, cfg.semilla);
+        ceroParalelo(bufC[k].data(), N, cfg.chunk);
+        referencia[k] = checksumReferencia(bufA[k].data(), bufB[k].data(), N, cfg.chunk);
+    }
+    const long long bloque = granoRobo(N, cfg.chunk, cfg.grano, hilos);
+
+    bool correcto = true;
+    cout << "Sumas asincronas (" << K << " envios de N=" << N << ", tipo=" << nombreTipo<T>()
+         << ", hilos=" << hilos << ", bloque=" << bloque << ")\n";
+    cout << "Cada envio: C = A + B con huella, luego verificacion de C contra A y B\n\n";
+
+    // C a cero antes de cada ronda, fuera del tiempo medido y igual para
+    // las dos variantes: la verificación no puede ver la ronda anterior
+    auto reiniciaC = [&] {
+        for (int k = 0; k < K; k++) ceroParalelo(bufC[k].data(), N, cfg.chunk);
+    };
+
+    // (1) Síncrono con OpenMP
+    Estadisticas e_sinc = mideConPreparacion(reiniciaC, [&] {
+        for (int k = 0; k < K; k++) {
+            const T *A = bufA[k].data();
+            const T *B = bufB[k].data();
+            T *C = bufC[k].data();
+            const uint64_t h = sumaParalelaConChecksum(A, B, C, N, cfg.chunk);
+            if (h != referencia[k] || checksumArreglo(C, N, cfg.chunk) != checksumReferencia(A, B, N, cfg.chunk)) {
+                correcto = false;
+            }
+        }
+    }, cfg.calentamiento, cfg.repeticiones);
+    if (!correcto) cout << "  [ERROR] la version sincrona no coincide con la referencia\n";
+
+    // (2) Asíncrono sobre el equipo persistente
+    ServicioSuma<T> servicio(hilos, bloque);
+    atomic<int> avisos{0};
+    double ms_envio = 0.0, latencia = 0.0;
+    Estadisticas e_asinc = mideConPreparacion(reiniciaC, [&] {
+        avisos.store(0);
+        const double t0 = omp_get_wtime();
+        vector<pair<future<ResultadoAsincrono>, future<ResultadoAsincrono>>> futuros;
+        futuros.reserve(K);
+        for (int k = 0; k < K; k++) {
+            futuros.push_back(servicio.sumaYVerifica(bufA[k].data(), bufB[k].data(), bufC[k].data(), N,
+                                                     {}, [&](const ResultadoAsincrono &) { avisos++; }));
+        }
+        ms_envio = (omp_get_wtime() - t0) * 1e3;
+        latencia = 0.0;
+        for (int k = 0; k < K; k++) {
+            const ResultadoAsincrono s = futuros[k].first.get();
+            const ResultadoAsincrono v = futuros[k].second.get();
+            if (s.huella != referencia[k] || !v.correcto) correcto = false;
+            latencia += v.ms / K;
+        }
+    }, cfg.calentamiento, cfg.repeticiones);
+    servicio.espera();
+    if (!correcto) cout << "  [ERROR] la version asincrona no coincide con la referencia\n";
+    if (avisos.load() != K) {
+        cout << "  [ERROR] se recibieron " << avisos.load() << " avisos de " << K << "\n";
+        correcto = false;
+    }
+
+    const double bytes = (3.0 + 3.0) * sizeof(T) * N * K;   // suma + verificación (A, B y C)
+    cout << left << setw(26) << "variante" << right << setw(11) << "ms" << setw(10) << "GB/s"
+         << setw(10) << "speedup" << "\n";
+    cout << left << setw(26) << "sincrono (OpenMP)" << right << fixed << setprecision(4) << setw(11)
+         << e_sinc.mediana << setprecision(2) << setw(10) << gbPorSegundo(bytes, e_sinc.mediana)
+         << setw(9) << 1.0 << "x\n";
+    cout << left << setw(26) << "asincrono (equipo)" << right << setprecision(4) << setw(11)
+         << e_asinc.mediana << setprecision(2) << setw(10) << gbPorSegundo(bytes, e_asinc.mediana)
+         << setw(9) << e_sinc.mediana / e_asinc.mediana << "x\n";
+    cout << "\nUltima ronda: " << K << " envios en " << setprecision(4) << ms_envio
+         << " ms (el que envia queda libre), latencia media envio -> verificado "
+         << latencia << " ms, " << avisos.load() << " avisos\n";
+
+    cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo incremental: entre ejecuciones se reescriben tramos de A o B que
+// cubren una fracción creciente de los chunks, y C se pone al día con
+// SumaIncremental (ver incremental.hpp) de tres formas:
+//  (1) incremental: solo los chunks sucios, siempre (umbral 100%)
+//  (2) completo:    todo C en cada ejecución (umbral 0%)
+//  (3) auto:        incremental hasta --umbral-sucio, completo después
+// Cada ronda modifica los mismos tramos para las tres; solo se mide
+// actualiza(). La huella incremental se compara con la de referencia.
+// ===============================
+template <typename T>
+int ejecutaIncremental(const Configuracion &cfg) {
+
+    const long long N = cfg.n;
+    const long long chunk = cfg.chunk;
+    BufferAlineado<T> bufA(N, cfg.paginas_grandes), bufB(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufInc(N, cfg.paginas_grandes), bufCom(N, cfg.paginas_grandes),
+        bufAuto(N, cfg.paginas_grandes);
+    T *A = bufA.data();
+    T *B = bufB.data();
+    inicializaArreglosParalelo(A, B, N, chunk, cfg.semilla);
+    ceroParalelo(bufInc.data(), N, chunk);
+    ceroParalelo(bufCom.data(), N, chunk);
+    ceroParalelo(bufAuto.data(), N, chunk);
+
+    SumaIncremental<T> inc(A, B, bufInc.data(), N, chunk, 1.0);
+    SumaIncremental<T> com(A, B, bufCom.data(), N, chunk, 0.0);
+    SumaIncremental<T> aut(A, B, bufAuto.data(), N, chunk, cfg.umbral_sucio / 100.0);
+    SumaIncremental<T> *versiones[3] = {&inc, &com, &aut};
+    T *destinos[3] = {bufInc.data(), bufCom.data(), bufAuto.data()};
+    for (SumaIncremental<T> *v : versiones) v->actualiza();
+
+    // Tramos de 4 chunks con inicio al azar, alternando A y B, hasta cubrir
+    // "fraccion" de N (los solapes dejan la fracción sucia algo por debajo)
+    const long long largo = std::min(N, 4 * chunk);
+    uint64_t ronda = 0;
+    auto ensucia = [&](double fraccion) {
+        const long long tramos = max(1LL, static_cast<long long>(fraccion * N / largo + 0.5));
+        ronda++;
+        for (long long t = 0; t < tramos; t++) {
+            const array<uint32_t, 4> w = philox4x32(ronda * 0x100000000ull + t, cfg.semilla);
+            const long long inicio = static_cast<long long>((static_cast<uint64_t>(w[0]) << 32 | w[1]) %
+                                                            static_cast<uint64_t>(N - largo + 1));
+            const bool enA = (t % 2) == 0;
+            T *X = enA ? A : B;
+            for (long long i = inicio; i < inicio + largo; i++) {
+                T a, b;
+                valoresEn(i, cfg.semilla + ronda, a, b);
+                X[i] = enA ? a : b;
+            }
+            for (SumaIncremental<T> *v : versiones) {
+                if (enA) v->cambioA(inicio, inicio + largo);
+                else v->cambioB(inicio, inicio + largo);
+            }
+        }
+    };
+
+    bool correcto = true;
+    const long long chunks = (N + chunk - 1) / chunk;
+    cout << "Recalculo incremental (N=" << N << ", tipo=" << nombreTipo<T>() << ", chunk=" << chunk
+         << ", " << chunks << " chunks, hilos=" << omp_get_max_threads() << ", umbral auto="
+         << cfg.umbral_sucio << "%)\n";
+    cout << "Cada ronda reescribe tramos de " << largo << " elementos en A o B; ms = mediana de actualiza()\n\n";
+    cout << left << setw(10) << "% pedido" << right << setw(10) << "% sucio" << setw(14) << "incremental"
+         << setw(11) << "completo" << setw(10) << "auto" << setw(13) << "auto eligio" << setw(10)
+         << "speedup" << "\n";
+
+    const double fracciones[] = {0.001, 0.01, 0.05, 0.10, 0.25, 0.50, 0.75, 1.00};
+    for (double f : fracciones) {
+        vector<double> muestras[3];
+        double sucia = 0.0;
+        bool eligio_completo = false;
+        for (int r = 0; r < cfg.calentamiento + cfg.repeticiones; r++) {
+            ensucia(f);
+            for (int v = 0; v < 3; v++) {
+                const double t0 = omp_get_wtime();
+                const ResultadoIncremental res = versiones[v]->actualiza();
+                const double ms = (omp_get_wtime() - t0) * 1e3;
+                if (r < cfg.calentamiento) continue;
+                muestras[v].push_back(ms);
+                if (v == 0) sucia += res.fraccion / cfg.repeticiones;
+                if (v == 2) eligio_completo = res.completo;
+            }
+        }
+        const uint64_t referencia = checksumReferencia(A, B, N, chunk);
+        for (int v = 0; v < 3; v++) {
+            if (versiones[v]->huella() != referencia || checksumArreglo(destinos[v], N, chunk) != referencia) {
+                cout << "  [ERROR] la version " << v + 1 << " no coincide con la referencia ("
+                     << 100.0 * f << "%)\n";
+                correcto = false;
+            }
+        }
+        const Estadisticas e_inc = calculaEstadisticas(muestras[0]);
+        const Estadisticas e_com = calculaEstadisticas(muestras[1]);
+        const Estadisticas e_aut = calculaEstadisticas(muestras[2]);
+        cout << left << fixed << setprecision(1) << setw(10) << 100.0 * f << right << setprecision(2) << setw(10)
+             << 100.0 * sucia << setprecision(4) << setw(14) << e_inc.mediana << setw(11) << e_com.mediana
+             << setw(10) << e_aut.mediana << setw(13) << (eligio_completo ? "completo" : "incremental")
+             << setprecision(2) << setw(9) << e_com.mediana / e_inc.mediana << "x\n";
+        cout.unsetf(std::ios::fixed);
+    }
+    cout << "\nspeedup = completo / incremental; por encima del punto de cruce conviene el completo\n";
+
+    cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Modo desborde: la suma actual (sin comprobar) contra las tres sumas
+// seguras de desborde.hpp, primero con los datos tal cual (no desbordan)
+// y luego con un par que desborda cada ~10^4 elementos, mitad hacia
+// arriba y mitad hacia abajo. Cada variante se verifica contra su
+// referencia escalar. Solo para tipos enteros.
+// ===============================
+template <typename T>
+int ejecutaDesborde(const Configuracion &cfg) {
+    if constexpr (!std::is_integral<T>::value) {
+        cout << "El modo desborde es para tipos enteros (tipo=" << nombreTipo<T>()
+             << ": la suma flotante no tiene comportamiento indefinido)\n";
+        return 0;
+    } else {
+        using W = AmpliadoT<T>;
+        constexpr bool hay_ampliada = !std::is_void<W>::value;
+        using WA = typename std::conditional<hay_ampliada, W, T>::type;
+
+        const long long N = cfg.n;
+        const long long chunk = cfg.chunk;
+        BufferAlineado<T> bufA(N, cfg.paginas_grandes), bufB(N, cfg.paginas_grandes),
+            bufC(N, cfg.paginas_grandes);
+        BufferAlineado<WA> bufCW(hay_ampliada ? N : 0, cfg.paginas_grandes);
+        T *A = bufA.data();
+        T *B = bufB.data();
+        T *C = bufC.data();
+        inicializaArreglosParalelo(A, B, N, chunk, cfg.semilla);
+        ceroParalelo(C, N, chunk);
+        vector<T> referencia(N);
+
+        cout << "Sumas seguras ante desborde (N=" << N << ", tipo=" << nombreTipo<T>() << ", chunk="
+             << chunk << ", hilos=" << omp_get_max_threads() << ")\n";
+        cout << "ms = mediana; relativo = contra la suma sin comprobar del mismo escenario\n";
+
+        bool correcto = true;
+        const char *escenarios[2] = {"sin desbordes", "con desbordes"};
+        for (int e = 0; e < 2; e++) {
+            if (e == 1) {
+                // Pares que desbordan: max - x + (x + 1..) arriba, min + x + (-x - 1..) abajo
+                const long long pares = max(1LL, N / 10000);
+                for (long long k = 0; k < pares; k++) {
+                    const array<uint32_t, 4> w = philox4x32(static_cast<uint64_t>(k), cfg.semilla ^ 0xDE5B0eull);
+                    const long long i = static_cast<long long>(w[0] % static_cast<uint64_t>(N));
+                    const T x = static_cast<T>(w[1] % 64);
+                    if (k % 2 == 0) {
+                        A[i] = static_cast<T>(numeric_limits<T>::max() - x);
+                        B[i] = static_cast<T>(x + 1 + w[2] % 64);
+                    } else {
+                        A[i] = static_cast<T>(numeric_limits<T>::min() + x);
+                        B[i] = static_cast<T>(-x - 1 - static_cast<T>(w[2] % 64));
+                    }
+                }
+            }
+            // Referencias escalares
+            long long primero_ref = -1, saturados_ref = 0;
+            for (long long i = 0; i < N; i++) {
+                if (palabraDesborde(A[i], B[i], sumaEnvolvente(A[i], B[i])) < 0) {
+                    if (primero_ref < 0) primero_ref = i;
+                    saturados_ref++;
+                }
+            }
+
+            cout << "\n" << escenarios[e] << " (" << saturados_ref << " elementos desbordan)\n";
+            cout << left << setw(24) << "variante" << right << setw(11) << "ms" << setw(10) << "GB/s"
+                 << setw(11) << "relativo" << "   resultado\n";
+            auto fila = [&](const char *nombre, const Estadisticas &est, double bytes, double base,
+                            const string &resultado) {
+                cout << left << setw(24) << nombre << right << fixed << setprecision(4) << setw(11)
+                     << est.mediana << setprecision(2) << setw(10) << gbPorSegundo(bytes, est.mediana)
+                     << setw(10) << est.mediana / base << "x   " << resultado << "\n";
+                cout.unsetf(std::ios::fixed);
+            };
+            const double bytes = 3.0 * sizeof(T) * N;
+
+            // (1) La suma actual: A[i] + B[i] sin comprobar
+            Estadisticas e_libre = mide([&] {
+                opParalelaSimd<OpSuma, T>(C, A, B, nullptr, T(0), N, chunk);
+            }, cfg.calentamiento, cfg.repeticiones);
+            fila("sin comprobar", e_libre, bytes, e_libre.mediana, "(indefinido si desborda)");
+
+            // (2) Comprobada
+            for (long long i = 0; i < N; i++) referencia[i] = sumaEnvolvente(A[i], B[i]);
+            long long primero = 0;
+            Estadisticas e_comp = mide([&] { primero = sumaComprobada(A, B, C, N, chunk); },
+                                       cfg.calentamiento, cfg.repeticiones);
+            if (primero != primero_ref || !equal(C, C + N, referencia.begin())) {
+                cout << "  [ERROR] comprobada: primer desborde " << primero << ", esperado " << primero_ref << "\n";
+                correcto = false;
+            }
+            fila("comprobada", e_comp, bytes, e_libre.mediana,
+                 primero < 0 ? string("sin desborde") : "primer desborde i=" + to_string(primero));
+
+            // (3) Saturada
+            for (long long i = 0; i < N; i++) referencia[i] = sumaSaturadaElemento(A[i], B[i]);
+            long long saturados = 0;
+            Estadisticas e_sat = mide([&] { saturados = sumaSaturada(A, B, C, N, chunk); },
+                                      cfg.calentamiento, cfg.repeticiones);
+            if (saturados != saturados_ref || !equal(C, C + N, referencia.begin())) {
+                cout << "  [ERROR] saturada: " << saturados << " saturados, esperados " << saturados_ref << "\n";
+                correcto = false;
+            }
+            fila("saturada", e_sat, bytes, e_libre.mediana, to_string(saturados) + " saturados");
+
+            // (4) Ampliada
+            if constexpr (hay_ampliada) {
+                WA *CW = bufCW.data();
+                Estadisticas e_amp = mide([&] { sumaAmpliada(A, B, CW, N, chunk); },
+                                          cfg.calentamiento, cfg.repeticiones);
+                bool iguales = true;
+                for (long long i = 0; i < N; i++) {
+                    if (CW[i] != static_cast<WA>(static_cast<WA>(A[i]) + static_cast<WA>(B[i]))) iguales = false;
+                }
+                if (!iguales) {
+                    cout << "  [ERROR] ampliada no coincide con la referencia\n";
+                    correcto = false;
+                }
+                const string nombre = string("ampliada -> ") + nombreTipo<WA>();
+                fila(nombre.c_str(), e_amp, (2.0 * sizeof(T) + sizeof(WA)) * N, e_libre.mediana,
+                     "no puede desbordar");
+            } else {
+                cout << left << setw(24) << "ampliada" << "   (no hay tipo mas ancho que "
+                     << nombreTipo<T>() << ")\n";
+            }
+        }
+
+        cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+        return correcto ? 0 : 1;
+    }
+}
+
+// ===============================
+// Modo comparar: informe --actual contra el informe --base (JSON o CSV,
+// ver informe.hpp). Por núcleo, tipo, N e hilos: medianas, cambio y p de
+// la prueba U en cada sentido. Termina con 1 si hay alguna regresión,
+// para poder usarlo en integración continua.
+// ===============================
+template <typename T>
+int ejecutaComparar(const Configuracion &cfg) {
+    if (cfg.base.empty() || cfg.actual.empty()) {
+        throw runtime_error("el modo comparar necesita --base=<informe> y --actual=<informe>");
+    }
+    const vector<MedicionInforme> base = leeInforme(cfg.base);
+    const vector<MedicionInforme> actual = leeInforme(cfg.actual);
+    const double tolerancia = cfg.tolerancia / 100.0;
+    const vector<ComparacionKernel> c = comparaInformes(base, actual, cfg.alfa, tolerancia);
+
+    cout << "Comparacion de informes: " << cfg.actual << " contra " << cfg.base << "\n";
+    cout << "Regresion: U de Mann-Whitney con p < " << cfg.alfa << " y mediana " << cfg.tolerancia
+         << "% o mas lenta\n\n";
+    cout << left << setw(22) << "kernel" << setw(8) << "tipo" << right << setw(12) << "N" << setw(7)
+         << "hilos" << setw(12) << "base ms" << setw(12) << "actual ms" << setw(9) << "cambio"
+         << setw(10) << "p" << "   veredicto\n";
+    int regresiones = 0, mejoras = 0;
+    for (const ComparacionKernel &k : c) {
+        const double p = k.cambio >= 0.0 ? k.p_lento : k.p_rapido;
+        cout << left << setw(22) << k.actual->kernel << setw(8) << k.actual->tipo << right << setw(12)
+             << k.actual->n << setw(7) << k.actual->hilos << fixed << setprecision(4) << setw(12)
+             << k.mediana_base << setw(12) << k.mediana_actual << setprecision(1) << setw(8)
+             << 100.0 * k.cambio << "%" << scientific << setprecision(2) << setw(10) << p << "   "
+             << (k.regresion ? "REGRESION" : k.mejora ? "mejora" : "igual") << "\n";
+        cout.unsetf(std::ios::floatfield);
+        regresiones += k.regresion;
+        mejoras += k.mejora;
+    }
+    const size_t sin_par = actual.size() - c.size();
+    cout << "\n" << c.size() << " mediciones comparadas, " << regresiones << " regresiones, " << mejoras
+         << " mejoras";
+    if (sin_par > 0) cout << ", " << sin_par << " sin equivalente en la base";
+    cout << "\n";
+    return regresiones > 0 ? 1 : 0;
+}
+
+// ===============================
+// Modo fijo: costo por llamada de sumaFija<N, T> (N constante) contra las
+// rutas con n en tiempo de ejecución, para los tamaños de TamanosFijos.
+// Cada muestra es un lote de llamadas sobre los mismos arreglos (en caché),
+// así que lo que se mide es el costo de la llamada y del bucle.
+// ===============================
+template <typename T>
+int ejecutaFijo(const Configuracion &cfg) {
+
+    constexpr long long N_MAX = 4096;
+    BufferAlineado<T> bufA(N_MAX, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(N_MAX, cfg.paginas_grandes);
+    BufferAlineado<T> bufC(N_MAX, cfg.paginas_grandes);
+    BufferAlineado<T> bufR(N_MAX, cfg.paginas_grandes);
+    T *A = bufA.data();
+    T *B = bufB.data();
+    T *C = bufC.data();
+    T *R = bufR.data();
+    inicializaArreglosParalelo(A, B, N_MAX, cfg.chunk, cfg.semilla);
+    sumaSecuencial(A, B, R, N_MAX);
+    configuraDespachador<T>(cfg);
+
+    cout << "Tamanos fijos (tipo=" << nombreTipo<T>() << ", simd=" << varianteSimd<T>().nombre
+         << ", paralela desde " << SUMA_FIJO_PARALELO << " bytes)\n";
+    cout << "  secuencial, simd y suma(): n en tiempo de ejecucion\n"
+         << "  fija: sumaFija<N> con el ISA de compilacion; fija isa: la misma en un lote\n"
+         << "  compilado por ISA; tamano: sumaTamano(n), que elige sumaFija (compilada por ISA) en tiempo de ejecucion\n\n";
+    cout << right << setw(6) << "N" << setw(12) << "secuencial" << setw(10) << "simd" << setw(10)
+         << "suma()" << setw(10) << "fija" << setw(10) << "fija isa" << setw(10) << "tamano"
+         << "  ruta      ahorro\n";
+
+    bool correcto = true;
+    Informe informe(cfg, nombreTipo<T>(), varianteSimd<T>().nombre);
+    auto mideTamano = [&](auto constante) {
+        constexpr long long n = decltype(constante)::value;
+        const long long llamadas = max(1LL, 10000000LL / n);
+        const FuncionSumaT<T> simd = varianteSimd<T>().funcion;
+        const LoteFijo<T> lote = loteFijo<n, T>();
+        const char *nombres[6] = {"secuencial", "simd", "suma()", "fija", "fija isa", "tamano"};
+        const double bytes = 3.0 * sizeof(T) * n * llamadas;   // Por muestra (lote entero)
+        double ns[6];
+        for (int v = 0; v < 6; v++) {
+            fill(C, C + n, T(0));
+            Estadisticas e = informe.mide(nombres[v], n, 1, bytes, [&] {
+                switch (v) {
+                    case 0:
+                        for (long long k = 0; k < llamadas; k++) { sumaSecuencial(A, B, C, n); barreraCompilador(); }
+                        break;
+                    case 1:
+                        for (long long k = 0; k < llamadas; k++) { simd(A, B, C, n); barreraCompilador(); }
+                        break;
+                    case 2:
+                        for (long long k = 0; k < llamadas; k++) { suma(A, B, C, n); barreraCompilador(); }
+                        break;
+                    case 3: loteFijoBase<n, T>(A, B, C, llamadas); break;
+                    case 4: lote(A, B, C, llamadas); break;
+                    default:
+                        for (long long k = 0; k < llamadas; k++) { sumaTamano(A, B, C, n); barreraCompilador(); }
+                        break;
+                }
+            }, cfg.calentamiento, cfg.repeticiones);
+            ns[v] = e.mediana * 1e6 / llamadas;
+            if (!equal(C, C + n, R)) {
+                cout << "  [ERROR] " << nombres[v] << " (N=" << n << ") no coincide con la referencia\n";
+                correcto = false;
+            }
+        }
+        // Ahorro de la fija (mejor ISA) sobre la mejor ruta en tiempo de ejecución
+        const double mejor_dinamica = min(ns[0], ns[1]);
+        cout << setw(6) << n << fixed << setprecision(1) << setw(12) << ns[0] << setw(10) << ns[1]
+             << setw(10) << ns[2] << setw(10) << ns[3] << setw(10) << ns[4] << setw(10) << ns[5] << "  "
+             << left << setw(10) << nombreRuta(rutaFija<n, T>()) << right << setw(5)
+             << 100.0 * (1.0 - ns[4] / mejor_dinamica) << "%\n";
+        cout.unsetf(std::ios::floatfield);
+    };
+    recorreTamanos(mideTamano, TamanosFijos{});
+
+    // Respaldo: tamaños fuera de la lista van por suma()
+    for (long long n : {15LL, 1000LL, 4095LL}) {
+        fill(C, C + n, T(0));
+        sumaTamano(A, B, C, n);
+        if (!equal(C, C + n, R)) {
+            cout << "  [ERROR] sumaTamano (N=" << n << ", respaldo) no coincide con la referencia\n";
+            correcto = false;
+        }
+    }
+    cout << "\nns por llamada (mediana de " << cfg.repeticiones << " muestras); ahorro = fija isa"
+         << " contra la mejor de secuencial y simd\n";
+    if (!cfg.informe.empty()) {
+        informe.escribe(cfg.informe);
+        cout << "Informe: " << cfg.informe << " (" << informe.mediciones() << " mediciones; ms por lote)\n";
+    }
+    cout << (correcto ? "\nVerificacion: Correcto\n" : "\nVerificacion: ERROR\n");
+    return correcto ? 0 : 1;
+}
+
+// ===============================
+// Operandos del modo operaciones: x, y, z de entrada, D de salida y R con
+// la referencia secuencial para verificar las demás variantes
+// ===============================
+template <typename T>
+struct Operandos {
+    const T *A, *B, *C;
+    T *D, *R;
+    T s;
+    long long n;
+};
+
+// ===============================
+// Mide una operación en sus 4 variantes, imprime una fila y verifica.
+// Devuelve la mediana (ms) de la variante OpenMP+SIMD.
+// ===============================
+template <typename Op, typename T>
+double mideOperacion(const Configuracion &cfg, const Operandos<T> &o, bool &correcto) {
+    const long long n = o.n;
+    opSecuencial<Op>(o.R, o.A, o.B, o.C, o.s, n);
+
+    const char *variantes[4] = {"seq", "omp", "simd", "omp+simd"};
+    Estadisticas e[4];
+    for (int v = 0; v < 4; v++) {
+        fill(o.D, o.D + n, T(0));
+        e[v] = mide([&] {
+            switch (v) {
+                case 0: opSecuencial<Op>(o.D, o.A, o.B, o.C, o.s, n); break;
+                case 1: opParalela<Op>(o.D, o.A, o.B, o.C, o.s, n, cfg.chunk); break;
+                case 2: opSimd<Op, T>()(o.D, o.A, o.B, o.C, o.s, n); break;
+                default: opParalelaSimd<Op>(o.D, o.A, o.B, o.C, o.s, n, cfg.chunk); break;
+            }
+        }, cfg.calentamiento, cfg.repeticiones);
+        if (!equal(o.D, o.D + n, o.R)) {
+            cout << "  [ERROR] " << Op::nombre << " (" << variantes[v]
+                 << ") no coincide con la referencia\n";
+            correcto = false;
+        }
+    }
+
+    const double bytes = static_cast<double>(Op::accesos) * sizeof(T) * n;
+    cout << left << setw(9) << Op::nombre << setw(16) << Op::formula << right
+         << setw(6) << Op::accesos * sizeof(T) << fixed << setprecision(2);
+    for (const Estadisticas &ei : e) cout << setw(11) << gbPorSegundo(bytes, ei.mediana);
+    cout << "\n";
+    return e[3].mediana;
+}
+
+// ===============================
+// Modo operaciones:
+//  (1) Tabla STREAM: GB/s (mediana) de cada operación y variante
+//  (2) Fusión: D = A + B + C y D = s*(A + B) en una pasada contra las dos
+//      pasadas equivalentes; la fusión evita volver a leer y escribir D.
+// ===============================
+template <typename T>
+int ejecutaOperaciones(const Configuracion &cfg) {
+
+    const long long N = cfg.n;
+    BufferAlineado<T> bufA(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufB(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufC(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufD(N, cfg.paginas_grandes);
+    BufferAlineado<T> bufR(N, cfg.paginas_grandes);
+    inicializaArreglosParalelo(bufA.data(), bufB.data(), N, cfg.chunk, cfg.semilla);
+    inicializaArregloParalelo(bufC.data(), N, cfg.chunk, cfg.semilla);
+    ceroParalelo(bufD.data(), N, cfg.chunk);
+    ceroParalelo(bufR.data(), N, cfg.chunk);
+
+    Operandos<T> o{bufA.data(), bufB.data(), bufC.data(), bufD.data(), bufR.data(), T(3), N};
+    bool correcto = true;
+
+    cout << "Familia de operaciones (N=" << N << ", tipo=" << nombreTipo<T>()
+         << ", chunk=" << cfg.chunk << ", hilos=" << omp_get_max_threads() << ", s=3)\n";
+    cout << "GB/s por mediana de " << cfg.repeticiones << " repeticiones; bytes/elem como STREAM\n\n";
+    cout << left << setw(9) << "Op" << setw(16) << "Formula" << right << setw(6) << "B/el"
+         << setw(11) << "seq" << setw(11) << "omp" << setw(11) << "simd"
+         << setw(11) << "omp+simd" << "\n";
+
+    mideOperacion<OpCopia>(cfg, o, correcto);
+    mideOperacion<OpEscala>(cfg, o, correcto);
+    const double t_suma = mideOperacion<OpSuma>(cfg, o, correcto);
+    mideOperacion<OpTriada>(cfg, o, correcto);
+    const double t_suma3 = mideOperacion<OpSuma3>(cfg, o, correcto);
+    const double t_escsuma = mideOperacion<OpEscalaSuma>(cfg, o, correcto);
+
+    // Cadenas sin fusionar: dos pasadas, la segunda relee D
+    T *D = o.D;
+    Estadisticas e_dos_sumas = mide([&] {
+        opParalelaSimd<OpSuma, T>(D, o.A, o.B, nullptr, o.s, N, cfg.chunk);
+        opParalelaSimd<OpSuma, T>(D, D, o.C, nullptr, o.s, N, cfg.chunk);
+    }, cfg.calentamiento, cfg.repeticiones);
+    opSecuencial<OpSuma3>(o.R, o.A, o.B, o.C, o.s, N);
+    if (!equal(D, D + N, o.R)) {
+        cout << "  [ERROR] suma + suma no coincide con suma3\n";
+        correcto = false;
+    }
+    Estadisticas e_suma_escala = mide([&] {
+        opParalelaSimd<OpSuma, T>(D, o.A, o.B, nullptr, o.s, N, cfg.chunk);
+        opParalelaSimd<OpEscala, T>(D, D, nullptr, nullptr, o.s, N, cfg.chunk);
+    }, cfg.calentamiento, cfg.repeticiones);
+    opSecuencial<OpEscalaSuma>(o.R, o.A, o.B, o.C, o.s, N);
+    if (!equal(D, D + N, o.R)) {
+        cout << "  [ERROR] suma + escala no coincide con escsuma\n";
+        correcto = false;
+    }
+
+    const double mb = sizeof(T) * N / 1.0e6;
+    cout << "\nFusion (omp+simd, mediana ms; MB movidos por pasada completa)\n";
+    cout << left << setw(34) << "Cadena" << right << setw(10) << "ms" << setw(10) << "MB"
+         << setw(10) << "ahorro" << "\n";
+    auto fila = [&](const char *nombre, double ms, int accesos, double ms_base) {
+        cout << left << setw(34) << nombre << right << fixed << setprecision(4) << setw(10) << ms
+             << setprecision(1) << setw(10) << accesos * mb;
+        if (ms_base > 0.0) cout << setprecision(2) << setw(9) << ms_base / ms << "x";
+        cout << "\n";
+    };
+    fila("suma + suma (2 pasadas)", e_dos_sumas.mediana, 6, 0.0);
+    fila("suma3 fusionada", t_suma3, 4, e_dos_sumas.mediana);
+    fila("suma + escala (2 pasadas)", e_suma_escala.mediana, 5, 0.0);
+    fila("escsuma fusionada", t_escsuma, 3, e_suma_escala.mediana);
+    fila("referencia: una suma", t_suma, 3, 0.0);
+
+    cout << "\nVerificacion de operaciones: " << (correcto ? "OK" : "FALLO") << endl;
+    return correcto ? 0 : 1;
+}
+
 // ===============================
 // Función de impresión parcial
 // ===============================
-void imprimeArreglo(const int *d, const char *nombre) {
+template <typename T>
+void imprimeArreglo(const T *d, const char *nombre, int mostrar) {
     cout << "Arreglo " << nombre << " (primeros " << mostrar << "): ";
     for (int x = 0; x < mostrar; x++) {
-        cout << d[x] << " ";
+        // "+" promueve int8 a int para que no se imprima como carácter
+        cout << +d[x] << " ";
     }
     cout << endl;
-}
\ No newline at end of file
+}
@@ -0,0 +1,133 @@
+/******************************************************************************
+ * memoria.hpp
+ * Descripción:
+ *  - Buffer en el heap alineado a 64 bytes (una línea de caché) para
+ *    reemplazar los arreglos en la pila (int A[N], ...), que limitaban N a
+ *    unos pocos MB por el tamaño máximo de la pila.
+ *  - Opcionalmente respaldado por huge pages:
+ *      (1) mmap con MAP_HUGETLB (páginas de 2 MB reservadas por el sistema)
+ *      (2) si no hay reservadas, mmap normal + madvise(MADV_HUGEPAGE) (THP)
+ *  - RAII: la memoria se libera en el destructor; el buffer solo se mueve.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <cstddef>      // size_t
+#include <cstdlib>      // aligned_alloc, free
+#include <new>          // bad_alloc
+#include <utility>      // swap
+
+#ifdef __linux__
+#include <sys/mman.h>   // mmap, munmap, madvise
+#endif
+
+constexpr std::size_t ALINEACION = 64;                   // Línea de caché
+constexpr std::size_t PAGINA_GRANDE = 2u * 1024 * 1024;  // Huge page típica x86-64
+
+// Redondea "x" hacia arriba al múltiplo de "m" (m potencia de 2)
+constexpr std::size_t redondeaArriba(std::size_t x, std::size_t m) {
+    return (x + m - 1) & ~(m - 1);
+}
+
+// ===============================
+// Origen de la memoria de un buffer (para reportarlo)
+// ===============================
+enum class TipoMemoria { Alineada, HugeTLB, THP };
+
+inline const char *nombreTipoMemoria(TipoMemoria t) {
+    switch (t) {
+        case TipoMemoria::HugeTLB: return "hugetlb (MAP_HUGETLB)";
+        case TipoMemoria::THP:     return "THP (madvise MADV_HUGEPAGE)";
+        default:                   return "aligned_alloc(64)";
+    }
+}
+
+// ===============================
+// Buffer de "n" elementos tipo T alineado a 64 bytes
+// ===============================
+template <typename T>
+class BufferAlineado {
+public:
+    BufferAlineado() = default;
+
+    explicit BufferAlineado(std::size_t n, bool paginas_grandes = false) : n_(n) {
+        bytes_ = redondeaArriba(n * sizeof(T) > 0 ? n * sizeof(T) : 1, ALINEACION);
+#ifdef __linux__
+        if (paginas_grandes) {
+            reservaPaginasGrandes();
+            return;
+        }
+#else
+        (void)paginas_grandes;
+#endif
+        datos_ = static_cast<T *>(std::aligned_alloc(ALINEACION, bytes_));
+        if (!datos_) throw std::bad_alloc();
+    }
+
+    ~BufferAlineado() { libera(); }
+
+    BufferAlineado(const BufferAlineado &) = delete;
+    BufferAlineado &operator=(const BufferAlineado &) = delete;
+
+    BufferAlineado(BufferAlineado &&otro) noexcept { intercambia(otro); }
+    BufferAlineado &operator=(BufferAlineado &&otro) noexcept {
+        if (this != &otro) {
+            libera();
+            intercambia(otro);
+        }
+        return *this;
+    }
+
+    T *data() { return datos_; }
+    const T *data() const { return datos_; }
+    std::size_t size() const { return n_; }
+    std::size_t bytes() const { return bytes_; }
+    TipoMemoria tipo() const { return tipo_; }
+
+    T &operator[](std::size_t i) { return datos_[i]; }
+    const T &operator[](std::size_t i) const { return datos_[i]; }
+
+private:
+#ifdef __linux__
+    void reservaPaginasGrandes() {
+        bytes_ = redondeaArriba(bytes_, PAGINA_GRANDE);
+        void *p = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        tipo_ = TipoMemoria::HugeTLB;
+        if (p == MAP_FAILED) {
+            // Sin páginas reservadas: pedimos THP sobre un mapeo normal
+            p = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) throw std::bad_alloc();
+            madvise(p, bytes_, MADV_HUGEPAGE);
+            tipo_ = TipoMemoria::THP;
+        }
+        datos_ = static_cast<T *>(p);
+    }
+#endif
+
+    void libera() {
+        if (!datos_) return;
+#ifdef __linux__
+        if (tipo_ != TipoMemoria::Alineada) {
+            munmap(datos_, bytes_);
+        } else
+#endif
+        {
+            std::free(datos_);
+        }
+        datos_ = nullptr;
+    }
+
+    void intercambia(BufferAlineado &otro) noexcept {
+        std::swap(datos_, otro.datos_);
+        std::swap(n_, otro.n_);
+        std::swap(bytes_, otro.bytes_);
+        std::swap(tipo_, otro.tipo_);
+    }
+
+    T *datos_ = nullptr;
+    std::size_t n_ = 0;
+    std::size_t bytes_ = 0;
+    TipoMemoria tipo_ = TipoMemoria::Alineada;
+};
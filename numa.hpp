@@ -0,0 +1,196 @@
+/******************************************************************************
+ * numa.hpp
+ * Descripción:
+ *  - Utilidades NUMA sin dependencias externas (solo llamadas al sistema):
+ *      (1) Primer toque en paralelo: Linux coloca cada página en el nodo del
+ *          hilo que la escribe primero, así que inicializar con el mismo
+ *          schedule(static, chunk) que la suma deja cada página junto al hilo
+ *          que la va a usar.
+ *      (2) Afinidad: OMP_PROC_BIND / OMP_PLACES se leen al cargar el runtime
+ *          de OpenMP, antes de main(); para aplicarlas desde --afinidad y
+ *          --lugares el programa se re-ejecuta a sí mismo con el entorno ya
+ *          puesto.
+ *      (3) Ubicación: move_pages(2) con nodes=NULL devuelve el nodo de cada
+ *          página; se compara con el nodo del hilo dueño del bloque para
+ *          contar páginas locales y remotas.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min, max
+#include <cstdint>      // uintptr_t
+#include <cstdlib>      // getenv, setenv
+#include <cstring>      // strcmp
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+#include <unistd.h>     // execv, sysconf
+#ifdef __linux__
+#include <sys/syscall.h> // SYS_getcpu, SYS_move_pages
+#endif
+
+#include "configuracion.hpp"  // Configuracion
+
+// ===============================
+// CPU y nodo NUMA del hilo que llama (-1 si no se puede saber)
+// ===============================
+inline int nodoActual(int *cpu = nullptr) {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned c = 0, nodo = 0;
+    if (syscall(SYS_getcpu, &c, &nodo, nullptr) == 0) {
+        if (cpu) *cpu = static_cast<int>(c);
+        return static_cast<int>(nodo);
+    }
+#endif
+    if (cpu) *cpu = -1;
+    return -1;
+}
+
+// Nodos NUMA en línea (cuenta /sys/devices/system/node/nodeK)
+inline int numeroNodos() {
+    int nodos = 0;
+    while (access(("/sys/devices/system/node/node" + std::to_string(nodos)).c_str(), F_OK) == 0) {
+        nodos++;
+    }
+    return nodos > 0 ? nodos : 1;
+}
+
+// ===============================
+// Aplica --afinidad / --lugares como OMP_PROC_BIND / OMP_PLACES.
+// Si el entorno cambia, re-ejecuta el programa (execv no regresa).
+// ===============================
+inline void aplicaAfinidad(const Configuracion &cfg, char **argv) {
+    bool cambio = false;
+    auto pon = [&](const char *var, const std::string &valor) {
+        if (valor.empty()) return;
+        const char *actual = std::getenv(var);
+        if (!actual || valor != actual) {
+            setenv(var, valor.c_str(), 1);
+            cambio = true;
+        }
+    };
+    pon("OMP_PROC_BIND", cfg.afinidad);
+    pon("OMP_PLACES", cfg.lugares);
+    if (!cambio) return;
+
+    execv("/proc/self/exe", argv);
+    std::cerr << "[AVISO] No se pudo re-ejecutar para aplicar OMP_PROC_BIND/OMP_PLACES;"
+                 " expórtalas antes de lanzar el programa\n";
+}
+
+inline const char *nombreProcBind(omp_proc_bind_t b) {
+    switch (b) {
+        case omp_proc_bind_false:  return "false";
+        case omp_proc_bind_true:   return "true";
+        case omp_proc_bind_master: return "master";
+        case omp_proc_bind_close:  return "close";
+        case omp_proc_bind_spread: return "spread";
+        default:                   return "?";
+    }
+}
+
+// ===============================
+// Reporte de afinidad: política, lugares y CPU/nodo de cada hilo
+// ===============================
+inline void imprimeAfinidad() {
+    const int hilos = omp_get_max_threads();
+    std::vector<int> cpu(hilos, -1), nodo(hilos, -1), lugar(hilos, -1);
+#pragma omp parallel
+    {
+        int t = omp_get_thread_num();
+        nodo[t] = nodoActual(&cpu[t]);
+        lugar[t] = omp_get_place_num();
+    }
+    std::cout << "Afinidad: OMP_PROC_BIND=" << nombreProcBind(omp_get_proc_bind())
+              << ", lugares=" << omp_get_num_places()
+              << ", nodos NUMA=" << numeroNodos() << "\n";
+    for (int t = 0; t < hilos; t++) {
+        std::cout << "  hilo " << std::setw(3) << t << ": lugar " << std::setw(3) << lugar[t]
+                  << "  cpu " << std::setw(4) << cpu[t] << "  nodo " << nodo[t] << "\n";
+    }
+}
+
+// ===============================
+// Primer toque: escribe ceros con el mismo reparto que la suma
+// ===============================
+template <typename T>
+void ceroParalelo(T *C, long long n, long long chunk) {
+#pragma omp parallel for schedule(static, chunk)
+    for (long long i = 0; i < n; i++) {
+        C[i] = T(0);
+    }
+}
+
+// ===============================
+// Páginas locales/remotas de "d" respecto al hilo dueño de cada bloque
+// según schedule(static, chunk). Se muestrean hasta "muestras" páginas
+// por hilo. Sin move_pages (no Linux) todo cuenta como desconocido.
+// ===============================
+struct Ubicacion {
+    long long locales = 0;
+    long long remotas = 0;
+    long long desconocidas = 0;
+
+    double fraccionLocal() const {
+        long long total = locales + remotas;
+        return total > 0 ? static_cast<double>(locales) / total : 1.0;
+    }
+};
+
+template <typename T>
+Ubicacion ubicacionPaginas(const T *d, long long n, long long chunk, long long muestras = 4096) {
+    const long long pagina = sysconf(_SC_PAGESIZE);
+    const long long por_pagina = std::max(1LL, pagina / static_cast<long long>(sizeof(T)));
+    Ubicacion total;
+
+#pragma omp parallel
+    {
+        const int t = omp_get_thread_num();
+        const int hilos = omp_get_num_threads();
+        const int mi_nodo = nodoActual();
+
+        // Primer elemento de cada página que cae en un bloque de este hilo
+        std::vector<void *> paginas;
+        const long long bloques = (n + chunk - 1) / chunk;
+        const long long paso_bloques = std::max(1LL, (bloques / hilos) / muestras);
+        for (long long b = t; b < bloques && static_cast<long long>(paginas.size()) < muestras;
+             b += static_cast<long long>(hilos) * paso_bloques) {
+            for (long long i = b * chunk; i < std::min(n, (b + 1) * chunk); i += por_pagina) {
+                uintptr_t dir = reinterpret_cast<uintptr_t>(d + i) & ~static_cast<uintptr_t>(pagina - 1);
+                if (paginas.empty() || paginas.back() != reinterpret_cast<void *>(dir)) {
+                    paginas.push_back(reinterpret_cast<void *>(dir));
+                }
+            }
+        }
+
+        Ubicacion mia;
+#if defined(__linux__) && defined(SYS_move_pages)
+        std::vector<int> estado(paginas.size(), -1);
+        if (!paginas.empty() &&
+            syscall(SYS_move_pages, 0, paginas.size(), paginas.data(), nullptr,
+                    estado.data(), 0) == 0) {
+            for (int e : estado) {
+                if (e < 0 || mi_nodo < 0) mia.desconocidas++;
+                else if (e == mi_nodo) mia.locales++;
+                else mia.remotas++;
+            }
+        } else {
+            mia.desconocidas = static_cast<long long>(paginas.size());
+        }
+#else
+        (void)mi_nodo;
+        mia.desconocidas = static_cast<long long>(paginas.size());
+#endif
+
+#pragma omp critical
+        {
+            total.locales += mia.locales;
+            total.remotas += mia.remotas;
+            total.desconocidas += mia.desconocidas;
+        }
+    }
+    return total;
+}
@@ -0,0 +1,173 @@
+/******************************************************************************
+ * operaciones.hpp
+ * Descripción:
+ *  - Familia de núcleos al estilo STREAM, además de la suma C = A + B:
+ *      copia    D = A                  2 accesos por elemento
+ *      escala   D = s*A                2
+ *      suma     D = A + B              3
+ *      triada   D = A + s*B            3  (la "a = b + s*c" de STREAM)
+ *      suma3    D = A + B + C          4  (fusión de dos sumas)
+ *      escsuma  D = s*(A + B)          3  (fusión de suma y escala)
+ *  - El destino es siempre un arreglo distinto de las entradas, de modo que
+ *    todas las operaciones se pueden medir sobre los mismos A, B y C.
+ *  - Cada operación es una estructura con su fórmula por elemento; los
+ *    bucles (secuencial, OpenMP, SIMD y OpenMP+SIMD) son plantillas comunes,
+ *    así que agregar una operación es agregar una estructura.
+ *  - SIMD: el bucle lleva #pragma omp simd y se compila una vez por ISA con
+ *    __attribute__((target(...))); el despacho por CPUID es el de simd.hpp.
+ *    (Las intrínsecas a mano de simd.hpp cubren solo la suma: varias de
+ *    estas operaciones, como el producto int8, no tienen instrucción directa.)
+ *  - Los bytes por elemento se cuentan como STREAM: lecturas + escrituras,
+ *    sin el read-for-ownership del destino.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+#include <vector>
+
+#include "simd.hpp"     // SUMA_X86, SUMA_NEON, soportaAVX512
+
+// ===============================
+// Operaciones: x, y, z son las entradas en orden; s es el escalar.
+// "accesos" = lecturas + escrituras por elemento; "operaciones" = sumas y
+// productos por elemento (la intensidad aritmética del roofline)
+// ===============================
+struct OpCopia {
+    static constexpr const char *nombre = "copia";
+    static constexpr const char *formula = "D = A";
+    static constexpr int accesos = 2;
+    static constexpr int operaciones = 0;
+    template <typename T> static T aplica(const T *x, const T *, const T *, T, long long i) { return x[i]; }
+};
+struct OpEscala {
+    static constexpr const char *nombre = "escala";
+    static constexpr const char *formula = "D = s*A";
+    static constexpr int accesos = 2;
+    static constexpr int operaciones = 1;
+    template <typename T> static T aplica(const T *x, const T *, const T *, T s, long long i) { return static_cast<T>(s * x[i]); }
+};
+struct OpSuma {
+    static constexpr const char *nombre = "suma";
+    static constexpr const char *formula = "D = A + B";
+    static constexpr int accesos = 3;
+    static constexpr int operaciones = 1;
+    template <typename T> static T aplica(const T *x, const T *y, const T *, T, long long i) { return static_cast<T>(x[i] + y[i]); }
+};
+struct OpTriada {
+    static constexpr const char *nombre = "triada";
+    static constexpr const char *formula = "D = A + s*B";
+    static constexpr int accesos = 3;
+    static constexpr int operaciones = 2;
+    template <typename T> static T aplica(const T *x, const T *y, const T *, T s, long long i) { return static_cast<T>(x[i] + s * y[i]); }
+};
+struct OpSuma3 {
+    static constexpr const char *nombre = "suma3";
+    static constexpr const char *formula = "D = A + B + C";
+    static constexpr int accesos = 4;
+    static constexpr int operaciones = 2;
+    template <typename T> static T aplica(const T *x, const T *y, const T *z, T, long long i) { return static_cast<T>(x[i] + y[i] + z[i]); }
+};
+struct OpEscalaSuma {
+    static constexpr const char *nombre = "escsuma";
+    static constexpr const char *formula = "D = s*(A + B)";
+    static constexpr int accesos = 3;
+    static constexpr int operaciones = 2;
+    template <typename T> static T aplica(const T *x, const T *y, const T *, T s, long long i) { return static_cast<T>(s * (x[i] + y[i])); }
+};
+
+// Firma común: out[i] = Op(x, y, z, s, i); cada operación lee solo las
+// entradas que usa, las demás pueden ser nullptr
+template <typename T>
+using FuncionOp = void (*)(T *out, const T *x, const T *y, const T *z, T s, long long n);
+
+// Puntero desplazado que respeta las entradas nulas (no usadas)
+template <typename T>
+inline const T *desplaza(const T *p, long long i) {
+    return p ? p + i : nullptr;
+}
+
+// ===============================
+// Bucles genéricos
+// ===============================
+template <typename Op, typename T>
+void opSecuencial(T *out, const T *x, const T *y, const T *z, T s, long long n) {
+    for (long long i = 0; i < n; i++) {
+        out[i] = Op::aplica(x, y, z, s, i);
+    }
+}
+
+template <typename Op, typename T>
+void opParalela(T *out, const T *x, const T *y, const T *z, T s, long long n, long long chunk) {
+#pragma omp parallel for schedule(static, chunk)
+    for (long long i = 0; i < n; i++) {
+        out[i] = Op::aplica(x, y, z, s, i);
+    }
+}
+
+// Cuerpo SIMD: se instancia dentro de cada función con target distinto
+#define SUMA_CUERPO_OP_SIMD                                           \
+    _Pragma("omp simd")                                               \
+    for (long long i = 0; i < n; i++) {                               \
+        out[i] = Op::aplica(x, y, z, s, i);                           \
+    }
+
+template <typename Op, typename T>
+void opSimdBase(T *out, const T *x, const T *y, const T *z, T s, long long n) {
+    SUMA_CUERPO_OP_SIMD
+}
+
+#ifdef SUMA_X86
+template <typename Op, typename T>
+__attribute__((target("avx2")))
+void opSimdAVX2(T *out, const T *x, const T *y, const T *z, T s, long long n) {
+    SUMA_CUERPO_OP_SIMD
+}
+
+// AVX512F basta para 32 y 64 bits; 8 y 16 bits necesitan BW (simd.hpp)
+template <typename Op, typename T>
+__attribute__((target("avx512f")))
+void opSimdAVX512F(T *out, const T *x, const T *y, const T *z, T s, long long n) {
+    SUMA_CUERPO_OP_SIMD
+}
+
+template <typename Op, typename T>
+__attribute__((target("avx512f,avx512bw")))
+void opSimdAVX512BW(T *out, const T *x, const T *y, const T *z, T s, long long n) {
+    SUMA_CUERPO_OP_SIMD
+}
+#endif
+
+// ===============================
+// Despacho SIMD por CPUID, resuelto una vez por operación y tipo.
+// La base es SSE2 en x86-64 y NEON en AArch64 (el ISA mínimo del compilador).
+// ===============================
+template <typename Op, typename T>
+FuncionOp<T> opSimd() {
+    static const FuncionOp<T> elegida = [] {
+        FuncionOp<T> f = opSimdBase<Op, T>;
+#ifdef SUMA_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) f = opSimdAVX2<Op, T>;
+        if (soportaAVX512<T>()) {
+            if constexpr (AVX512_REQUIERE_BW<T>) f = opSimdAVX512BW<Op, T>;
+            else f = opSimdAVX512F<Op, T>;
+        }
+#endif
+        return f;
+    }();
+    return elegida;
+}
+
+// OpenMP + SIMD: bloques de schedule(static, chunk) con el cuerpo SIMD
+template <typename Op, typename T>
+void opParalelaSimd(T *out, const T *x, const T *y, const T *z, T s, long long n, long long chunk) {
+    const FuncionOp<T> f = opSimd<Op, T>();
+    const long long bloques = (n + chunk - 1) / chunk;
+#pragma omp parallel for schedule(static, 1)
+    for (long long b = 0; b < bloques; b++) {
+        const long long i = b * chunk;
+        const long long m = std::min(chunk, n - i);
+        f(out + i, desplaza(x, i), desplaza(y, i), desplaza(z, i), s, m);
+    }
+}
@@ -0,0 +1,148 @@
+/******************************************************************************
+ * particion.hpp
+ * Descripción:
+ *  - Reparto de C en bloques cuyos límites caen en múltiplos de una línea de
+ *    caché (o de una página). Con chunk = 100 int32 (400 bytes) los límites
+ *    de schedule(static, chunk) caen a mitad de línea y los dos hilos
+ *    vecinos escriben la misma línea de C_par (compartición falsa).
+ *  - El chunk pedido se redondea al múltiplo más cercano de la alineación
+ *    en elementos (mínimo uno). La cabeza, los elementos antes del primer
+ *    límite alineado de C, es un bloque propio; la cola es el último
+ *    bloque, más corto, que termina en n y no comparte su final con nadie.
+ *  - Solo importa la alineación de C: las lecturas de A y B no invalidan
+ *    líneas de otros núcleos.
+ *  - Los bloques se reparten en turno rotativo con schedule(static, 1),
+ *    igual que schedule(static, chunk) sobre los índices.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // max, min
+#include <cstdint>      // uintptr_t
+#include <stdexcept>    // invalid_argument
+#include <string>
+
+#include <unistd.h>     // sysconf
+
+#include "traza.hpp"    // SUMA_TRAZA_TRAMO
+
+// Tamaño de la línea de caché de datos (bytes); 64 si no se puede determinar
+inline long long lineaCache() {
+#ifdef _SC_LEVEL1_DCACHE_LINESIZE
+    long v = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+    if (v > 0) return v;
+#endif
+    return 64;
+}
+
+inline long long tamanoPagina() {
+    long v = sysconf(_SC_PAGESIZE);
+    return v > 0 ? v : 4096;
+}
+
+// ===============================
+// Alineación de los límites de bloque: --alinear=no|linea|pagina
+// ===============================
+enum class AlineacionChunk { Ninguna, Linea, Pagina };
+
+inline AlineacionChunk alineacionDesdeNombre(const std::string &nombre) {
+    if (nombre == "no") return AlineacionChunk::Ninguna;
+    if (nombre == "linea") return AlineacionChunk::Linea;
+    if (nombre == "pagina") return AlineacionChunk::Pagina;
+    throw std::invalid_argument("alineacion desconocida: '" + nombre + "'");
+}
+
+inline const char *nombreAlineacion(AlineacionChunk a) {
+    switch (a) {
+        case AlineacionChunk::Linea:  return "linea";
+        case AlineacionChunk::Pagina: return "pagina";
+        default:                      return "no";
+    }
+}
+
+inline long long bytesAlineacion(AlineacionChunk a) {
+    switch (a) {
+        case AlineacionChunk::Linea:  return lineaCache();
+        case AlineacionChunk::Pagina: return tamanoPagina();
+        default:                      return 1;
+    }
+}
+
+// ===============================
+// Bloques de una partición: [0, cabeza) y luego bloques de "chunk"
+// elementos desde "cabeza" hasta n
+// ===============================
+struct Particion {
+    long long n = 0;
+    long long cabeza = 0;       // Elementos antes del primer límite alineado
+    long long chunk = 1;        // Elementos por bloque (múltiplo de la alineación)
+    long long alineacion = 1;   // Bytes
+
+    long long bloques() const {
+        return (cabeza > 0 ? 1 : 0) + (n - cabeza + chunk - 1) / chunk;
+    }
+    long long inicio(long long b) const {
+        if (cabeza > 0) {
+            if (b == 0) return 0;
+            b--;
+        }
+        return cabeza + b * chunk;
+    }
+    long long fin(long long b) const {
+        if (cabeza > 0 && b == 0) return cabeza;
+        return std::min(n, inicio(b) + chunk);
+    }
+    // Elementos del último bloque si no llega a "chunk" (0 si es completo)
+    long long cola() const { return (n - cabeza) % chunk; }
+};
+
+// Partición de "destino" (n elementos) con el chunk pedido redondeado a la
+// alineación; sin alineación es la de schedule(static, chunk)
+template <typename T>
+Particion particiona(const T *destino, long long n, long long chunk, AlineacionChunk alineacion) {
+    Particion p;
+    p.n = n;
+    p.alineacion = bytesAlineacion(alineacion);
+    const long long ancho = static_cast<long long>(sizeof(T));
+    const long long unidad = std::max(1LL, p.alineacion / ancho);
+    p.chunk = std::max(unidad, (chunk + unidad / 2) / unidad * unidad);
+    const long long desfase = static_cast<long long>(reinterpret_cast<std::uintptr_t>(destino) % p.alineacion);
+    // Un T que no cae en múltiplo de su tamaño no se puede alinear: sin cabeza
+    if (desfase > 0 && (p.alineacion - desfase) % ancho == 0) {
+        p.cabeza = std::min(n, (p.alineacion - desfase) / ancho);
+    }
+    return p;
+}
+
+// Límites entre bloques vecinos que caen a mitad de línea de "destino"
+// (cada uno es una línea escrita por dos hilos si hay más de uno)
+template <typename T>
+long long limitesCompartidos(const T *destino, const Particion &p) {
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(destino);
+    const long long linea = lineaCache();
+    long long compartidos = 0;
+    for (long long b = 1; b < p.bloques(); b++) {
+        if ((base + p.inicio(b) * sizeof(T)) % linea != 0) compartidos++;
+    }
+    return compartidos;
+}
+
+// ===============================
+// Suma paralela sobre una partición: bloque b al hilo b mod hilos
+// ===============================
+template <typename T>
+void sumaParticionada(const T *A, const T *B, T *C, const Particion &p) {
+    const long long bloques = p.bloques();
+#pragma omp parallel
+    {
+        SUMA_TRAZA_TRAMO("suma (alineado)", -1);
+#pragma omp for schedule(static, 1) nowait
+        for (long long b = 0; b < bloques; b++) {
+            SUMA_TRAZA_TRAMO("suma (alineado)", b);
+            const long long fin = p.fin(b);
+            for (long long i = p.inicio(b); i < fin; i++) {
+                C[i] = static_cast<T>(A[i] + B[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * planificacion.hpp
+ * Descripción:
+ *  - Políticas de reparto del for paralelo seleccionables con --schedule:
+ *      static, dynamic, guided (con --chunk), auto, y runtime (la que diga
+ *      OMP_SCHEDULE, sin tocarla).
+ *  - static usa el bucle original con schedule(static, chunk) fijo en
+ *    compilación; las demás usan schedule(runtime) tras omp_set_schedule.
+ *  - Telemetría por hilo: iteraciones, tiempo ocupado dentro del for y
+ *    tiempo de espera en la barrera implícita (medidos con omp_get_wtime).
+ *    El desbalance es max(ocupado) / media(ocupado): 1.00 es reparto perfecto.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // max
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+#include "configuracion.hpp"  // Configuracion, PLANIFICACIONES
+#include "kernels.hpp"        // sumaParalela
+
+// ===============================
+// Fija la política del runtime para los for con schedule(runtime)
+// ===============================
+inline void aplicaPlanificacion(const std::string &politica, long long chunk) {
+    const int c = static_cast<int>(std::min<long long>(chunk, 1 << 30));
+    if (politica == "static") omp_set_schedule(omp_sched_static, c);
+    else if (politica == "dynamic") omp_set_schedule(omp_sched_dynamic, c);
+    else if (politica == "guided") omp_set_schedule(omp_sched_guided, c);
+    else if (politica == "auto") omp_set_schedule(omp_sched_auto, 0);
+    // "runtime": se respeta lo que venga de OMP_SCHEDULE
+}
+
+// Descripción de la política efectiva, p. ej. "dynamic,100"
+inline std::string describePlanificacion() {
+    omp_sched_t tipo;
+    int chunk = 0;
+    omp_get_schedule(&tipo, &chunk);
+    std::string nombre;
+    switch (tipo & ~omp_sched_monotonic) {
+        case omp_sched_static:  nombre = "static"; break;
+        case omp_sched_dynamic: nombre = "dynamic"; break;
+        case omp_sched_guided:  nombre = "guided"; break;
+        default:                return "auto";   // auto no usa chunk
+    }
+    return chunk > 0 ? nombre + "," + std::to_string(chunk) : nombre;
+}
+
+// ===============================
+// Suma paralela con la política del runtime
+// ===============================
+template <typename T>
+void sumaParalelaRuntime(const T *A, const T *B, T *C, long long n) {
+#pragma omp parallel shared(A, B, C)
+    {
+        SUMA_TRAZA_TRAMO("suma", -1);
+#pragma omp for schedule(runtime) nowait
+        for (long long i = 0; i < n; i++) {
+            C[i] = static_cast<T>(A[i] + B[i]);
+        }
+    }
+}
+
+// Suma paralela con la política de la configuración
+template <typename T>
+void sumaParalelaPlanificada(const Configuracion &cfg, const T *A, const T *B, T *C, long long n) {
+    if (cfg.schedule == "static") {
+        sumaParalela(A, B, C, n, cfg.chunk);
+    } else {
+        sumaParalelaRuntime(A, B, C, n);
+    }
+}
+
+// ===============================
+// Telemetría por hilo (acumulable entre repeticiones)
+// ===============================
+struct TelemetriaHilo {
+    long long iteraciones = 0;
+    double ocupado_ms = 0.0;   // Dentro del for
+    double espera_ms = 0.0;    // En la barrera, esperando al más lento
+};
+
+// Suma con schedule(runtime) que registra la telemetría de cada hilo
+template <typename T>
+void sumaParalelaTelemetria(const T *A, const T *B, T *C, long long n,
+                            std::vector<TelemetriaHilo> &tele) {
+    tele.resize(omp_get_max_threads());
+#pragma omp parallel
+    {
+        const int t = omp_get_thread_num();
+        long long iteraciones = 0;
+        const double t0 = omp_get_wtime();
+#pragma omp for schedule(runtime) nowait
+        for (long long i = 0; i < n; i++) {
+            C[i] = static_cast<T>(A[i] + B[i]);
+            iteraciones++;
+        }
+        const double t1 = omp_get_wtime();
+#pragma omp barrier
+        const double t2 = omp_get_wtime();
+        tele[t].iteraciones += iteraciones;
+        tele[t].ocupado_ms += (t1 - t0) * 1.0e3;
+        tele[t].espera_ms += (t2 - t1) * 1.0e3;
+    }
+}
+
+// ===============================
+// Resumen de la telemetría
+// ===============================
+struct ResumenTelemetria {
+    double desbalance = 1.0;     // max(ocupado) / media(ocupado)
+    double espera_pct = 0.0;     // espera total / (ocupado + espera) total
+};
+
+inline ResumenTelemetria resumeTelemetria(const std::vector<TelemetriaHilo> &tele) {
+    ResumenTelemetria r;
+    double suma = 0.0, maximo = 0.0, espera = 0.0;
+    for (const TelemetriaHilo &h : tele) {
+        suma += h.ocupado_ms;
+        maximo = std::max(maximo, h.ocupado_ms);
+        espera += h.espera_ms;
+    }
+    if (!tele.empty() && suma > 0.0) r.desbalance = maximo / (suma / tele.size());
+    if (suma + espera > 0.0) r.espera_pct = 100.0 * espera / (suma + espera);
+    return r;
+}
+
+inline void imprimeTelemetria(const std::vector<TelemetriaHilo> &tele, int repeticiones) {
+    std::cout << std::setw(6) << "hilo" << std::setw(14) << "iteraciones"
+              << std::setw(14) << "ocupado(ms)" << std::setw(14) << "espera(ms)" << "\n";
+    for (std::size_t t = 0; t < tele.size(); t++) {
+        std::cout << std::setw(6) << t << std::setw(14) << tele[t].iteraciones / repeticiones
+                  << std::fixed << std::setprecision(4)
+                  << std::setw(14) << tele[t].ocupado_ms / repeticiones
+                  << std::setw(14) << tele[t].espera_ms / repeticiones << "\n";
+    }
+    ResumenTelemetria r = resumeTelemetria(tele);
+    std::cout << std::setprecision(2) << "Desbalance (max/media ocupado): " << r.desbalance
+              << "  espera en barrera: " << std::setprecision(1) << r.espera_pct << "%\n";
+}
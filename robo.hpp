@@ -0,0 +1,191 @@
+/******************************************************************************
+ * robo.hpp
+ * Descripción:
+ *  - Alternativas con robo de trabajo al for con schedule(static, chunk):
+ *      (1) sumaTaskloop: #pragma omp taskloop con grainsize(grano); el
+ *          runtime reparte las tareas y los hilos ociosos las roban.
+ *      (2) sumaRobo: planificador propio con una deque Chase–Lev por hilo
+ *          (sin cerrojos). Cada hilo empieza con su tramo contiguo, lo parte
+ *          por la mitad hasta "grano" dejando las mitades altas en su deque,
+ *          y al quedarse sin trabajo roba la mitad más antigua (la más
+ *          grande) de una víctima al azar.
+ *  - Si un núcleo queda desalojado (VM compartida), con static su tramo
+ *    retrasa a todos; con robo los demás se llevan su trabajo pendiente.
+ *  - La deque no crece: cada partición deja como mucho una mitad en la
+ *    deque, así que la profundidad está acotada por log2(n / grano) < 64.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+#include <atomic>
+#include <cstdint>
+#include <memory>       // unique_ptr
+#include <thread>       // this_thread::yield
+#include <omp.h>
+
+#include "equipo.hpp"   // pausaCpu
+
+// Grano automático: ~32 tareas por hilo y nunca menos que chunk
+inline long long granoRobo(long long n, long long chunk, long long grano, int hilos) {
+    if (grano > 0) return grano;
+    return std::max(chunk, n / (32LL * hilos));
+}
+
+// ===============================
+// (1) taskloop: un hilo genera las tareas, todos las ejecutan
+// ===============================
+template <typename T>
+void sumaTaskloop(const T *A, const T *B, T *C, long long n, long long grano) {
+#pragma omp parallel
+#pragma omp single
+#pragma omp taskloop grainsize(grano)
+    for (long long i = 0; i < n; i++) {
+        C[i] = static_cast<T>(A[i] + B[i]);
+    }
+}
+
+// ===============================
+// Deque Chase–Lev de tamaño fijo (versión C11 de Lê et al., PPoPP'13).
+// El dueño empuja y saca por abajo; los ladrones roban por arriba.
+// Los campos del rango son atómicos relajados: un ladrón puede leer una
+// casilla que el dueño reescribe, pero en ese caso su CAS falla y descarta
+// lo leído.
+// ===============================
+struct RangoRobo {
+    long long inicio = 0;
+    long long fin = 0;
+    long long tamano() const { return fin - inicio; }
+};
+
+class alignas(64) DequeRobo {
+public:
+    static constexpr long long CAPACIDAD = 64;
+
+    void reinicia() {
+        arriba_.store(0, std::memory_order_relaxed);
+        abajo_.store(0, std::memory_order_relaxed);
+    }
+
+    void empuja(const RangoRobo &r) {
+        const long long b = abajo_.load(std::memory_order_relaxed);
+        Casilla &c = buffer_[b & (CAPACIDAD - 1)];
+        c.inicio.store(r.inicio, std::memory_order_relaxed);
+        c.fin.store(r.fin, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        abajo_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    bool saca(RangoRobo &r) {
+        const long long b = abajo_.load(std::memory_order_relaxed) - 1;
+        abajo_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long t = arriba_.load(std::memory_order_relaxed);
+        if (t > b) {                       // Vacía
+            abajo_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        lee(b, r);
+        if (t == b) {                      // Último elemento: se compite con los ladrones
+            const bool gano = arriba_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                              std::memory_order_relaxed);
+            abajo_.store(b + 1, std::memory_order_relaxed);
+            return gano;
+        }
+        return true;
+    }
+
+    bool roba(RangoRobo &r) {
+        long long t = arriba_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const long long b = abajo_.load(std::memory_order_acquire);
+        if (t >= b) return false;
+        lee(t, r);
+        return arriba_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed);
+    }
+
+private:
+    struct Casilla {
+        std::atomic<long long> inicio{0};
+        std::atomic<long long> fin{0};
+    };
+
+    void lee(long long i, RangoRobo &r) const {
+        const Casilla &c = buffer_[i & (CAPACIDAD - 1)];
+        r.inicio = c.inicio.load(std::memory_order_relaxed);
+        r.fin = c.fin.load(std::memory_order_relaxed);
+    }
+
+    std::atomic<long long> arriba_{0};
+    alignas(64) std::atomic<long long> abajo_{0};
+    Casilla buffer_[CAPACIDAD];
+};
+
+// Contadores opcionales de sumaRobo (acumulados entre llamadas)
+struct ContadoresRobo {
+    std::atomic<long long> robos{0};
+    std::atomic<long long> intentos{0};
+};
+
+// ===============================
+// (2) Suma con robo de trabajo sobre deques Chase–Lev.
+// La terminación se detecta con un contador global de elementos pendientes.
+// ===============================
+template <typename T>
+void sumaRobo(const T *A, const T *B, T *C, long long n, long long grano,
+              ContadoresRobo *contadores = nullptr) {
+    const int hilos = omp_get_max_threads();
+    std::unique_ptr<DequeRobo[]> deques(new DequeRobo[hilos]);
+    alignas(64) std::atomic<long long> pendientes{n};
+
+#pragma omp parallel num_threads(hilos)
+    {
+        const int id = omp_get_thread_num();
+        const int h = omp_get_num_threads();
+        DequeRobo &propia = deques[id];
+        propia.empuja({n * id / h, n * (id + 1) / h});
+#pragma omp barrier
+
+        std::uint64_t estado = 0x9E3779B97F4A7C15ULL * (id + 1);   // xorshift por hilo
+        long long robos = 0, intentos = 0;
+        int fallidos = 0;   // Robos fallidos seguidos: tras 64 se cede la CPU
+        RangoRobo r;
+        for (;;) {
+            if (!propia.saca(r)) {
+                if (pendientes.load(std::memory_order_acquire) == 0) break;
+                if (h == 1) continue;
+                estado ^= estado << 13;
+                estado ^= estado >> 7;
+                estado ^= estado << 17;
+                int victima = static_cast<int>(estado % (h - 1));
+                if (victima >= id) victima++;
+                intentos++;
+                if (!deques[victima].roba(r)) {
+                    if (++fallidos < 64) pausaCpu();
+                    else std::this_thread::yield();
+                    continue;
+                }
+                fallidos = 0;
+                robos++;
+            }
+            // Se parte por la mitad dejando la parte alta a la vista de los ladrones
+            while (r.tamano() > grano) {
+                const long long medio = r.inicio + r.tamano() / 2;
+                propia.empuja({medio, r.fin});
+                r.fin = medio;
+            }
+            const T *a = A;
+            const T *b = B;
+            T *c = C;
+            for (long long i = r.inicio; i < r.fin; i++) {
+                c[i] = static_cast<T>(a[i] + b[i]);
+            }
+            pendientes.fetch_sub(r.tamano(), std::memory_order_release);
+        }
+        if (contadores) {
+            contadores->robos.fetch_add(robos, std::memory_order_relaxed);
+            contadores->intentos.fetch_add(intentos, std::memory_order_relaxed);
+        }
+    }
+}
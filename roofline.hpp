@@ -0,0 +1,179 @@
+/******************************************************************************
+ * roofline.hpp
+ * Descripción:
+ *  - Sondas del modelo roofline del nodo:
+ *      ancho de banda sostenible: triada de STREAM (a = b + s*c) en double
+ *        con OpenMP+SIMD, arreglos de al menos 4 x LLC cada uno y el mejor
+ *        tiempo de las repeticiones (la regla de STREAM)
+ *      pico de cómputo: sumas en el tipo de elemento sobre 8 registros
+ *        vectoriales independientes, sin accesos a memoria; se compila una vez
+ *        por ISA y se despacha por CPUID como en operaciones.hpp
+ *    Las dos se miden con 1 hilo (por núcleo) y con el equipo completo.
+ *  - Intensidad aritmética (ops/byte) = operaciones / (accesos x sizeof(T)),
+ *    con los bytes contados como STREAM. La suma C = A + B hace 1 operación
+ *    por 3 accesos: 1/12 ops/byte en int32, muy por debajo del punto de
+ *    quiebre pico / ancho de banda, así que su techo es AI x ancho de banda.
+ *  - El pico cuenta sumas simples; una triada que el compilador fusiona en
+ *    FMA hace 2 operaciones por instrucción y puede acercarse al doble.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // max, min
+#include <vector>
+
+#include <omp.h>
+
+#include "aleatorio.hpp"     // inicializaArreglosParalelo
+#include "benchmark.hpp"     // mide, gbPorSegundo
+#include "memoria.hpp"       // BufferAlineado
+#include "numa.hpp"          // ceroParalelo
+#include "operaciones.hpp"   // OpTriada, opParalelaSimd
+#include "simd.hpp"          // SUMA_X86, soportaAVX512
+#include "streaming.hpp"     // tamanoLLC
+
+// ===============================
+// Pico de cómputo: 8 acumuladores de "bytes_vector" bytes (vectores de GCC,
+// que quedan en registros), cada uno con su propia cadena de dependencias.
+// Devuelve la suma de los carriles (para que el bucle no se elimine) y las
+// operaciones hechas. El que llama pasa paso = 0: los enteros no desbordan y
+// el compilador no lo sabe, porque la llamada es por puntero.
+// ===============================
+#define SUMA_CUERPO_PICO(bytes_vector)                                        \
+    typedef T V __attribute__((vector_size(bytes_vector)));                   \
+    constexpr int carriles = (bytes_vector) / static_cast<int>(sizeof(T));    \
+    V a0 = V{} + paso, a1 = a0 + paso, a2 = a1 + paso, a3 = a2 + paso;        \
+    V a4 = a3 + paso, a5 = a4 + paso, a6 = a5 + paso, a7 = a6 + paso;         \
+    for (long long r = 0; r < vueltas; r++) {                                 \
+        a0 += paso; a1 += paso; a2 += paso; a3 += paso;                       \
+        a4 += paso; a5 += paso; a6 += paso; a7 += paso;                       \
+    }                                                                         \
+    V v = ((a0 + a1) + (a2 + a3)) + ((a4 + a5) + (a6 + a7));                   \
+    T total = T(0);                                                           \
+    for (int j = 0; j < carriles; j++) total = static_cast<T>(total + v[j]);  \
+    *operaciones = 8 * carriles * vueltas;                                    \
+    return total;
+
+template <typename T>
+using FuncionPico = T (*)(T paso, long long vueltas, long long *operaciones);
+
+template <typename T>
+T picoBase(T paso, long long vueltas, long long *operaciones) {
+    SUMA_CUERPO_PICO(16)
+}
+
+#ifdef SUMA_X86
+template <typename T>
+__attribute__((target("avx2")))
+T picoAVX2(T paso, long long vueltas, long long *operaciones) {
+    SUMA_CUERPO_PICO(32)
+}
+
+// Sin BW solo las sumas de 8 y 16 bits quedan fuera de AVX-512 (simd.hpp)
+template <typename T>
+__attribute__((target("avx512f")))
+T picoAVX512F(T paso, long long vueltas, long long *operaciones) {
+    SUMA_CUERPO_PICO(64)
+}
+
+template <typename T>
+__attribute__((target("avx512f,avx512bw")))
+T picoAVX512BW(T paso, long long vueltas, long long *operaciones) {
+    SUMA_CUERPO_PICO(64)
+}
+#endif
+
+template <typename T>
+FuncionPico<T> picoSimd() {
+    static const FuncionPico<T> elegida = [] {
+        FuncionPico<T> f = picoBase<T>;
+#ifdef SUMA_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) f = picoAVX2<T>;
+        if (soportaAVX512<T>()) {
+            if constexpr (AVX512_REQUIERE_BW<T>) f = picoAVX512BW<T>;
+            else f = picoAVX512F<T>;
+        }
+#endif
+        return f;
+    }();
+    return elegida;
+}
+
+// ===============================
+// Resultado de las sondas con un número de hilos dado
+// ===============================
+struct SondaRoofline {
+    int hilos = 1;
+    double gb_s = 0.0;     // Triada STREAM, mejor tiempo
+    double gops_s = 0.0;   // Pico de sumas en el tipo de elemento
+    // Punto de quiebre: a partir de esta intensidad manda el cómputo
+    double quiebre() const { return gb_s > 0.0 ? gops_s / gb_s : 0.0; }
+    // Techo (Gops/s) para una intensidad aritmética "ai" en ops/byte
+    double techo(double ai) const { return std::min(gops_s, ai * gb_s); }
+};
+
+// Elementos por arreglo de la sonda: 4 x LLC (o 32 MB sin dato), mínimo 2^22
+inline long long elementosSonda(long long pedidos) {
+    if (pedidos > 0) return pedidos;
+    long long llc = tamanoLLC();
+    long long bytes = 4 * (llc > 0 ? llc : 32LL * 1024 * 1024);
+    return std::max(bytes / static_cast<long long>(sizeof(double)), 1LL << 22);
+}
+
+// Ancho de banda sostenible (GB/s) de la triada con "hilos" hilos
+inline double sondeaAnchoBanda(const double *b, const double *c, double *a, long long n,
+                               long long chunk, int hilos, int repeticiones) {
+    omp_set_num_threads(hilos);
+    Estadisticas e = mide([&] {
+        opParalelaSimd<OpTriada, double>(a, b, c, nullptr, 3.0, n, chunk);
+    }, 1, repeticiones);
+    return gbPorSegundo(static_cast<double>(OpTriada::accesos) * sizeof(double) * n, e.minimo);
+}
+
+// Pico de cómputo (Gops/s) con "hilos" hilos; cada hilo corre el núcleo completo
+template <typename T>
+double sondeaPico(int hilos, int repeticiones) {
+    const FuncionPico<T> f = picoSimd<T>();
+    const long long vueltas = 1LL << 20;
+    std::vector<T> sumidero(hilos);
+    long long operaciones = 0;
+    Estadisticas e = mide([&] {
+#pragma omp parallel num_threads(hilos)
+        {
+            long long ops = 0;
+            sumidero[omp_get_thread_num()] = f(T(0), vueltas, &ops);
+#pragma omp single
+            operaciones = ops * omp_get_num_threads();
+        }
+    }, 1, repeticiones);
+    return e.minimo > 0.0 ? operaciones / (e.minimo * 1.0e6) : 0.0;
+}
+
+// Ambas sondas para cada número de hilos; reserva e inicializa los arreglos de la triada
+template <typename T>
+std::vector<SondaRoofline> sondeaRoofline(const std::vector<int> &hilos, long long n_sonda,
+                                          long long chunk, int repeticiones, bool paginas_grandes) {
+    const long long n = elementosSonda(n_sonda);
+    BufferAlineado<double> bufA(n, paginas_grandes);
+    BufferAlineado<double> bufB(n, paginas_grandes);
+    BufferAlineado<double> bufC(n, paginas_grandes);
+    inicializaArreglosParalelo(bufB.data(), bufC.data(), n, chunk, 1);
+    ceroParalelo(bufA.data(), n, chunk);
+
+    std::vector<SondaRoofline> sondas;
+    for (int h : hilos) {
+        SondaRoofline s;
+        s.hilos = h;
+        s.gb_s = sondeaAnchoBanda(bufB.data(), bufC.data(), bufA.data(), n, chunk, h, repeticiones);
+        s.gops_s = sondeaPico<T>(h, repeticiones);
+        sondas.push_back(s);
+    }
+    return sondas;
+}
+
+// Intensidad aritmética (ops/byte) de una operación sobre elementos de tipo T
+template <typename T>
+constexpr double intensidadAritmetica(int operaciones, int accesos) {
+    return static_cast<double>(operaciones) / (static_cast<double>(accesos) * sizeof(T));
+}
@@ -0,0 +1,351 @@
+/******************************************************************************
+ * simd.hpp
+ * Descripción:
+ *  - Variantes explícitas de C = A + B con intrínsecas, para cada tipo de
+ *    elemento (int8/16/32/64, float, double):
+ *      (1) SSE2     (registros de 128 bits)
+ *      (2) AVX2     (256 bits)
+ *      (3) AVX-512  (512 bits; F + BW para int8/int16)
+ *      (4) NEON     (128 bits, ARM)
+ *  - Por ISA hay una estructura de operaciones (carga, suma, guarda, guarda
+ *    no temporal) especializada por tipo; el bucle de cada ISA es una sola
+ *    plantilla sobre esas operaciones.
+ *  - Cada variante x86 se compila con __attribute__((target(...))), así que el
+ *    archivo no requiere -mavx2/-mavx512f: el binario corre en cualquier CPU
+ *    y la variante se elige al arrancar consultando CPUID
+ *    (__builtin_cpu_supports).
+ *  - Las cargas/escrituras son no alineadas (loadu/storeu) porque los bloques
+ *    de schedule(static, chunk) empiezan en cualquier índice; sobre memoria
+ *    alineada cuestan lo mismo que las alineadas.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <type_traits> // is_same
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SUMA_X86 1
+#include <immintrin.h>  // SSE2, AVX2, AVX-512
+#elif defined(__ARM_NEON)
+#define SUMA_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include "kernels.hpp"  // FuncionSumaT, sumaSecuencial
+
+// ===============================
+// Cola escalar común: los elementos que no llenan un registro
+// ===============================
+template <typename T>
+inline void sumaCola(const T *A, const T *B, T *C, long long i, long long n) {
+    for (; i < n; i++) {
+        C[i] = static_cast<T>(A[i] + B[i]);
+    }
+}
+
+#ifdef SUMA_X86
+#define SUMA_SSE2 __attribute__((target("sse2"), always_inline)) static inline
+#define SUMA_AVX2 __attribute__((target("avx2"), always_inline)) static inline
+#define SUMA_AVX512 __attribute__((target("avx512f"), always_inline)) static inline
+// Sumas y máscaras de 8 y 16 bits: solo existen en AVX512BW
+#define SUMA_AVX512BW __attribute__((target("avx512f,avx512bw"), always_inline)) static inline
+
+// ===============================
+// Operaciones SSE2 por tipo
+// ===============================
+template <typename T> struct OpsSSE2;
+
+struct EnterosSSE2 {
+    using V = __m128i;
+    template <typename T> SUMA_SSE2 V carga(const T *p) { return _mm_loadu_si128(reinterpret_cast<const V *>(p)); }
+    template <typename T> SUMA_SSE2 void guarda(T *p, V v) { _mm_storeu_si128(reinterpret_cast<V *>(p), v); }
+    template <typename T> SUMA_SSE2 void guardaStream(T *p, V v) { _mm_stream_si128(reinterpret_cast<V *>(p), v); }
+};
+template <> struct OpsSSE2<std::int8_t> : EnterosSSE2 { SUMA_SSE2 V suma(V a, V b) { return _mm_add_epi8(a, b); } };
+template <> struct OpsSSE2<std::int16_t> : EnterosSSE2 { SUMA_SSE2 V suma(V a, V b) { return _mm_add_epi16(a, b); } };
+template <> struct OpsSSE2<std::int32_t> : EnterosSSE2 { SUMA_SSE2 V suma(V a, V b) { return _mm_add_epi32(a, b); } };
+template <> struct OpsSSE2<std::int64_t> : EnterosSSE2 { SUMA_SSE2 V suma(V a, V b) { return _mm_add_epi64(a, b); } };
+template <> struct OpsSSE2<float> {
+    using V = __m128;
+    SUMA_SSE2 V carga(const float *p) { return _mm_loadu_ps(p); }
+    SUMA_SSE2 void guarda(float *p, V v) { _mm_storeu_ps(p, v); }
+    SUMA_SSE2 void guardaStream(float *p, V v) { _mm_stream_ps(p, v); }
+    SUMA_SSE2 V suma(V a, V b) { return _mm_add_ps(a, b); }
+};
+template <> struct OpsSSE2<double> {
+    using V = __m128d;
+    SUMA_SSE2 V carga(const double *p) { return _mm_loadu_pd(p); }
+    SUMA_SSE2 void guarda(double *p, V v) { _mm_storeu_pd(p, v); }
+    SUMA_SSE2 void guardaStream(double *p, V v) { _mm_stream_pd(p, v); }
+    SUMA_SSE2 V suma(V a, V b) { return _mm_add_pd(a, b); }
+};
+
+// ===============================
+// Operaciones AVX2 por tipo
+// ===============================
+template <typename T> struct OpsAVX2;
+
+struct EnterosAVX2 {
+    using V = __m256i;
+    template <typename T> SUMA_AVX2 V carga(const T *p) { return _mm256_loadu_si256(reinterpret_cast<const V *>(p)); }
+    template <typename T> SUMA_AVX2 void guarda(T *p, V v) { _mm256_storeu_si256(reinterpret_cast<V *>(p), v); }
+    template <typename T> SUMA_AVX2 void guardaStream(T *p, V v) { _mm256_stream_si256(reinterpret_cast<V *>(p), v); }
+};
+template <> struct OpsAVX2<std::int8_t> : EnterosAVX2 { SUMA_AVX2 V suma(V a, V b) { return _mm256_add_epi8(a, b); } };
+template <> struct OpsAVX2<std::int16_t> : EnterosAVX2 { SUMA_AVX2 V suma(V a, V b) { return _mm256_add_epi16(a, b); } };
+template <> struct OpsAVX2<std::int32_t> : EnterosAVX2 { SUMA_AVX2 V suma(V a, V b) { return _mm256_add_epi32(a, b); } };
+template <> struct OpsAVX2<std::int64_t> : EnterosAVX2 { SUMA_AVX2 V suma(V a, V b) { return _mm256_add_epi64(a, b); } };
+template <> struct OpsAVX2<float> {
+    using V = __m256;
+    SUMA_AVX2 V carga(const float *p) { return _mm256_loadu_ps(p); }
+    SUMA_AVX2 void guarda(float *p, V v) { _mm256_storeu_ps(p, v); }
+    SUMA_AVX2 void guardaStream(float *p, V v) { _mm256_stream_ps(p, v); }
+    SUMA_AVX2 V suma(V a, V b) { return _mm256_add_ps(a, b); }
+};
+template <> struct OpsAVX2<double> {
+    using V = __m256d;
+    SUMA_AVX2 V carga(const double *p) { return _mm256_loadu_pd(p); }
+    SUMA_AVX2 void guarda(double *p, V v) { _mm256_storeu_pd(p, v); }
+    SUMA_AVX2 void guardaStream(double *p, V v) { _mm256_stream_pd(p, v); }
+    SUMA_AVX2 V suma(V a, V b) { return _mm256_add_pd(a, b); }
+};
+
+// ===============================
+// Operaciones AVX-512 por tipo (incluye la suma enmascarada de la cola)
+// ===============================
+template <typename T> struct OpsAVX512;
+
+struct EnterosAVX512 {
+    using V = __m512i;
+    template <typename T> SUMA_AVX512 V carga(const T *p) { return _mm512_loadu_si512(p); }
+    template <typename T> SUMA_AVX512 void guarda(T *p, V v) { _mm512_storeu_si512(p, v); }
+    template <typename T> SUMA_AVX512 void guardaStream(T *p, V v) { _mm512_stream_si512(reinterpret_cast<V *>(p), v); }
+};
+template <> struct OpsAVX512<std::int8_t> : EnterosAVX512 {
+    SUMA_AVX512BW V suma(V a, V b) { return _mm512_add_epi8(a, b); }
+    SUMA_AVX512BW void sumaMascara(const std::int8_t *A, const std::int8_t *B, std::int8_t *C, long long r) {
+        __mmask64 m = (1ull << r) - 1;
+        _mm512_mask_storeu_epi8(C, m, _mm512_add_epi8(_mm512_maskz_loadu_epi8(m, A), _mm512_maskz_loadu_epi8(m, B)));
+    }
+};
+template <> struct OpsAVX512<std::int16_t> : EnterosAVX512 {
+    SUMA_AVX512BW V suma(V a, V b) { return _mm512_add_epi16(a, b); }
+    SUMA_AVX512BW void sumaMascara(const std::int16_t *A, const std::int16_t *B, std::int16_t *C, long long r) {
+        __mmask32 m = static_cast<__mmask32>((1ull << r) - 1);
+        _mm512_mask_storeu_epi16(C, m, _mm512_add_epi16(_mm512_maskz_loadu_epi16(m, A), _mm512_maskz_loadu_epi16(m, B)));
+    }
+};
+template <> struct OpsAVX512<std::int32_t> : EnterosAVX512 {
+    SUMA_AVX512 V suma(V a, V b) { return _mm512_add_epi32(a, b); }
+    SUMA_AVX512 void sumaMascara(const std::int32_t *A, const std::int32_t *B, std::int32_t *C, long long r) {
+        __mmask16 m = static_cast<__mmask16>((1u << r) - 1);
+        _mm512_mask_storeu_epi32(C, m, _mm512_add_epi32(_mm512_maskz_loadu_epi32(m, A), _mm512_maskz_loadu_epi32(m, B)));
+    }
+};
+template <> struct OpsAVX512<std::int64_t> : EnterosAVX512 {
+    SUMA_AVX512 V suma(V a, V b) { return _mm512_add_epi64(a, b); }
+    SUMA_AVX512 void sumaMascara(const std::int64_t *A, const std::int64_t *B, std::int64_t *C, long long r) {
+        __mmask8 m = static_cast<__mmask8>((1u << r) - 1);
+        _mm512_mask_storeu_epi64(C, m, _mm512_add_epi64(_mm512_maskz_loadu_epi64(m, A), _mm512_maskz_loadu_epi64(m, B)));
+    }
+};
+template <> struct OpsAVX512<float> {
+    using V = __m512;
+    SUMA_AVX512 V carga(const float *p) { return _mm512_loadu_ps(p); }
+    SUMA_AVX512 void guarda(float *p, V v) { _mm512_storeu_ps(p, v); }
+    SUMA_AVX512 void guardaStream(float *p, V v) { _mm512_stream_ps(p, v); }
+    SUMA_AVX512 V suma(V a, V b) { return _mm512_add_ps(a, b); }
+    SUMA_AVX512 void sumaMascara(const float *A, const float *B, float *C, long long r) {
+        __mmask16 m = static_cast<__mmask16>((1u << r) - 1);
+        _mm512_mask_storeu_ps(C, m, _mm512_add_ps(_mm512_maskz_loadu_ps(m, A), _mm512_maskz_loadu_ps(m, B)));
+    }
+};
+template <> struct OpsAVX512<double> {
+    using V = __m512d;
+    SUMA_AVX512 V carga(const double *p) { return _mm512_loadu_pd(p); }
+    SUMA_AVX512 void guarda(double *p, V v) { _mm512_storeu_pd(p, v); }
+    SUMA_AVX512 void guardaStream(double *p, V v) { _mm512_stream_pd(p, v); }
+    SUMA_AVX512 V suma(V a, V b) { return _mm512_add_pd(a, b); }
+    SUMA_AVX512 void sumaMascara(const double *A, const double *B, double *C, long long r) {
+        __mmask8 m = static_cast<__mmask8>((1u << r) - 1);
+        _mm512_mask_storeu_pd(C, m, _mm512_add_pd(_mm512_maskz_loadu_pd(m, A), _mm512_maskz_loadu_pd(m, B)));
+    }
+};
+
+// ===============================
+// Bucles por ISA: L elementos por registro
+// ===============================
+template <typename T>
+__attribute__((target("sse2")))
+void sumaSSE2(const T *A, const T *B, T *C, long long n) {
+    using O = OpsSSE2<T>;
+    constexpr long long L = 16 / sizeof(T);
+    long long i = 0;
+    for (; i + L <= n; i += L) {
+        O::guarda(C + i, O::suma(O::carga(A + i), O::carga(B + i)));
+    }
+    sumaCola(A, B, C, i, n);
+}
+
+template <typename T>
+__attribute__((target("avx2")))
+void sumaAVX2(const T *A, const T *B, T *C, long long n) {
+    using O = OpsAVX2<T>;
+    constexpr long long L = 32 / sizeof(T);
+    long long i = 0;
+    // Dos registros por vuelta para tener más cargas en vuelo
+    for (; i + 2 * L <= n; i += 2 * L) {
+        auto a0 = O::carga(A + i), b0 = O::carga(B + i);
+        auto a1 = O::carga(A + i + L), b1 = O::carga(B + i + L);
+        O::guarda(C + i, O::suma(a0, b0));
+        O::guarda(C + i + L, O::suma(a1, b1));
+    }
+    for (; i + L <= n; i += L) {
+        O::guarda(C + i, O::suma(O::carga(A + i), O::carga(B + i)));
+    }
+    sumaCola(A, B, C, i, n);
+}
+
+// El mismo cuerpo compilado para AVX512F (32 y 64 bits) y para
+// AVX512F + BW (8 y 16 bits): una CPU con F y sin BW usa AVX-512 para int32,
+// int64, float y double
+#define SUMA_CUERPO_AVX512                                             \
+    using O = OpsAVX512<T>;                                            \
+    constexpr long long L = 64 / sizeof(T);                            \
+    long long i = 0;                                                   \
+    for (; i + L <= n; i += L) {                                       \
+        O::guarda(C + i, O::suma(O::carga(A + i), O::carga(B + i)));   \
+    }                                                                  \
+    /* Cola con máscara: sin bucle escalar */                          \
+    if (i < n) {                                                       \
+        O::sumaMascara(A + i, B + i, C + i, n - i);                    \
+    }
+
+template <typename T>
+__attribute__((target("avx512f")))
+void sumaAVX512F(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_AVX512 }
+
+template <typename T>
+__attribute__((target("avx512f,avx512bw")))
+void sumaAVX512BW(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_AVX512 }
+
+// int8/int16 necesitan AVX512BW; el resto, solo AVX512F
+template <typename T>
+constexpr bool AVX512_REQUIERE_BW = sizeof(T) < 4;
+
+template <typename T>
+FuncionSumaT<T> sumaAVX512Para() {
+    if constexpr (AVX512_REQUIERE_BW<T>) return sumaAVX512BW<T>;
+    else return sumaAVX512F<T>;
+}
+
+template <typename T>
+bool soportaAVX512() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") && (!AVX512_REQUIERE_BW<T> || __builtin_cpu_supports("avx512bw"));
+}
+#endif
+
+#ifdef SUMA_NEON
+// ===============================
+// Operaciones NEON por tipo
+// ===============================
+template <typename T> struct OpsNEON;
+template <> struct OpsNEON<std::int8_t> {
+    static int8x16_t carga(const std::int8_t *p) { return vld1q_s8(p); }
+    static void guarda(std::int8_t *p, int8x16_t v) { vst1q_s8(p, v); }
+    static int8x16_t suma(int8x16_t a, int8x16_t b) { return vaddq_s8(a, b); }
+};
+template <> struct OpsNEON<std::int16_t> {
+    static int16x8_t carga(const std::int16_t *p) { return vld1q_s16(p); }
+    static void guarda(std::int16_t *p, int16x8_t v) { vst1q_s16(p, v); }
+    static int16x8_t suma(int16x8_t a, int16x8_t b) { return vaddq_s16(a, b); }
+};
+template <> struct OpsNEON<std::int32_t> {
+    static int32x4_t carga(const std::int32_t *p) { return vld1q_s32(p); }
+    static void guarda(std::int32_t *p, int32x4_t v) { vst1q_s32(p, v); }
+    static int32x4_t suma(int32x4_t a, int32x4_t b) { return vaddq_s32(a, b); }
+};
+template <> struct OpsNEON<std::int64_t> {
+    static int64x2_t carga(const std::int64_t *p) { return vld1q_s64(p); }
+    static void guarda(std::int64_t *p, int64x2_t v) { vst1q_s64(p, v); }
+    static int64x2_t suma(int64x2_t a, int64x2_t b) { return vaddq_s64(a, b); }
+};
+template <> struct OpsNEON<float> {
+    static float32x4_t carga(const float *p) { return vld1q_f32(p); }
+    static void guarda(float *p, float32x4_t v) { vst1q_f32(p, v); }
+    static float32x4_t suma(float32x4_t a, float32x4_t b) { return vaddq_f32(a, b); }
+};
+#if defined(__aarch64__)
+template <> struct OpsNEON<double> {
+    static float64x2_t carga(const double *p) { return vld1q_f64(p); }
+    static void guarda(double *p, float64x2_t v) { vst1q_f64(p, v); }
+    static float64x2_t suma(float64x2_t a, float64x2_t b) { return vaddq_f64(a, b); }
+};
+#endif
+
+template <typename T>
+void sumaNEON(const T *A, const T *B, T *C, long long n) {
+    using O = OpsNEON<T>;
+    constexpr long long L = 16 / sizeof(T);
+    long long i = 0;
+    for (; i + L <= n; i += L) {
+        O::guarda(C + i, O::suma(O::carga(A + i), O::carga(B + i)));
+    }
+    sumaCola(A, B, C, i, n);
+}
+#endif
+
+// ===============================
+// Tabla de variantes explícitas y su disponibilidad en esta CPU
+// ===============================
+template <typename T>
+struct VarianteSimd {
+    const char *nombre;
+    FuncionSumaT<T> funcion;
+    bool disponible;
+};
+
+template <typename T>
+std::vector<VarianteSimd<T>> variantesSimd() {
+    std::vector<VarianteSimd<T>> v;
+#ifdef SUMA_X86
+    __builtin_cpu_init();
+    v.push_back({"sse2", sumaSSE2<T>, __builtin_cpu_supports("sse2") != 0});
+    v.push_back({"avx2", sumaAVX2<T>, __builtin_cpu_supports("avx2") != 0});
+    v.push_back({"avx512", sumaAVX512Para<T>(), soportaAVX512<T>()});
+#endif
+#ifdef SUMA_NEON
+#if defined(__aarch64__)
+    v.push_back({"neon", sumaNEON<T>, true});
+#else
+    if constexpr (!std::is_same<T, double>::value) {   // ARMv7 no tiene NEON f64
+        v.push_back({"neon", sumaNEON<T>, true});
+    }
+#endif
+#endif
+    return v;
+}
+
+// ===============================
+// Despacho: la variante más ancha disponible, resuelta una sola vez por
+// tipo. Sin ninguna variante explícita se usa el bucle escalar.
+// ===============================
+template <typename T>
+const VarianteSimd<T> &varianteSimd() {
+    static const VarianteSimd<T> elegida = [] {
+        VarianteSimd<T> mejor{"escalar", sumaSecuencial<T>, true};
+        for (const VarianteSimd<T> &v : variantesSimd<T>()) {
+            if (v.disponible) mejor = v;   // La tabla va de menor a mayor ancho
+        }
+        return mejor;
+    }();
+    return elegida;
+}
+
+template <typename T>
+void sumaSimd(const T *A, const T *B, T *C, long long n) {
+    varianteSimd<T>().funcion(A, B, C, n);
+}
@@ -0,0 +1,191 @@
+/******************************************************************************
+ * streaming.hpp
+ * Descripción:
+ *  - Escrituras no temporales (streaming stores) para C cuando N >> LLC:
+ *      (1) Una escritura normal de C trae antes la línea a caché
+ *          (read-for-ownership) y expulsa líneas útiles de A y B.
+ *      (2) _mm_stream_* / _mm256_stream_* / _mm512_stream_* escriben directo
+ *          a memoria: por elemento se mueven 3 accesos (A, B, C) en lugar de
+ *          4 (A, B, RFO de C, C), un 25 % menos de tráfico.
+ *  - Los streams exigen destino alineado al ancho del registro: cada bloque
+ *    pela una cabeza escalar hasta alinear C y termina con una cola escalar.
+ *  - Las escrituras no temporales no quedan ordenadas con el resto: cada hilo
+ *    hace _mm_sfence() al final de su parte, antes de la barrera implícita.
+ *  - El modo se elige solo a partir de un umbral de bytes (por defecto el
+ *    doble del LLC), o se fuerza con --stream=si|no.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+#include <cstdint>      // uintptr_t
+#include <fstream>      // /sys/.../cache
+#include <string>
+#include <vector>
+
+#include <unistd.h>     // sysconf
+
+#include "configuracion.hpp"  // Configuracion
+#include "simd.hpp"           // VarianteSimd, Ops*, sumaCola, SUMA_X86
+
+#ifdef SUMA_X86
+// Índice desde el que C + i queda alineado a "bytes" (sin pasarse de n)
+template <typename T>
+long long inicioAlineado(const T *C, long long n, std::uintptr_t bytes) {
+    std::uintptr_t dir = reinterpret_cast<std::uintptr_t>(C);
+    long long cabeza = static_cast<long long>(((bytes - (dir % bytes)) % bytes) / sizeof(T));
+    return std::min(cabeza, n);
+}
+
+// ===============================
+// Núcleos con streaming stores (sin sfence: el llamador lo emite)
+// ===============================
+template <typename T>
+__attribute__((target("sse2")))
+void sumaStreamSSE2(const T *A, const T *B, T *C, long long n) {
+    using O = OpsSSE2<T>;
+    constexpr long long L = 16 / sizeof(T);
+    long long i = inicioAlineado(C, n, 16);
+    sumaCola(A, B, C, 0, i);
+    for (; i + L <= n; i += L) {
+        O::guardaStream(C + i, O::suma(O::carga(A + i), O::carga(B + i)));
+    }
+    sumaCola(A, B, C, i, n);
+}
+
+template <typename T>
+__attribute__((target("avx2")))
+void sumaStreamAVX2(const T *A, const T *B, T *C, long long n) {
+    using O = OpsAVX2<T>;
+    constexpr long long L = 32 / sizeof(T);
+    long long i = inicioAlineado(C, n, 32);
+    sumaCola(A, B, C, 0, i);
+    for (; i + L <= n; i += L) {
+        O::guardaStream(C + i, O::suma(O::carga(A + i), O::carga(B + i)));
+    }
+    sumaCola(A, B, C, i, n);
+}
+
+// Como en simd.hpp: AVX512F para 32 y 64 bits, F + BW para 8 y 16
+#define SUMA_CUERPO_STREAM_AVX512                                            \
+    using O = OpsAVX512<T>;                                                  \
+    constexpr long long L = 64 / sizeof(T);                                  \
+    long long i = inicioAlineado(C, n, 64);                                  \
+    sumaCola(A, B, C, 0, i);                                                 \
+    for (; i + L <= n; i += L) {                                             \
+        O::guardaStream(C + i, O::suma(O::carga(A + i), O::carga(B + i)));   \
+    }                                                                        \
+    sumaCola(A, B, C, i, n);
+
+template <typename T>
+__attribute__((target("avx512f")))
+void sumaStreamAVX512F(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_STREAM_AVX512 }
+
+template <typename T>
+__attribute__((target("avx512f,avx512bw")))
+void sumaStreamAVX512BW(const T *A, const T *B, T *C, long long n) { SUMA_CUERPO_STREAM_AVX512 }
+
+template <typename T>
+FuncionSumaT<T> sumaStreamAVX512Para() {
+    if constexpr (AVX512_REQUIERE_BW<T>) return sumaStreamAVX512BW<T>;
+    else return sumaStreamAVX512F<T>;
+}
+#endif
+
+// Ordena las escrituras no temporales pendientes del hilo actual
+inline void barreraStores() {
+#ifdef SUMA_X86
+    _mm_sfence();
+#endif
+}
+
+// ===============================
+// Variantes con streaming stores disponibles en esta CPU
+// ===============================
+template <typename T>
+std::vector<VarianteSimd<T>> variantesStream() {
+    std::vector<VarianteSimd<T>> v;
+#ifdef SUMA_X86
+    __builtin_cpu_init();
+    v.push_back({"sse2-stream", sumaStreamSSE2<T>, __builtin_cpu_supports("sse2") != 0});
+    v.push_back({"avx2-stream", sumaStreamAVX2<T>, __builtin_cpu_supports("avx2") != 0});
+    v.push_back({"avx512-stream", sumaStreamAVX512Para<T>(), soportaAVX512<T>()});
+#endif
+    return v;
+}
+
+// La más ancha disponible; sin streams en la plataforma cae al despacho SIMD
+template <typename T>
+const VarianteSimd<T> &varianteStream() {
+    static const VarianteSimd<T> elegida = [] {
+        VarianteSimd<T> mejor = varianteSimd<T>();
+        for (const VarianteSimd<T> &v : variantesStream<T>()) {
+            if (v.disponible) mejor = v;
+        }
+        return mejor;
+    }();
+    return elegida;
+}
+
+// ===============================
+// Paralelo con streaming: mismo reparto que schedule(static, chunk) y un
+// sfence por hilo (no por bloque) al terminar su parte del for.
+// ===============================
+template <typename T>
+void sumaParalelaStream(FuncionSumaT<T> f, const T *A, const T *B, T *C,
+                        long long n, long long chunk) {
+    const long long bloques = (n + chunk - 1) / chunk;
+#pragma omp parallel
+    {
+        SUMA_TRAZA_TRAMO("suma (stream)", -1);
+#pragma omp for schedule(static, 1) nowait
+        for (long long b = 0; b < bloques; b++) {
+            SUMA_TRAZA_TRAMO("suma (stream)", b);
+            const long long i = b * chunk;
+            f(A + i, B + i, C + i, std::min(chunk, n - i));
+        }
+        barreraStores();
+    }   // Barrera implícita: C completo y visible para todos los hilos
+}
+
+template <typename T>
+void sumaParalelaStream(const T *A, const T *B, T *C, long long n, long long chunk) {
+    sumaParalelaStream(varianteStream<T>().funcion, A, B, C, n, chunk);
+}
+
+// ===============================
+// Tamaño del último nivel de caché (bytes); 0 si no se puede determinar
+// ===============================
+inline long long tamanoLLC() {
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    long v = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (v > 0) return v;
+#endif
+    // Respaldo: el índice más alto de /sys/devices/system/cpu/cpu0/cache
+    long long mayor = 0;
+    for (int idx = 0; idx < 8; idx++) {
+        std::ifstream f("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(idx) + "/size");
+        std::string texto;
+        if (!(f >> texto)) break;
+        long long valor = std::stoll(texto);
+        char sufijo = texto.back();
+        if (sufijo == 'K') valor *= 1024;
+        else if (sufijo == 'M') valor *= 1024 * 1024;
+        mayor = std::max(mayor, valor);
+    }
+    return mayor;
+}
+
+// Umbral (bytes de A + B + C) a partir del cual conviene el streaming
+inline long long umbralStream(const Configuracion &cfg) {
+    if (cfg.umbral_stream > 0) return cfg.umbral_stream;
+    long long llc = tamanoLLC();
+    return llc > 0 ? 2 * llc : 64LL * 1024 * 1024;   // Sin dato: 64 MB
+}
+
+// ¿Se usa streaming para C con n elementos de "ancho" bytes?
+inline bool usaStreaming(const Configuracion &cfg, long long n, std::size_t ancho) {
+    if (cfg.stream == "si") return true;
+    if (cfg.stream == "no") return false;
+    return 3.0 * ancho * n > static_cast<double>(umbralStream(cfg));
+}
@@ -0,0 +1,183 @@
+/******************************************************************************
+ * teselas.hpp
+ * Descripción:
+ *  - Cadena de operaciones sobre los mismos arreglos, como la de un uso
+ *    real (sumar, verificar, transformar y volver a sumar):
+ *      (1) D = A + B           suma
+ *      (2) h += huella(D)      verificación (huella de verificacion.hpp)
+ *      (3) D = s*D             escala en sitio
+ *      (4) D = D + C           suma otra vez
+ *    9 accesos por elemento contados como STREAM (3 + 1 + 2 + 3).
+ *  - Tres formas de ejecutarla:
+ *      pasadas:   cada etapa recorre los N elementos con OpenMP+SIMD; cada
+ *                 pasada va a la velocidad de la DRAM si N >> LLC
+ *      teselas:   cada hilo toma un bloque del tamaño de su L2 y le aplica
+ *                 las cuatro etapas antes de pasar al siguiente; solo la
+ *                 primera etapa trae datos de la DRAM. Las teselas son los
+ *                 bloques alineados a línea de particion.hpp y cada etapa
+ *                 es el núcleo SIMD de operaciones.hpp
+ *      fusionada: la cadena entera en una pasada por elemento (el límite
+ *                 de la fusión, posible porque todas las etapas son por
+ *                 elemento)
+ *  - Residencia por tesela: las variantes instrumentadas miden el tiempo de
+ *    cada etapa; si las etapas 2-4 corren en teselas más rápido que en
+ *    pasadas completas, la tesela siguió en caché entre etapas (la etapa 1
+ *    trae los datos de la DRAM en ambos casos).
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // max, min
+#include <cstdint>
+#include <vector>
+
+#include <unistd.h>     // sysconf
+#include <omp.h>
+
+#include "operaciones.hpp"   // OpSuma, OpEscala, opSimd, opParalelaSimd
+#include "particion.hpp"     // Particion, particiona
+#include "verificacion.hpp"  // mezclaElemento, checksumArreglo
+
+// Accesos por elemento de la cadena completa y de cada etapa
+constexpr int ACCESOS_ETAPA[4] = {OpSuma::accesos, 1, OpEscala::accesos, OpSuma::accesos};
+constexpr int ACCESOS_CADENA = ACCESOS_ETAPA[0] + ACCESOS_ETAPA[1] + ACCESOS_ETAPA[2] + ACCESOS_ETAPA[3];
+
+// Tamaño de la L2 privada (bytes); 1 MB si no se puede determinar
+inline long long tamanoL2() {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    long v = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (v > 0) return v;
+#endif
+    return 1024 * 1024;
+}
+
+// Elementos por tesela: A, B, C y D de la tesela ocupan la mitad de la L2
+// (la otra mitad queda para la tesela siguiente que trae el prefetcher)
+template <typename T>
+long long elementosTesela(long long pedidos) {
+    if (pedidos > 0) return pedidos;
+    return std::max(1LL, tamanoL2() / 2 / (4 * static_cast<long long>(sizeof(T))));
+}
+
+// Huella de D[0..n) con índices globales desde "base", en un hilo
+template <typename T>
+std::uint64_t huellaTramo(const T *D, long long n, long long base) {
+    std::uint64_t h = 0;
+#pragma omp simd reduction(+:h)
+    for (long long i = 0; i < n; i++) {
+        h += mezclaElemento(base + i, D[i]);
+    }
+    return h;
+}
+
+// ===============================
+// (a) Una pasada completa por etapa. Con "etapas" != nullptr suma a
+// etapas[e] el tiempo de pared de cada pasada (segundos).
+// ===============================
+template <typename T>
+std::uint64_t cadenaPasadas(const T *A, const T *B, const T *C, T *D, T s, long long n, long long chunk,
+                            double *etapas = nullptr) {
+    const double t0 = etapas ? omp_get_wtime() : 0.0;
+    opParalelaSimd<OpSuma, T>(D, A, B, nullptr, s, n, chunk);
+    const double t1 = etapas ? omp_get_wtime() : 0.0;
+    const std::uint64_t h = checksumArreglo(D, n, chunk);
+    const double t2 = etapas ? omp_get_wtime() : 0.0;
+    opParalelaSimd<OpEscala, T>(D, D, nullptr, nullptr, s, n, chunk);
+    const double t3 = etapas ? omp_get_wtime() : 0.0;
+    opParalelaSimd<OpSuma, T>(D, D, C, nullptr, s, n, chunk);
+    if (etapas) {
+        etapas[0] += t1 - t0;
+        etapas[1] += t2 - t1;
+        etapas[2] += t3 - t2;
+        etapas[3] += omp_get_wtime() - t3;
+    }
+    return h;
+}
+
+// ===============================
+// (b) Por teselas: las cuatro etapas sobre cada bloque de la partición.
+// Con "etapas" != nullptr acumula por hilo el tiempo de cada etapa en
+// etapas[4 * hilo + e] (segundos).
+// ===============================
+template <typename T>
+std::uint64_t cadenaTeselas(const T *A, const T *B, const T *C, T *D, T s, const Particion &p,
+                            double *etapas = nullptr) {
+    const FuncionOp<T> suma = opSimd<OpSuma, T>();
+    const FuncionOp<T> escala = opSimd<OpEscala, T>();
+    const long long teselas = p.bloques();
+    std::uint64_t h = 0;
+#pragma omp parallel for schedule(static, 1) reduction(+:h)
+    for (long long t = 0; t < teselas; t++) {
+        const long long i = p.inicio(t);
+        const long long m = p.fin(t) - i;
+        if (!etapas) {
+            suma(D + i, A + i, B + i, nullptr, s, m);
+            h += huellaTramo(D + i, m, i);
+            escala(D + i, D + i, nullptr, nullptr, s, m);
+            suma(D + i, D + i, C + i, nullptr, s, m);
+            continue;
+        }
+        double *mias = etapas + 4 * omp_get_thread_num();
+        double t0 = omp_get_wtime();
+        suma(D + i, A + i, B + i, nullptr, s, m);
+        double t1 = omp_get_wtime();
+        h += huellaTramo(D + i, m, i);
+        double t2 = omp_get_wtime();
+        escala(D + i, D + i, nullptr, nullptr, s, m);
+        double t3 = omp_get_wtime();
+        suma(D + i, D + i, C + i, nullptr, s, m);
+        double t4 = omp_get_wtime();
+        mias[0] += t1 - t0;
+        mias[1] += t2 - t1;
+        mias[2] += t3 - t2;
+        mias[3] += t4 - t3;
+    }
+    return h;
+}
+
+// ===============================
+// (c) Fusionada: la cadena entera por elemento en una sola pasada
+// ===============================
+template <typename T>
+std::uint64_t cadenaFusionada(const T *A, const T *B, const T *C, T *D, T s, long long n, long long chunk) {
+    std::uint64_t h = 0;
+#pragma omp parallel for simd schedule(static, chunk) reduction(+:h)
+    for (long long i = 0; i < n; i++) {
+        const T x = static_cast<T>(A[i] + B[i]);
+        h += mezclaElemento(i, x);
+        D[i] = static_cast<T>(static_cast<T>(s * x) + C[i]);
+    }
+    return h;
+}
+
+// Tiempo medio por hilo de cada etapa en una ejecución de la cadena (segundos)
+struct EtapasCadena {
+    double segundos[4] = {0.0, 0.0, 0.0, 0.0};
+};
+
+template <typename T>
+EtapasCadena mideEtapasPasadas(const T *A, const T *B, const T *C, T *D, T s, long long n,
+                               long long chunk, int repeticiones) {
+    EtapasCadena r;
+    for (int k = 0; k < repeticiones; k++) {
+        cadenaPasadas(A, B, C, D, s, n, chunk, r.segundos);
+    }
+    for (double &e : r.segundos) e /= repeticiones;
+    return r;
+}
+
+template <typename T>
+EtapasCadena mideEtapasTeselas(const T *A, const T *B, const T *C, T *D, T s, const Particion &p,
+                               int repeticiones) {
+    const int hilos = omp_get_max_threads();
+    std::vector<double> etapas(4 * hilos, 0.0);
+    for (int k = 0; k < repeticiones; k++) {
+        cadenaTeselas(A, B, C, D, s, p, etapas.data());
+    }
+    EtapasCadena r;
+    for (int h = 0; h < hilos; h++) {
+        for (int e = 0; e < 4; e++) r.segundos[e] += etapas[4 * h + e];
+    }
+    for (double &e : r.segundos) e /= static_cast<double>(hilos) * repeticiones;
+    return r;
+}
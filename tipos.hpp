@@ -0,0 +1,48 @@
+/******************************************************************************
+ * tipos.hpp
+ * Descripción:
+ *  - Tipos de elemento seleccionables con --tipo:
+ *      int8, int16, int32 (defecto, el "int" original), int64, float, double
+ *  - despachaTipo: traduce el nombre en tiempo de ejecución a una llamada con
+ *    el tipo fijo en compilación, de modo que todo el código que cuelga de
+ *    ella (núcleos, verificación, impresión) se instancia por tipo.
+ *  - rangoInicial<T>: los valores de A y B van en [1, rango] para que A + B
+ *    no desborde el tipo (int8: [1, 63]).
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+// Nombres aceptados por --tipo, en el orden de la ayuda
+inline constexpr const char *TIPOS[] = {"int8", "int16", "int32", "int64", "float", "double"};
+
+template <typename T> constexpr const char *nombreTipo();
+template <> constexpr const char *nombreTipo<std::int8_t>() { return "int8"; }
+template <> constexpr const char *nombreTipo<std::int16_t>() { return "int16"; }
+template <> constexpr const char *nombreTipo<std::int32_t>() { return "int32"; }
+template <> constexpr const char *nombreTipo<std::int64_t>() { return "int64"; }
+template <> constexpr const char *nombreTipo<float>() { return "float"; }
+template <> constexpr const char *nombreTipo<double>() { return "double"; }
+
+// Máximo de los valores iniciales: A + B debe caber en T
+template <typename T>
+constexpr int rangoInicial() {
+    return sizeof(T) == 1 ? 63 : 1000;
+}
+
+// ===============================
+// Llama a f(T{}) con el T que corresponde a "nombre"
+// ===============================
+template <typename F>
+auto despachaTipo(const std::string &nombre, F &&f) {
+    if (nombre == "int8") return f(std::int8_t{});
+    if (nombre == "int16") return f(std::int16_t{});
+    if (nombre == "int32") return f(std::int32_t{});
+    if (nombre == "int64") return f(std::int64_t{});
+    if (nombre == "float") return f(float{});
+    if (nombre == "double") return f(double{});
+    throw std::invalid_argument("tipo desconocido: '" + nombre + "'");
+}
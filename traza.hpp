@@ -0,0 +1,202 @@
+/******************************************************************************
+ * traza.hpp
+ * Descripción:
+ *  - Línea de tiempo por hilo de las fases del modo básico (inicialización,
+ *    sumas medidas y verificación), con inicio y fin en ns. Los tramos
+ *    están en los núcleos mismos (SUMA_TRAZA_TRAMO en aleatorio.hpp,
+ *    kernels.hpp, planificacion.hpp, verificacion.hpp, streaming.hpp y
+ *    particion.hpp): lo trazado es lo que se mide, cada repetición incluida.
+ *    Un tramo por hilo y por llamada, y uno por bloque de chunk elementos
+ *    en los núcleos con schedule(static, chunk).
+ *  - Cada hilo escribe solo en su anillo (sin candados ni atómicos: nadie
+ *    más lo toca hasta que termina la región paralela). Si un anillo se
+ *    llena se pisan los tramos más viejos y se cuentan como perdidos.
+ *  - Se exporta en el formato JSON de Chrome (chrome://tracing), que
+ *    también abre Perfetto (ui.perfetto.dev): eventos "X" con pid 1 y un
+ *    tid por hilo; los tramos de chunk quedan anidados en los de su fase.
+ *  - Doble interruptor:
+ *      compilación: sin -DSUMA_TRAZA las macros SUMA_TRAZA_TRAMO no generan
+ *                   código y trazaActiva() es false en tiempo de compilación
+ *      ejecución:   --traza=<ruta>; sin ella cada tramo cuesta una lectura
+ *                   de un bool
+ *  - Un "parallel for" trazado se escribe "parallel { tramo; for nowait }":
+ *    la barrera implícita del final de la región es la misma, así que sin
+ *    -DSUMA_TRAZA el código es el de antes.
+ *  - Para el tramo por bloque, con -DSUMA_TRAZA un for con
+ *    schedule(static, chunk) se recorre por bloques de chunk elementos con
+ *    schedule(static, 1): el bloque b va al hilo b mod hilos, el mismo
+ *    reparto, y cada bloque abre su tramo (como sumaParalelaCon).
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+#include <chrono>       // steady_clock
+#include <cstdint>
+#include <cstdio>       // snprintf
+#include <fstream>
+#include <stdexcept>    // runtime_error
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+#ifdef SUMA_TRAZA
+inline constexpr bool TRAZA_COMPILADA = true;
+#else
+inline constexpr bool TRAZA_COMPILADA = false;
+#endif
+
+// ns del reloj monótono
+inline std::int64_t relojTraza() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Un tramo terminado: fase (literal), bloque (-1 = tramo de la fase) e intervalo
+struct EventoTraza {
+    const char *nombre;
+    long long chunk;
+    std::int64_t inicio;
+    std::int64_t fin;
+};
+
+// ===============================
+// Anillo de un hilo; alineado a 64 bytes para que los contadores de dos
+// hilos no compartan línea
+// ===============================
+class alignas(64) AnilloTraza {
+public:
+    // Capacidad redondeada a potencia de 2
+    explicit AnilloTraza(std::size_t capacidad) {
+        std::size_t c = 1;
+        while (c < capacidad) c <<= 1;
+        eventos_.resize(c);
+        mascara_ = c - 1;
+    }
+
+    void agrega(const EventoTraza &e) {
+        eventos_[escritos_ & mascara_] = e;
+        escritos_++;
+    }
+
+    std::size_t guardados() const { return std::min<std::size_t>(escritos_, eventos_.size()); }
+    std::size_t perdidos() const { return escritos_ - guardados(); }
+
+    // Del más viejo al más nuevo de los que siguen en el anillo
+    template <typename F>
+    void recorre(F &&f) const {
+        for (std::size_t k = escritos_ - guardados(); k < escritos_; k++) f(eventos_[k & mascara_]);
+    }
+
+private:
+    std::vector<EventoTraza> eventos_;
+    std::size_t mascara_ = 0;
+    std::size_t escritos_ = 0;
+};
+
+// ===============================
+// Traza del proceso: un anillo por hilo
+// ===============================
+class Traza {
+public:
+    static Traza &global() {
+        static Traza traza;
+        return traza;
+    }
+
+    // Reserva los anillos; los tramos cuentan desde aquí
+    void activa(int hilos, std::size_t por_hilo) {
+        anillos_.assign(static_cast<std::size_t>(hilos > 0 ? hilos : 1), AnilloTraza(por_hilo));
+        origen_ = relojTraza();
+        activa_ = true;
+    }
+    bool activa() const { return activa_; }
+
+    void registra(const char *nombre, long long chunk, std::int64_t inicio, std::int64_t fin) {
+        const std::size_t h = static_cast<std::size_t>(omp_get_thread_num());
+        if (h < anillos_.size()) anillos_[h].agrega({nombre, chunk, inicio, fin});
+    }
+
+    std::size_t eventos() const {
+        std::size_t total = 0;
+        for (const AnilloTraza &a : anillos_) total += a.guardados();
+        return total;
+    }
+    std::size_t perdidos() const {
+        std::size_t total = 0;
+        for (const AnilloTraza &a : anillos_) total += a.perdidos();
+        return total;
+    }
+
+    // JSON de Chrome: ts y dur en µs con resolución de ns
+    void escribeChrome(const std::string &ruta) const {
+        std::ofstream f(ruta);
+        if (!f) throw std::runtime_error("no se pudo abrir la traza " + ruta);
+        f << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        bool primero = true;
+        char linea[256];
+        for (std::size_t h = 0; h < anillos_.size(); h++) {
+            std::snprintf(linea, sizeof(linea),
+                          "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,"
+                          "\"args\":{\"name\":\"hilo %zu\"}}",
+                          primero ? "" : ",\n", h, h);
+            f << linea;
+            primero = false;
+            anillos_[h].recorre([&](const EventoTraza &e) {
+                const double ts = (e.inicio - origen_) * 1e-3;
+                const double dur = (e.fin - e.inicio) * 1e-3;
+                if (e.chunk < 0) {
+                    std::snprintf(linea, sizeof(linea),
+                                  ",\n{\"name\":\"%s\",\"cat\":\"fase\",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,"
+                                  "\"ts\":%.3f,\"dur\":%.3f}",
+                                  e.nombre, h, ts, dur);
+                } else {
+                    std::snprintf(linea, sizeof(linea),
+                                  ",\n{\"name\":\"%s\",\"cat\":\"chunk\",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,"
+                                  "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"chunk\":%lld}}",
+                                  e.nombre, h, ts, dur, e.chunk);
+                }
+                f << linea;
+            });
+        }
+        f << "\n]}\n";
+        if (!f) throw std::runtime_error("error al escribir la traza " + ruta);
+    }
+
+private:
+    std::vector<AnilloTraza> anillos_;
+    std::int64_t origen_ = 0;
+    bool activa_ = false;
+};
+
+inline bool trazaActiva() {
+    if constexpr (!TRAZA_COMPILADA) return false;
+    else return Traza::global().activa();
+}
+
+// Tramo con alcance: inicio al construir, registro al destruir
+class TramoTraza {
+public:
+    explicit TramoTraza(const char *nombre, long long chunk = -1)
+        : nombre_(nombre), chunk_(chunk), inicio_(trazaActiva() ? relojTraza() : 0) {}
+    ~TramoTraza() {
+        if (inicio_ != 0) Traza::global().registra(nombre_, chunk_, inicio_, relojTraza());
+    }
+    TramoTraza(const TramoTraza &) = delete;
+    TramoTraza &operator=(const TramoTraza &) = delete;
+
+private:
+    const char *nombre_;
+    long long chunk_;
+    std::int64_t inicio_;
+};
+
+#define SUMA_TRAZA_CONCATENA2(a, b) a##b
+#define SUMA_TRAZA_CONCATENA(a, b) SUMA_TRAZA_CONCATENA2(a, b)
+#ifdef SUMA_TRAZA
+#define SUMA_TRAZA_TRAMO(nombre, chunk) \
+    TramoTraza SUMA_TRAZA_CONCATENA(tramo_traza_, __LINE__)(nombre, chunk)
+#else
+#define SUMA_TRAZA_TRAMO(nombre, chunk) ((void)0)
+#endif
@@ -0,0 +1,189 @@
+/******************************************************************************
+ * verificacion.hpp
+ * Descripción:
+ *  - Formas de comprobar C_par, de la más cara a la más barata:
+ *      (1) serie:    compara C_seq y C_par elemento a elemento en un hilo
+ *                    (el bucle "correcto" original)
+ *      (2) paralela: la misma comparación con reduction(min:) sobre el primer
+ *                    índice distinto
+ *      (3) checksum: la suma paralela acumula una huella de C dentro de la
+ *                    misma región (reduction(+:)); la huella de referencia se
+ *                    calcula desde A y B sin materializar C_seq. No hay
+ *                    segunda pasada sobre C. Ambos bucles son "parallel for
+ *                    simd" para que la huella no frene la vectorización.
+ *  - La huella es una suma (mod 2^64) ponderada por posición de los bits de
+ *    C[i]: no depende del orden de suma, así que es la misma con cualquier
+ *    número de hilos y cualquier schedule. Con "base" se pondera por el
+ *    índice global: las huellas de los tramos de cada proceso MPI se suman.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>    // min
+#include <cstdint>
+#include <cstring>      // memcpy
+#include <iostream>
+#include <limits>       // numeric_limits
+
+#include "traza.hpp"    // SUMA_TRAZA_TRAMO
+
+// ===============================
+// Contribución de C[i] a la huella: bits del valor (con una constante para
+// que los ceros también cuenten) por el peso impar 2i + 1. Un solo producto
+// por elemento; como el peso es invertible mod 2^64, cambiar cualquier
+// elemento o permutar dos cambia la huella.
+// ===============================
+template <typename T>
+inline std::uint64_t mezclaElemento(long long i, T valor) {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &valor, sizeof(T));
+    return (bits ^ 0x9E3779B97F4A7C15ull) * (2 * static_cast<std::uint64_t>(i) + 1);
+}
+
+// ===============================
+// (1) Verificación en serie: reporta el primer error encontrado
+// ===============================
+template <typename T>
+bool verificaIguales(const T *C_seq, const T *C_par, long long n) {
+    SUMA_TRAZA_TRAMO("verificacion", -1);
+    for (long long i = 0; i < n; i++) {
+        if (C_seq[i] != C_par[i]) {
+            // Reporte mínimo del primer error encontrado
+            std::cout << "\n[ERROR] Diferencia en i=" << i
+                      << " C_seq=" << +C_seq[i]
+                      << " C_par=" << +C_par[i] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ===============================
+// (2) Verificación paralela: mismo reporte, primer índice por reducción
+// ===============================
+template <typename T>
+bool verificaIgualesParalelo(const T *C_seq, const T *C_par, long long n, long long chunk) {
+    long long primero = std::numeric_limits<long long>::max();
+#pragma omp parallel
+    {
+        SUMA_TRAZA_TRAMO("verificacion", -1);
+#ifdef SUMA_TRAZA
+        // Por bloques para el tramo de cada uno (ver traza.hpp)
+        const long long bloques = (n + chunk - 1) / chunk;
+#pragma omp for schedule(static, 1) reduction(min : primero) nowait
+        for (long long b = 0; b < bloques; b++) {
+            SUMA_TRAZA_TRAMO("verificacion", b);
+            const long long fin = std::min(n, (b + 1) * chunk);
+            for (long long i = b * chunk; i < fin; i++) {
+                if (C_seq[i] != C_par[i] && i < primero) primero = i;
+            }
+        }
+#else
+#pragma omp for schedule(static, chunk) reduction(min : primero) nowait
+        for (long long i = 0; i < n; i++) {
+            if (C_seq[i] != C_par[i] && i < primero) primero = i;
+        }
+#endif
+    }
+    if (primero == std::numeric_limits<long long>::max()) return true;
+    std::cout << "\n[ERROR] Diferencia en i=" << primero
+              << " C_seq=" << +C_seq[primero]
+              << " C_par=" << +C_par[primero] << std::endl;
+    return false;
+}
+
+// ===============================
+// (3a) Suma paralela con la huella de C acumulada en la misma pasada
+// ===============================
+template <typename T>
+std::uint64_t sumaParalelaConChecksum(const T *A, const T *B, T *C, long long n, long long chunk,
+                                      long long base = 0) {
+    std::uint64_t h = 0;
+#pragma omp parallel
+    {
+        SUMA_TRAZA_TRAMO("suma + checksum", -1);
+#ifdef SUMA_TRAZA
+        const long long bloques = (n + chunk - 1) / chunk;
+#pragma omp for schedule(static, 1) reduction(+ : h) nowait
+        for (long long b = 0; b < bloques; b++) {
+            SUMA_TRAZA_TRAMO("suma + checksum", b);
+            const long long fin = std::min(n, (b + 1) * chunk);
+#pragma omp simd reduction(+ : h)
+            for (long long i = b * chunk; i < fin; i++) {
+                const T c = static_cast<T>(A[i] + B[i]);
+                C[i] = c;
+                h += mezclaElemento(base + i, c);
+            }
+        }
+#else
+#pragma omp for simd schedule(static, chunk) reduction(+ : h) nowait
+        for (long long i = 0; i < n; i++) {
+            const T c = static_cast<T>(A[i] + B[i]);
+            C[i] = c;
+            h += mezclaElemento(base + i, c);
+        }
+#endif
+    }
+    return h;
+}
+
+// ===============================
+// (3b) Huella de referencia desde A y B: solo lee, no escribe C_seq
+// ===============================
+template <typename T>
+std::uint64_t checksumReferencia(const T *A, const T *B, long long n, long long chunk,
+                                 long long base = 0) {
+    std::uint64_t h = 0;
+#pragma omp parallel
+    {
+        SUMA_TRAZA_TRAMO("verificacion", -1);
+#ifdef SUMA_TRAZA
+        const long long bloques = (n + chunk - 1) / chunk;
+#pragma omp for schedule(static, 1) reduction(+ : h) nowait
+        for (long long b = 0; b < bloques; b++) {
+            SUMA_TRAZA_TRAMO("verificacion", b);
+            const long long fin = std::min(n, (b + 1) * chunk);
+#pragma omp simd reduction(+ : h)
+            for (long long i = b * chunk; i < fin; i++) {
+                h += mezclaElemento(base + i, static_cast<T>(A[i] + B[i]));
+            }
+        }
+#else
+#pragma omp for simd schedule(static, chunk) reduction(+ : h) nowait
+        for (long long i = 0; i < n; i++) {
+            h += mezclaElemento(base + i, static_cast<T>(A[i] + B[i]));
+        }
+#endif
+    }
+    return h;
+}
+
+// ===============================
+// (3c) Huella de un C ya calculado (misma fórmula que 3a)
+// ===============================
+template <typename T>
+std::uint64_t checksumArreglo(const T *C, long long n, long long chunk, long long base = 0) {
+    std::uint64_t h = 0;
+#pragma omp parallel
+    {
+        SUMA_TRAZA_TRAMO("verificacion", -1);
+#ifdef SUMA_TRAZA
+        const long long bloques = (n + chunk - 1) / chunk;
+#pragma omp for schedule(static, 1) reduction(+ : h) nowait
+        for (long long b = 0; b < bloques; b++) {
+            SUMA_TRAZA_TRAMO("verificacion", b);
+            const long long fin = std::min(n, (b + 1) * chunk);
+#pragma omp simd reduction(+ : h)
+            for (long long i = b * chunk; i < fin; i++) {
+                h += mezclaElemento(base + i, C[i]);
+            }
+        }
+#else
+#pragma omp for simd schedule(static, chunk) reduction(+ : h) nowait
+        for (long long i = 0; i < n; i++) {
+            h += mezclaElemento(base + i, C[i]);
+        }
+#endif
+    }
+    return h;
+}